@@ -0,0 +1,695 @@
+/*
+* FreeRTOS Kernel V10.0.0
+* Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy of
+* this software and associated documentation files (the "Software"), to deal in
+* the Software without restriction, including without limitation the rights to
+* use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+* the Software, and to permit persons to whom the Software is furnished to do so,
+* subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software. If you wish to use our Amazon
+* FreeRTOS name, please do so in a fair use way that does not cause confusion.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+* http://www.FreeRTOS.org
+* http://aws.amazon.com/freertos
+*
+* 1 tab == 4 spaces!
+*/
+
+/*
+* An implementation of pvPortMalloc(), vPortFree() and pvPortRealloc() based
+* on segregated free lists (two-level segregated fit), which replaces the
+* first fit allocator of heap_4_infinitime.c.
+*
+* The free blocks are sorted in lists by size: the first level splits the
+* sizes in powers of 2, the second level splits each power of 2 in
+* heapSL_INDEX_COUNT ranges of the same width. Two bitmaps record which lists
+* are not empty, so that a free block large enough for a request is found with
+* a couple of bit scans, whatever the number of free blocks. Like heap_4,
+* blocks are split when they are larger than requested, and adjacent free
+* blocks are merged when they are freed: each block knows the block before it
+* in memory, so that merging doesn't need to walk the free lists either.
+*
+* pvPortMalloc() and vPortFree() are O(1), except when no list of larger
+* blocks has a free block and pvPortMalloc() walks the list of the requested
+* size before failing. The heap also keeps the number of
+* allocated blocks (and its high-water mark) of each size class, see
+* vPortGetHeapStatistics().
+*/
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
+ #error This file must not be used if configSUPPORT_DYNAMIC_ALLOCATION is 0
+#endif
+
+#if( portBYTE_ALIGNMENT != 8 )
+ #error This file assumes that portBYTE_ALIGNMENT is 8
+#endif
+
+/* Assumes 8bit bytes! */
+#define heapBITS_PER_BYTE			( ( size_t ) 8 )
+
+/* All the block sizes are multiples of portBYTE_ALIGNMENT. */
+#define heapALIGNMENT_LOG2			( 3U )
+#define heapSL_INDEX_COUNT_LOG2		( 3U )
+#define heapSL_INDEX_COUNT			( 1U << heapSL_INDEX_COUNT_LOG2 )
+#define heapFL_INDEX_SHIFT			( heapSL_INDEX_COUNT_LOG2 + heapALIGNMENT_LOG2 )
+#define heapFL_INDEX_COUNT			( portHEAP_SIZE_CLASS_COUNT )
+
+/* The blocks smaller than heapSMALL_BLOCK_SIZE are all in the first level 0,
+in lists of portBYTE_ALIGNMENT bytes. */
+#define heapSMALL_BLOCK_SIZE		( ( size_t ) 1 << heapFL_INDEX_SHIFT )
+
+/* The blocks must be smaller than heapMAXIMUM_BLOCK_SIZE (64KB, the RAM of the
+nRF52832). */
+#define heapMAXIMUM_BLOCK_SIZE		( heapSMALL_BLOCK_SIZE << ( heapFL_INDEX_COUNT - 1 ) )
+
+/* Set in the size of the free blocks. */
+#define heapBLOCK_FREE_BIT			( ( size_t ) 1 )
+
+/* Header of a block. The links of the free list are only valid while the block
+is free, they overlap the data of the application otherwise. */
+typedef struct A_BLOCK
+{
+ struct A_BLOCK *pxPreviousPhysicalBlock;	/*<< The block before this one in memory, NULL for the first block. */
+ size_t xBlockSize;							/*<< The size of the block, header included, and heapBLOCK_FREE_BIT. */
+ struct A_BLOCK *pxNextFreeBlock;			/*<< The next block in the same free list. */
+ struct A_BLOCK *pxPreviousFreeBlock;		/*<< The previous block in the same free list. */
+} Block_t;
+
+/* Only the part of the header before the links stays in front of the data of
+allocated blocks. */
+#define heapBLOCK_HEADER_SIZE		( offsetof( Block_t, pxNextFreeBlock ) )
+
+/* A free block must be able to hold the links of the free list. */
+#define heapMINIMUM_BLOCK_SIZE		( sizeof( Block_t ) )
+
+/*-----------------------------------------------------------*/
+
+/*
+* Called automatically to setup the required heap structures the first time
+* pvPortMalloc() is called.
+*/
+static void prvHeapInit( void );
+
+/*
+* Returns the first and second level indices of the list that contains the
+* free blocks of the given size.
+*/
+static void prvMapping( size_t xSize, size_t *pxFirstLevel, size_t *pxSecondLevel );
+
+/*
+* Returns a free block of at least the given size, or NULL if there is none.
+*/
+static Block_t *prvFindFreeBlock( size_t xSize );
+
+static void prvInsertFreeBlock( Block_t *pxBlock );
+static void prvRemoveFreeBlock( Block_t *pxBlock );
+
+/*
+* Splits the end of a block that is larger than the given size into a new free
+* block.
+*/
+static void prvSplitBlock( Block_t *pxBlock, size_t xSize );
+
+static size_t prvLargestFreeBlockSize( void );
+
+/*-----------------------------------------------------------*/
+
+/* The end marker: a block that is never free, after the last block. */
+static Block_t *pxEnd = NULL;
+
+static Block_t *pxFreeBlocks[ heapFL_INDEX_COUNT ][ heapSL_INDEX_COUNT ];
+static uint32_t ulFirstLevelBitmap = 0U;
+static uint8_t ucSecondLevelBitmaps[ heapFL_INDEX_COUNT ];
+
+/* Keeps track of the number of free bytes remaining, but says nothing about
+fragmentation. */
+static size_t xFreeBytesRemaining = 0U;
+static size_t xMinimumEverFreeBytesRemaining = 0U;
+static size_t xNumberOfFreeBlocks = 0U;
+static size_t xNumberOfSuccessfulAllocations = 0U;
+static size_t xNumberOfSuccessfulFrees = 0U;
+static uint16_t usAllocatedBlocks[ heapFL_INDEX_COUNT ];
+static uint16_t usPeakAllocatedBlocks[ heapFL_INDEX_COUNT ];
+
+static size_t xHeapSize = 0;
+
+/*-----------------------------------------------------------*/
+
+static size_t prvLog2( size_t xValue )
+{
+ return ( sizeof( unsigned long ) * heapBITS_PER_BYTE - 1U ) - ( size_t ) __builtin_clzl( xValue );
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvBlockSize( const Block_t *pxBlock )
+{
+ return pxBlock->xBlockSize & ~heapBLOCK_FREE_BIT;
+}
+/*-----------------------------------------------------------*/
+
+static Block_t *prvNextPhysicalBlock( const Block_t *pxBlock )
+{
+ return ( Block_t * ) ( ( ( uint8_t * ) pxBlock ) + prvBlockSize( pxBlock ) );
+}
+/*-----------------------------------------------------------*/
+
+void *pvPortMalloc( size_t xWantedSize )
+{
+ Block_t *pxBlock;
+ void *pvReturn = NULL;
+ size_t xBlockSize, xFirstLevel, xSecondLevel;
+
+ vTaskSuspendAll();
+ {
+   /* If this is the first call to malloc then the heap will require
+   initialisation to setup the lists of free blocks. */
+   if( pxEnd == NULL )
+   {
+     prvHeapInit();
+   }
+   else
+   {
+     mtCOVERAGE_TEST_MARKER();
+   }
+
+   /* Larger requests can't succeed, and could overflow the computation of
+   the size of the block. */
+   if( ( xWantedSize > 0 ) && ( xWantedSize < heapMAXIMUM_BLOCK_SIZE ) )
+   {
+     /* The block contains the header in addition to the requested amount
+     of bytes, and must be large enough to be put back in a free list. */
+     xBlockSize = ( xWantedSize + heapBLOCK_HEADER_SIZE + portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+     if( xBlockSize < heapMINIMUM_BLOCK_SIZE )
+     {
+       xBlockSize = heapMINIMUM_BLOCK_SIZE;
+     }
+
+     pxBlock = prvFindFreeBlock( xBlockSize );
+     if( pxBlock != NULL )
+     {
+       prvRemoveFreeBlock( pxBlock );
+       prvSplitBlock( pxBlock, xBlockSize );
+
+       if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+       {
+         xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+       }
+       else
+       {
+         mtCOVERAGE_TEST_MARKER();
+       }
+
+       prvMapping( prvBlockSize( pxBlock ), &xFirstLevel, &xSecondLevel );
+       usAllocatedBlocks[ xFirstLevel ]++;
+       if( usAllocatedBlocks[ xFirstLevel ] > usPeakAllocatedBlocks[ xFirstLevel ] )
+       {
+         usPeakAllocatedBlocks[ xFirstLevel ] = usAllocatedBlocks[ xFirstLevel ];
+       }
+       xNumberOfSuccessfulAllocations++;
+
+       /* Return the memory space pointed to - jumping over the header. */
+       pvReturn = ( void * ) ( ( ( uint8_t * ) pxBlock ) + heapBLOCK_HEADER_SIZE );
+     }
+     else
+     {
+       mtCOVERAGE_TEST_MARKER();
+     }
+   }
+   else
+   {
+     mtCOVERAGE_TEST_MARKER();
+   }
+
+   traceMALLOC( pvReturn, xWantedSize );
+ }
+ ( void ) xTaskResumeAll();
+
+#if( configUSE_MALLOC_FAILED_HOOK == 1 )
+ {
+   if( pvReturn == NULL )
+   {
+     extern void vApplicationMallocFailedHook( void );
+     vApplicationMallocFailedHook();
+   }
+   else
+   {
+     mtCOVERAGE_TEST_MARKER();
+   }
+ }
+#endif
+
+ configASSERT( ( ( ( size_t ) pvReturn ) & ( size_t ) portBYTE_ALIGNMENT_MASK ) == 0 );
+ return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortFree( void *pv )
+{
+ Block_t *pxBlock, *pxNextBlock, *pxPreviousBlock;
+ size_t xFirstLevel, xSecondLevel;
+
+ if( pv != NULL )
+ {
+   /* The memory being freed will have a header immediately before it. */
+   pxBlock = ( Block_t * ) ( ( ( uint8_t * ) pv ) - heapBLOCK_HEADER_SIZE );
+
+   /* Check the block is actually allocated. */
+   configASSERT( ( pxBlock->xBlockSize & heapBLOCK_FREE_BIT ) == 0 );
+
+   if( ( pxBlock->xBlockSize & heapBLOCK_FREE_BIT ) == 0 )
+   {
+     vTaskSuspendAll();
+     {
+       traceFREE( pv, prvBlockSize( pxBlock ) );
+
+       prvMapping( prvBlockSize( pxBlock ), &xFirstLevel, &xSecondLevel );
+       usAllocatedBlocks[ xFirstLevel ]--;
+       xNumberOfSuccessfulFrees++;
+
+       /* Merge the block with the free blocks around it. The end marker is
+       never free, the first block has no previous block. */
+       pxNextBlock = prvNextPhysicalBlock( pxBlock );
+       if( ( pxNextBlock->xBlockSize & heapBLOCK_FREE_BIT ) != 0 )
+       {
+         prvRemoveFreeBlock( pxNextBlock );
+         pxBlock->xBlockSize += pxNextBlock->xBlockSize;
+         prvNextPhysicalBlock( pxBlock )->pxPreviousPhysicalBlock = pxBlock;
+       }
+       else
+       {
+         mtCOVERAGE_TEST_MARKER();
+       }
+
+       pxPreviousBlock = pxBlock->pxPreviousPhysicalBlock;
+       if( ( pxPreviousBlock != NULL ) && ( ( pxPreviousBlock->xBlockSize & heapBLOCK_FREE_BIT ) != 0 ) )
+       {
+         prvRemoveFreeBlock( pxPreviousBlock );
+         pxPreviousBlock->xBlockSize += pxBlock->xBlockSize;
+         prvNextPhysicalBlock( pxPreviousBlock )->pxPreviousPhysicalBlock = pxPreviousBlock;
+         pxBlock = pxPreviousBlock;
+       }
+       else
+       {
+         mtCOVERAGE_TEST_MARKER();
+       }
+
+       prvInsertFreeBlock( pxBlock );
+     }
+     ( void ) xTaskResumeAll();
+   }
+   else
+   {
+     mtCOVERAGE_TEST_MARKER();
+   }
+ }
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetFreeHeapSize( void )
+{
+ return xFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetMinimumEverFreeHeapSize( void )
+{
+ return xMinimumEverFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetHeapSize( void )
+{
+ return xHeapSize;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetLargestFreeBlockSize( void )
+{
+ size_t xLargestBlockSize;
+
+ vTaskSuspendAll();
+ {
+   xLargestBlockSize = prvLargestFreeBlockSize();
+ }
+ ( void ) xTaskResumeAll();
+
+ /* The size of a block includes its header. */
+ return xLargestBlockSize > heapBLOCK_HEADER_SIZE ? xLargestBlockSize - heapBLOCK_HEADER_SIZE : 0U;
+}
+/*-----------------------------------------------------------*/
+
+void vPortGetHeapStatistics( HeapStatistics_t *pxHeapStatistics )
+{
+ size_t xLargestBlockSize;
+
+ vTaskSuspendAll();
+ {
+   xLargestBlockSize = prvLargestFreeBlockSize();
+
+   pxHeapStatistics->xFreeBytes = xFreeBytesRemaining;
+   pxHeapStatistics->xMinimumEverFreeBytes = xMinimumEverFreeBytesRemaining;
+   pxHeapStatistics->xLargestFreeBlock = xLargestBlockSize > heapBLOCK_HEADER_SIZE ? xLargestBlockSize - heapBLOCK_HEADER_SIZE : 0U;
+   pxHeapStatistics->xNumberOfFreeBlocks = xNumberOfFreeBlocks;
+   pxHeapStatistics->xNumberOfSuccessfulAllocations = xNumberOfSuccessfulAllocations;
+   pxHeapStatistics->xNumberOfSuccessfulFrees = xNumberOfSuccessfulFrees;
+   pxHeapStatistics->ucFragmentation =
+     xFreeBytesRemaining > 0U ? ( uint8_t ) ( ( ( xFreeBytesRemaining - xLargestBlockSize ) * 100U ) / xFreeBytesRemaining ) : 0U;
+   memcpy( pxHeapStatistics->usAllocatedBlocks, usAllocatedBlocks, sizeof( usAllocatedBlocks ) );
+   memcpy( pxHeapStatistics->usPeakAllocatedBlocks, usPeakAllocatedBlocks, sizeof( usPeakAllocatedBlocks ) );
+ }
+ ( void ) xTaskResumeAll();
+}
+/*-----------------------------------------------------------*/
+
+void vPortInitialiseBlocks( void )
+{
+ /* This just exists to keep the linker quiet. */
+}
+/*-----------------------------------------------------------*/
+
+extern uint8_t *__HeapLimit; // Defined by nrf_common.ld
+
+static void prvHeapInit( void )
+{
+ Block_t *pxFirstFreeBlock;
+ size_t uxAddress;
+ size_t uxEndAddress = ( size_t ) &__StackLimit;
+ uint8_t *pucHeap = ( uint8_t * ) &__HeapLimit;
+
+ xHeapSize = uxEndAddress - ( size_t ) pucHeap;
+
+ /* The data of the blocks must be aligned like the blocks. */
+ configASSERT( ( heapBLOCK_HEADER_SIZE & portBYTE_ALIGNMENT_MASK ) == 0 );
+
+ /* Ensure the heap starts on a correctly aligned boundary. */
+ uxAddress = ( size_t ) pucHeap;
+ uxAddress += portBYTE_ALIGNMENT_MASK;
+ uxAddress &= ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+ /* pxEnd is used to mark the end of the heap. Only its header is used, it
+ is never free and never merged with the last block. */
+ uxEndAddress -= heapBLOCK_HEADER_SIZE;
+ uxEndAddress &= ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+ pxEnd = ( void * ) uxEndAddress;
+ pxEnd->xBlockSize = 0;
+
+ /* To start with there is a single free block that is sized to take up the
+ entire heap space, minus the space taken by pxEnd. */
+ pxFirstFreeBlock = ( void * ) uxAddress;
+ pxFirstFreeBlock->pxPreviousPhysicalBlock = NULL;
+ pxFirstFreeBlock->xBlockSize = uxEndAddress - uxAddress;
+ pxEnd->pxPreviousPhysicalBlock = pxFirstFreeBlock;
+ configASSERT( pxFirstFreeBlock->xBlockSize < heapMAXIMUM_BLOCK_SIZE );
+
+ prvInsertFreeBlock( pxFirstFreeBlock );
+ xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+static void prvMapping( size_t xSize, size_t *pxFirstLevel, size_t *pxSecondLevel )
+{
+ size_t xLog2;
+
+ if( xSize < heapSMALL_BLOCK_SIZE )
+ {
+   *pxFirstLevel = 0;
+   *pxSecondLevel = xSize >> heapALIGNMENT_LOG2;
+ }
+ else
+ {
+   xLog2 = prvLog2( xSize );
+   *pxFirstLevel = xLog2 - ( heapFL_INDEX_SHIFT - 1U );
+   *pxSecondLevel = ( xSize >> ( xLog2 - heapSL_INDEX_COUNT_LOG2 ) ) ^ heapSL_INDEX_COUNT;
+ }
+}
+/*-----------------------------------------------------------*/
+
+static Block_t *prvFindFreeBlock( size_t xSize )
+{
+ size_t xFirstLevel, xSecondLevel, xRoundedSize;
+ uint32_t ulFirstLevelMap, ulSecondLevelMap;
+ Block_t *pxBlock;
+
+ /* Round the size up to the next list, so that any block of that list is
+ large enough. */
+ xRoundedSize = xSize;
+ if( xSize >= heapSMALL_BLOCK_SIZE )
+ {
+   xRoundedSize += ( ( size_t ) 1 << ( prvLog2( xSize ) - heapSL_INDEX_COUNT_LOG2 ) ) - 1U;
+ }
+ else
+ {
+   mtCOVERAGE_TEST_MARKER();
+ }
+ prvMapping( xRoundedSize, &xFirstLevel, &xSecondLevel );
+
+ if( xFirstLevel < heapFL_INDEX_COUNT )
+ {
+   /* Smallest non empty list of the same first level, otherwise of the
+   next non empty first level. */
+   ulSecondLevelMap = ucSecondLevelBitmaps[ xFirstLevel ] & ( ~0U << xSecondLevel );
+   if( ulSecondLevelMap == 0U )
+   {
+     ulFirstLevelMap = ulFirstLevelBitmap & ( ~0U << ( xFirstLevel + 1U ) );
+     if( ulFirstLevelMap != 0U )
+     {
+       xFirstLevel = ( size_t ) __builtin_ctz( ulFirstLevelMap );
+       ulSecondLevelMap = ucSecondLevelBitmaps[ xFirstLevel ];
+     }
+     else
+     {
+       mtCOVERAGE_TEST_MARKER();
+     }
+   }
+   else
+   {
+     mtCOVERAGE_TEST_MARKER();
+   }
+
+   if( ulSecondLevelMap != 0U )
+   {
+     xSecondLevel = ( size_t ) __builtin_ctz( ulSecondLevelMap );
+     return pxFreeBlocks[ xFirstLevel ][ xSecondLevel ];
+   }
+   else
+   {
+     mtCOVERAGE_TEST_MARKER();
+   }
+ }
+ else
+ {
+   mtCOVERAGE_TEST_MARKER();
+ }
+
+ /* The heap is nearly full: before failing, look for a block that is large
+ enough in the list of the requested size, which was skipped by the rounding.
+ Only this path walks a list. */
+ prvMapping( xSize, &xFirstLevel, &xSecondLevel );
+ for( pxBlock = pxFreeBlocks[ xFirstLevel ][ xSecondLevel ]; pxBlock != NULL; pxBlock = pxBlock->pxNextFreeBlock )
+ {
+   if( prvBlockSize( pxBlock ) >= xSize )
+   {
+     return pxBlock;
+   }
+ }
+ return NULL;
+}
+/*-----------------------------------------------------------*/
+
+static void prvInsertFreeBlock( Block_t *pxBlock )
+{
+ size_t xFirstLevel, xSecondLevel;
+ size_t xBlockSize = prvBlockSize( pxBlock );
+
+ prvMapping( xBlockSize, &xFirstLevel, &xSecondLevel );
+
+ pxBlock->pxPreviousFreeBlock = NULL;
+ pxBlock->pxNextFreeBlock = pxFreeBlocks[ xFirstLevel ][ xSecondLevel ];
+ if( pxBlock->pxNextFreeBlock != NULL )
+ {
+   pxBlock->pxNextFreeBlock->pxPreviousFreeBlock = pxBlock;
+ }
+ else
+ {
+   mtCOVERAGE_TEST_MARKER();
+ }
+ pxFreeBlocks[ xFirstLevel ][ xSecondLevel ] = pxBlock;
+ ulFirstLevelBitmap |= 1U << xFirstLevel;
+ ucSecondLevelBitmaps[ xFirstLevel ] |= ( uint8_t ) ( 1U << xSecondLevel );
+
+ pxBlock->xBlockSize = xBlockSize | heapBLOCK_FREE_BIT;
+ xFreeBytesRemaining += xBlockSize;
+ xNumberOfFreeBlocks++;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRemoveFreeBlock( Block_t *pxBlock )
+{
+ size_t xFirstLevel, xSecondLevel;
+ size_t xBlockSize = prvBlockSize( pxBlock );
+
+ prvMapping( xBlockSize, &xFirstLevel, &xSecondLevel );
+
+ if( pxBlock->pxNextFreeBlock != NULL )
+ {
+   pxBlock->pxNextFreeBlock->pxPreviousFreeBlock = pxBlock->pxPreviousFreeBlock;
+ }
+ else
+ {
+   mtCOVERAGE_TEST_MARKER();
+ }
+ if( pxBlock->pxPreviousFreeBlock != NULL )
+ {
+   pxBlock->pxPreviousFreeBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
+ }
+ else
+ {
+   /* The block is the head of its list. */
+   pxFreeBlocks[ xFirstLevel ][ xSecondLevel ] = pxBlock->pxNextFreeBlock;
+   if( pxBlock->pxNextFreeBlock == NULL )
+   {
+     ucSecondLevelBitmaps[ xFirstLevel ] &= ( uint8_t ) ~( 1U << xSecondLevel );
+     if( ucSecondLevelBitmaps[ xFirstLevel ] == 0U )
+     {
+       ulFirstLevelBitmap &= ~( 1U << xFirstLevel );
+     }
+     else
+     {
+       mtCOVERAGE_TEST_MARKER();
+     }
+   }
+   else
+   {
+     mtCOVERAGE_TEST_MARKER();
+   }
+ }
+
+ pxBlock->xBlockSize = xBlockSize;
+ xFreeBytesRemaining -= xBlockSize;
+ xNumberOfFreeBlocks--;
+}
+/*-----------------------------------------------------------*/
+
+static void prvSplitBlock( Block_t *pxBlock, size_t xSize )
+{
+ Block_t *pxNewBlock;
+ size_t xRemainingSize = prvBlockSize( pxBlock ) - xSize;
+
+ if( xRemainingSize >= heapMINIMUM_BLOCK_SIZE )
+ {
+   /* The block after pxBlock is not free (adjacent free blocks are always
+   merged), the new block doesn't need to be merged with it. */
+   pxNewBlock = ( Block_t * ) ( ( ( uint8_t * ) pxBlock ) + xSize );
+   configASSERT( ( ( ( size_t ) pxNewBlock ) & portBYTE_ALIGNMENT_MASK ) == 0 );
+   pxNewBlock->pxPreviousPhysicalBlock = pxBlock;
+   pxNewBlock->xBlockSize = xRemainingSize;
+   prvNextPhysicalBlock( pxNewBlock )->pxPreviousPhysicalBlock = pxNewBlock;
+   pxBlock->xBlockSize = xSize;
+
+   prvInsertFreeBlock( pxNewBlock );
+ }
+ else
+ {
+   mtCOVERAGE_TEST_MARKER();
+ }
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvLargestFreeBlockSize( void )
+{
+ size_t xFirstLevel, xSecondLevel;
+ size_t xLargestBlockSize = 0U;
+ Block_t *pxBlock;
+
+ if( ulFirstLevelBitmap == 0U )
+ {
+   return 0U;
+ }
+
+ /* The largest free block is in the last non empty list, which only holds
+ blocks of similar sizes. */
+ xFirstLevel = prvLog2( ulFirstLevelBitmap );
+ xSecondLevel = prvLog2( ucSecondLevelBitmaps[ xFirstLevel ] );
+ for( pxBlock = pxFreeBlocks[ xFirstLevel ][ xSecondLevel ]; pxBlock != NULL; pxBlock = pxBlock->pxNextFreeBlock )
+ {
+   if( prvBlockSize( pxBlock ) > xLargestBlockSize )
+   {
+     xLargestBlockSize = prvBlockSize( pxBlock );
+   }
+ }
+ return xLargestBlockSize;
+}
+/*-----------------------------------------------------------*/
+
+void* pvPortRealloc(void* pv, size_t xWantedSize) {
+ size_t move_size;
+ size_t block_size;
+ Block_t* pxBlock;
+ void* pvReturn = NULL;
+
+ if (xWantedSize == 0) {
+   // Zero bytes requested, do nothing (according to libc, this behavior implementation defined)
+   return NULL;
+ }
+
+ if (pv == NULL) {
+   // pv points to NULL. Allocate a new buffer.
+   return pvPortMalloc(xWantedSize);
+ }
+
+ // The memory being reallocated will have a header immediately before it.
+ pxBlock = (Block_t*) (((uint8_t*) pv) - heapBLOCK_HEADER_SIZE);
+
+ // Check allocate block
+ if ((pxBlock->xBlockSize & heapBLOCK_FREE_BIT) == 0) {
+   // The size of the data of the block, without its header
+   block_size = prvBlockSize(pxBlock) - heapBLOCK_HEADER_SIZE;
+
+   // Allocate a new buffer
+   pvReturn = pvPortMalloc(xWantedSize);
+
+   // Check creation and determine the data size to be copied to the new buffer
+   if (pvReturn != NULL) {
+     if (block_size < xWantedSize) {
+       move_size = block_size;
+     } else {
+       move_size = xWantedSize;
+     }
+
+     // Copy the data from the old buffer to the new one
+     memcpy(pvReturn, pv, move_size);
+
+     // Free the old buffer
+     vPortFree(pv);
+   }
+ } else {
+   // pv does not point to a valid memory buffer. Allocate a new one
+   pvReturn = pvPortMalloc(xWantedSize);
+ }
+
+ return pvReturn;
+}
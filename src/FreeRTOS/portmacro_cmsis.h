@@ -181,6 +181,26 @@ __STATIC_INLINE uint32_t ulPortRaiseBASEPRI( void )
 /*-----------------------------------------------------------*/
 
 size_t xPortGetHeapSize(void);
+// Largest allocation that can currently succeed, the free heap size says nothing about fragmentation
+size_t xPortGetLargestFreeBlockSize(void);
+
+// Size class n of the heap statistics holds the blocks (header included) smaller than 64 << n bytes, and at least as large
+// as the blocks of the previous class. The largest class ends at 64KB, the RAM of the nRF52832.
+#define portHEAP_SIZE_CLASS_COUNT 11
+
+typedef struct {
+    size_t xFreeBytes;
+    size_t xMinimumEverFreeBytes;  // High-water mark of the heap
+    size_t xLargestFreeBlock;      // Largest allocation that can currently succeed
+    size_t xNumberOfFreeBlocks;
+    size_t xNumberOfSuccessfulAllocations;
+    size_t xNumberOfSuccessfulFrees;
+    uint8_t ucFragmentation;       // Percentage of the free bytes outside of the largest free block
+    uint16_t usAllocatedBlocks[portHEAP_SIZE_CLASS_COUNT];
+    uint16_t usPeakAllocatedBlocks[portHEAP_SIZE_CLASS_COUNT];
+} HeapStatistics_t;
+
+void vPortGetHeapStatistics(HeapStatistics_t* pxHeapStatistics);
 
 #ifdef __cplusplus
 }
@@ -10,12 +10,15 @@ using namespace Pinetime::Controllers;
 
 Battery* Battery::instance = nullptr;
 
-Battery::Battery() {
+Battery::Battery(UpdateBus& updateBus) : updateBus {updateBus} {
   instance = this;
   nrf_gpio_cfg_input(PinMap::Charging, static_cast<nrf_gpio_pin_pull_t> GPIO_PIN_CNF_PULL_Disabled);
 }
 
 void Battery::ReadPowerState() {
+  bool wasCharging = IsCharging();
+  bool wasPowerPresent = isPowerPresent;
+
   isCharging = (nrf_gpio_pin_read(PinMap::Charging) == 0);
   isPowerPresent = (nrf_gpio_pin_read(PinMap::PowerPresent) == 0);
 
@@ -24,6 +27,10 @@ void Battery::ReadPowerState() {
   } else if (!isPowerPresent) {
     isFull = false;
   }
+
+  if (IsCharging() != wasCharging || isPowerPresent != wasPowerPresent) {
+    updateBus.Publish(UpdateBus::Topic::Battery);
+  }
 }
 
 void Battery::MeasureVoltage() {
@@ -85,6 +92,7 @@ void Battery::SaadcEventHandler(nrfx_saadc_evt_t const* p_event) {
       firstMeasurement = false;
       percentRemaining = newPercent;
       systemTask->PushMessage(System::Messages::BatteryPercentageUpdated);
+      updateBus.Publish(UpdateBus::Topic::Battery);
     }
 
     nrfx_saadc_uninit();
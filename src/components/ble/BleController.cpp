@@ -8,10 +8,12 @@ bool Ble::IsConnected() const {
 
 void Ble::Connect() {
   isConnected = true;
+  updateBus.Publish(UpdateBus::Topic::Ble);
 }
 
 void Ble::Disconnect() {
   isConnected = false;
+  updateBus.Publish(UpdateBus::Topic::Ble);
 }
 
 bool Ble::IsRadioEnabled() const {
@@ -20,10 +22,12 @@ bool Ble::IsRadioEnabled() const {
 
 void Ble::EnableRadio() {
   isRadioEnabled = true;
+  updateBus.Publish(UpdateBus::Topic::Ble);
 }
 
 void Ble::DisableRadio() {
   isRadioEnabled = false;
+  updateBus.Publish(UpdateBus::Topic::Ble);
 }
 
 void Ble::StartFirmwareUpdate() {
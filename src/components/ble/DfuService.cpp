@@ -413,9 +413,7 @@ void DfuService::DfuImage::WriteMagicNumber() {
 }
 
 void DfuService::DfuImage::Erase() {
-  for (size_t erased = 0; erased < maxSize; erased += 0x1000) {
-    spiNorFlash.SectorErase(writeOffset + erased);
-  }
+  spiNorFlash.EraseRange(writeOffset, maxSize);
 }
 
 bool DfuService::DfuImage::Validate() {
@@ -20,6 +20,7 @@ void NotificationManager::Push(NotificationManager::Notification&& notif) {
   if (size < notifications.size()) {
     size++;
   }
+  updateBus.Publish(UpdateBus::Topic::Notifications);
 }
 
 NotificationManager::Notification::Id NotificationManager::GetNextId() {
@@ -125,7 +126,11 @@ bool NotificationManager::AreNewNotificationsAvailable() const {
 }
 
 bool NotificationManager::ClearNewNotificationFlag() {
-  return newNotification.exchange(false);
+  bool wasNew = newNotification.exchange(false);
+  if (wasNew) {
+    updateBus.Publish(UpdateBus::Topic::Notifications);
+  }
+  return wasNew;
 }
 
 size_t NotificationManager::NbNotifications() const {
@@ -4,6 +4,7 @@
 
 #include "nrf_ppi.h"
 #include "nrfx_gpiote.h"
+#include "drivers/PpiMap.h"
 
 namespace Pinetime {
   namespace Controllers {
@@ -34,12 +35,9 @@ namespace Pinetime {
       // Wraparound point in timer ticks
       // Defines the number of brightness levels between each pin
       static constexpr uint16_t timerPeriod = timerFrequency / pwmFreq;
-      // Warning: nimble reserves some PPIs
-      // https://github.com/InfiniTimeOrg/InfiniTime/blob/034d83fe6baf1ab3875a34f8cee387e24410a824/src/libs/mynewt-nimble/nimble/drivers/nrf52/src/ble_phy.c#L53
-      // SpiMaster uses PPI 0 for an erratum workaround
-      // Channel 1, 2 should be free to use
-      static constexpr nrf_ppi_channel_t ppiBacklightOn = NRF_PPI_CHANNEL1;
-      static constexpr nrf_ppi_channel_t ppiBacklightOff = NRF_PPI_CHANNEL2;
+      // Warning: nimble reserves some PPIs, see PpiMap
+      static constexpr nrf_ppi_channel_t ppiBacklightOn = PpiMap::BacklightOn;
+      static constexpr nrf_ppi_channel_t ppiBacklightOff = PpiMap::BacklightOff;
 
       void ApplyBrightness(uint16_t val);
     };
@@ -25,7 +25,8 @@ namespace {
   }
 }
 
-DateTime::DateTime(Controllers::Settings& settingsController) : settingsController {settingsController} {
+DateTime::DateTime(Controllers::Settings& settingsController, Controllers::UpdateBus& updateBus)
+  : settingsController {settingsController}, updateBus {updateBus} {
   mutex = xSemaphoreCreateMutex();
   ASSERT(mutex != nullptr);
   xSemaphoreGive(mutex);
@@ -110,6 +111,12 @@ void DateTime::UpdateTime(uint32_t systickCounter, bool forceUpdate) {
   auto minute = Minutes();
   auto hour = Hours();
 
+  updateBus.Publish(UpdateBus::Topic::Seconds);
+  if (minute != publishedMinute || forceUpdate) {
+    publishedMinute = minute;
+    updateBus.Publish(UpdateBus::Topic::Time);
+  }
+
   if (minute == 0 && !isHourAlreadyNotified) {
     isHourAlreadyNotified = true;
     if (systemTask != nullptr) {
@@ -5,6 +5,7 @@
 #include <ctime>
 #include <string>
 #include "components/settings/Settings.h"
+#include "components/updatebus/UpdateBus.h"
 #include <FreeRTOS.h>
 #include <semphr.h>
 
@@ -16,7 +17,7 @@ namespace Pinetime {
   namespace Controllers {
     class DateTime {
     public:
-      DateTime(Controllers::Settings& settingsController);
+      DateTime(Controllers::Settings& settingsController, Controllers::UpdateBus& updateBus);
       enum class Days : uint8_t { Unknown, Monday, Tuesday, Wednesday, Thursday, Friday, Saturday, Sunday };
       enum class Months : uint8_t {
         Unknown,
@@ -156,8 +157,10 @@ namespace Pinetime {
       bool isMidnightAlreadyNotified = false;
       bool isHourAlreadyNotified = true;
       bool isHalfHourAlreadyNotified = true;
+      int publishedMinute = -1;
       System::SystemTask* systemTask = nullptr;
       Controllers::Settings& settingsController;
+      Controllers::UpdateBus& updateBus;
     };
   }
 }
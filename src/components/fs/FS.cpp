@@ -1,11 +1,15 @@
 #include "components/fs/FS.h"
+#include "components/fs/Superblock.h"
+#include <algorithm>
 #include <cstring>
+#include <memory>
 #include <littlefs/lfs.h>
 #include <lvgl/lvgl.h>
+#include <libraries/log/nrf_log.h>
 
 using namespace Pinetime::Controllers;
 
-FS::FS(Pinetime::Drivers::SpiNorFlash& driver)
+FS::FS(Pinetime::Drivers::SpiNorFlash& driver, Profile profile)
   : flashDriver {driver},
     lfsConfig {
       .context = this,
@@ -13,6 +17,8 @@ FS::FS(Pinetime::Drivers::SpiNorFlash& driver)
       .prog = SectorProg,
       .erase = SectorErase,
       .sync = SectorSync,
+      .lock = Lock,
+      .unlock = Unlock,
 
       .read_size = 16,
       .prog_size = 8,
@@ -20,15 +26,28 @@ FS::FS(Pinetime::Drivers::SpiNorFlash& driver)
       .block_count = size / blockSize,
       .block_cycles = 1000u,
 
-      .cache_size = 16,
-      .lookahead_size = 16,
+      .cache_size = GetProfileConfig(profile).cacheSize,
+      .lookahead_size = GetProfileConfig(profile).lookaheadSize,
 
       .name_max = 50,
       .attr_max = 50,
-    } {
+    },
+    resourcePack {driver, resourcePackAddress, resourcePackSize} {
 }
 
 void FS::Init() {
+  if (lfsMutex == nullptr) {
+    lfsMutex = xSemaphoreCreateMutex();
+    ASSERT(lfsMutex != nullptr);
+  }
+
+  // The file system might have been formatted before the resource pack area was reserved.
+  // Its size is read from the superblock: older versions of LittleFS mount it with any block_count,
+  // and the blocks past the configured count are then unreadable.
+  legacyLayout = ReadFormattedBlockCount() > size / blockSize;
+  if (legacyLayout) {
+    lfsConfig.block_count = legacySize / blockSize;
+  }
 
   // try mount
   int err = lfs_mount(&lfs, &lfsConfig);
@@ -36,6 +55,8 @@ void FS::Init() {
   // reformat if we can't mount the filesystem
   // this should only happen on the first boot
   if (err != LFS_ERR_OK) {
+    legacyLayout = false;
+    lfsConfig.block_count = size / blockSize;
     lfs_format(&lfs, &lfsConfig);
     err = lfs_mount(&lfs, &lfsConfig);
     if (err != LFS_ERR_OK) {
@@ -44,16 +65,228 @@ void FS::Init() {
   }
 
 #ifndef PINETIME_IS_RECOVERY
+  if (!legacyLayout) {
+    resourcePack.Init();
+  }
   VerifyResource();
 #endif
 }
 
+uint32_t FS::ReadFormattedBlockCount() {
+  uint8_t data[Superblock::readSize];
+  bool found = false;
+  uint32_t newestRevision = 0;
+  uint32_t blockCount = 0;
+  // The superblock is a metadata pair: the block with the newest revision is the current one
+  for (size_t block = 0; block < 2; block++) {
+    uint32_t revision;
+    uint32_t count;
+    flashDriver.Read(startAddress + block * blockSize, data, sizeof(data));
+    if (Superblock::Parse(data, sizeof(data), revision, count) && (!found || static_cast<int32_t>(revision - newestRevision) > 0)) {
+      found = true;
+      newestRevision = revision;
+      blockCount = count;
+    }
+  }
+  return blockCount;
+}
+
+void FS::InstallResourcePack(const std::function<void()>& progress) {
+  if (legacyLayout) {
+    return;
+  }
+
+  lfs_file_t file = {};
+  if (FileOpen(&file, resourcePackFile, LFS_O_RDONLY) < 0) {
+    return;
+  }
+
+  lfs_soff_t packSize = lfs_file_size(&lfs, &file);
+  if (packSize <= 0 || static_cast<size_t>(packSize) > resourcePackSize) {
+    FileClose(&file);
+    return;
+  }
+
+  NRF_LOG_INFO("[FS] Installing resource pack (%d bytes)", packSize);
+  resourcePack.Disable();
+
+  static constexpr size_t eraseChunkSize = 0x10000;
+  for (size_t erased = 0; erased < static_cast<size_t>(packSize); erased += eraseChunkSize) {
+    flashDriver.EraseRange(resourcePackAddress + erased, std::min<size_t>(eraseChunkSize, packSize - erased));
+    progress();
+  }
+
+  // Too large for the stack of the system task
+  static constexpr size_t copyChunkSize = 256;
+  auto buffer = std::make_unique<uint8_t[]>(copyChunkSize);
+  size_t copied = 0;
+  while (copied < static_cast<size_t>(packSize)) {
+    int read = FileRead(&file, buffer.get(), copyChunkSize);
+    if (read <= 0) {
+      break;
+    }
+    flashDriver.Write(resourcePackAddress + copied, buffer.get(), read);
+    copied += read;
+    if ((copied % eraseChunkSize) == 0) {
+      progress();
+    }
+  }
+  FileClose(&file);
+
+  resourcePack.Init();
+  if (copied == static_cast<size_t>(packSize) && resourcePack.IsValid()) {
+    FileDelete(resourcePackFile);
+  }
+  VerifyResource();
+}
+
 void FS::VerifyResource() {
-  // validate the resource metadata
-  resourcesValid = true;
+  resourcesChanged = false;
+  verifyPosition = 0;
+  // DisplayApp reads availableResources while it is rebuilt: it is only stored once complete
+  uint32_t available = 0;
+  uint32_t pending = 0;
+
+  // The manifest has the same format as the index of the resource pack
+  lfs_file_t manifest = {};
+  ResourcePack::Header manifestHeader = {};
+  bool hasManifest = FileOpen(&manifest, resourceManifestFile, LFS_O_RDONLY) >= 0;
+  if (hasManifest) {
+    if (FileRead(&manifest, reinterpret_cast<uint8_t*>(&manifestHeader), sizeof(manifestHeader)) != sizeof(manifestHeader) ||
+        manifestHeader.magic != resourceManifestMagic || manifestHeader.version != ResourcePack::version) {
+      manifestHeader.count = 0;
+    }
+  }
+
+  for (size_t i = 0; i < resourcePaths.size(); i++) {
+    auto& check = resourceChecks[i];
+    const uint32_t mask = 1u << i;
+
+    if (resourcePack.Find(resourcePaths[i], check.entry)) {
+      check.packed = true;
+      check.hasCrc = true;
+      available |= mask;
+      pending |= mask;
+      continue;
+    }
+
+    lfs_info info;
+    if (Stat(resourcePaths[i], &info) < 0 || info.type != LFS_TYPE_REG) {
+      continue;
+    }
+    check = {false, {0, info.size, 0}, false};
+
+    ResourcePack::IndexEntry indexEntry;
+    if (hasManifest && FindInManifest(&manifest, manifestHeader.count, resourcePaths[i], indexEntry)) {
+      if (indexEntry.size != info.size) {
+        NRF_LOG_INFO("[FS] %s : unexpected size", resourcePaths[i]);
+        continue;
+      }
+      check.entry.crc = indexEntry.crc;
+      check.hasCrc = true;
+      pending |= mask;
+    }
+    available |= mask;
+  }
+
+  if (hasManifest) {
+    FileClose(&manifest);
+  }
+  pendingResources = pending;
+  availableResources = available;
+}
+
+bool FS::FindInManifest(lfs_file_t* manifest, uint16_t count, const char* path, ResourcePack::IndexEntry& indexEntry) {
+  FileSeek(manifest, sizeof(ResourcePack::Header));
+  for (uint16_t i = 0; i < count; i++) {
+    if (FileRead(manifest, reinterpret_cast<uint8_t*>(&indexEntry), sizeof(indexEntry)) != sizeof(indexEntry)) {
+      return false;
+    }
+    if (std::strncmp(indexEntry.path, path, ResourcePack::maxPathLength) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool FS::VerifyResourceSlice() {
+  // Resources might have been uploaded or deleted over BLE
+  if (resourcesChanged) {
+    VerifyResource();
+  }
+  if (pendingResources == 0) {
+    return false;
+  }
+
+  const size_t index = __builtin_ctz(pendingResources);
+  const uint32_t mask = 1u << index;
+  const auto& check = resourceChecks[index];
+
+  lfs_file_t file = {};
+  if (!check.packed) {
+    if (FileOpen(&file, resourcePaths[index], LFS_O_RDONLY) < 0) {
+      availableResources &= ~mask;
+      pendingResources &= ~mask;
+      verifyPosition = 0;
+      return pendingResources != 0;
+    }
+    FileSeek(&file, verifyPosition);
+  }
+
+  if (verifyPosition == 0) {
+    verifyCrc = 0xffffffff;
+  }
+
+  uint8_t buffer[128];
+  const uint32_t sliceEnd = std::min<uint32_t>(check.entry.size, verifyPosition + verifySliceSize);
+  while (verifyPosition < sliceEnd) {
+    const size_t toRead = std::min<size_t>(sizeof(buffer), sliceEnd - verifyPosition);
+    int read;
+    if (check.packed) {
+      read = resourcePack.Read(check.entry, verifyPosition, buffer, toRead);
+    } else {
+      read = FileRead(&file, buffer, toRead);
+    }
+    if (read <= 0) {
+      break;
+    }
+    verifyCrc = lfs_crc(verifyCrc, buffer, read);
+    verifyPosition += read;
+  }
+
+  if (!check.packed) {
+    FileClose(&file);
+  }
+
+  if (verifyPosition < sliceEnd || verifyPosition == check.entry.size) {
+    // lfs_crc() does not invert the result, unlike the CRC32 computed by the package tool
+    if (verifyPosition != check.entry.size || ~verifyCrc != check.entry.crc) {
+      NRF_LOG_INFO("[FS] %s : invalid CRC", resourcePaths[index]);
+      availableResources &= ~mask;
+    }
+    pendingResources &= ~mask;
+    verifyPosition = 0;
+  }
+  return pendingResources != 0;
+}
+
+bool FS::IsResourceAvailable(Resources resource) const {
+  return (availableResources & (1u << static_cast<uint8_t>(resource))) != 0;
+}
+
+bool FS::IsResourceFile(const char* path) {
+  if (std::strcmp(path, resourceManifestFile) == 0) {
+    return true;
+  }
+  return std::any_of(resourcePaths.begin(), resourcePaths.end(), [path](const char* resourcePath) {
+    return std::strcmp(path, resourcePath) == 0;
+  });
 }
 
 int FS::FileOpen(lfs_file_t* file_p, const char* fileName, const int flags) {
+  if ((flags & LFS_O_WRONLY) != 0 && IsResourceFile(fileName)) {
+    resourcesChanged = true;
+  }
   return lfs_file_open(&lfs, file_p, fileName, flags);
 }
 
@@ -73,7 +306,12 @@ int FS::FileSeek(lfs_file_t* file_p, uint32_t pos) {
   return lfs_file_seek(&lfs, file_p, pos, LFS_SEEK_SET);
 }
 
+int FS::FileSize(lfs_file_t* file_p) {
+  return lfs_file_size(&lfs, file_p);
+}
+
 int FS::FileDelete(const char* fileName) {
+  resourcesChanged |= IsResourceFile(fileName);
   return lfs_remove(&lfs, fileName);
 }
 
@@ -98,6 +336,7 @@ int FS::DirCreate(const char* path) {
 }
 
 int FS::Rename(const char* oldPath, const char* newPath) {
+  resourcesChanged |= IsResourceFile(oldPath) || IsResourceFile(newPath);
   return lfs_rename(&lfs, oldPath, newPath);
 }
 
@@ -121,6 +360,7 @@ int FS::SectorSync(const struct lfs_config* /*c*/) {
 int FS::SectorErase(const struct lfs_config* c, lfs_block_t block) {
   Pinetime::Controllers::FS& lfs = *(static_cast<Pinetime::Controllers::FS*>(c->context));
   const size_t address = startAddress + (block * blockSize);
+  lfs.readCache.Invalidate(address, blockSize);
   lfs.flashDriver.SectorErase(address);
   return lfs.flashDriver.EraseFailed() ? -1 : 0;
 }
@@ -129,12 +369,32 @@ int FS::SectorProg(const struct lfs_config* c, lfs_block_t block, lfs_off_t off,
   Pinetime::Controllers::FS& lfs = *(static_cast<Pinetime::Controllers::FS*>(c->context));
   const size_t address = startAddress + (block * blockSize) + off;
   lfs.flashDriver.Write(address, (uint8_t*) buffer, size);
+  lfs.readCache.Write(address, static_cast<const uint8_t*>(buffer), size);
   return lfs.flashDriver.ProgramFailed() ? -1 : 0;
 }
 
+int FS::Lock(const struct lfs_config* c) {
+  Pinetime::Controllers::FS& lfs = *(static_cast<Pinetime::Controllers::FS*>(c->context));
+  xSemaphoreTake(lfs.lfsMutex, portMAX_DELAY);
+  return 0;
+}
+
+int FS::Unlock(const struct lfs_config* c) {
+  Pinetime::Controllers::FS& lfs = *(static_cast<Pinetime::Controllers::FS*>(c->context));
+  xSemaphoreGive(lfs.lfsMutex);
+  return 0;
+}
+
 int FS::SectorRead(const struct lfs_config* c, lfs_block_t block, lfs_off_t off, void* buffer, lfs_size_t size) {
   Pinetime::Controllers::FS& lfs = *(static_cast<Pinetime::Controllers::FS*>(c->context));
   const size_t address = startAddress + (block * blockSize) + off;
-  lfs.flashDriver.Read(address, static_cast<uint8_t*>(buffer), size);
+  // LittleFS bypasses its cache and reads directly into the file buffer for large reads
+  if (size > readCacheLineSize) {
+    lfs.flashDriver.StreamRead(address, static_cast<uint8_t*>(buffer), size);
+  } else {
+    lfs.readCache.Read(address, static_cast<uint8_t*>(buffer), size, [&lfs](uint32_t lineAddress, uint8_t* line, size_t lineSize) {
+      lfs.flashDriver.Read(lineAddress, line, lineSize);
+    });
+  }
   return 0;
 }
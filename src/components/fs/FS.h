@@ -1,14 +1,36 @@
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <cstdint>
+#include <functional>
+#include <FreeRTOS.h>
+#include <semphr.h>
 #include "drivers/SpiNorFlash.h"
+#include "components/fs/ReadCache.h"
+#include "components/fs/ResourcePack.h"
+#include "components/fs/Resources.h"
 #include <littlefs/lfs.h>
 
 namespace Pinetime {
   namespace Controllers {
     class FS {
     public:
-      FS(Pinetime::Drivers::SpiNorFlash&);
+      // LittleFS cache and lookahead sizes. Larger caches mean fewer, longer flash transactions,
+      // and a larger lookahead lets the block allocator scan the whole FS in one pass,
+      // at the cost of RAM (the caches are allocated for the FS and for each open file).
+      // read_size and prog_size are the same in all profiles, so the on-flash format does not depend on the profile.
+      enum class Profile : uint8_t { Compact, Balanced, Throughput };
+      // Compact has the cache sizes InfiniTime always used, the other profiles are selected with -DFS_PROFILE.
+#if defined(FS_PROFILE_BALANCED)
+      static constexpr Profile defaultProfile = Profile::Balanced;
+#elif defined(FS_PROFILE_THROUGHPUT)
+      static constexpr Profile defaultProfile = Profile::Throughput;
+#else
+      static constexpr Profile defaultProfile = Profile::Compact;
+#endif
+
+      FS(Pinetime::Drivers::SpiNorFlash&, Profile profile = defaultProfile);
 
       void Init();
 
@@ -17,6 +39,7 @@ namespace Pinetime {
       int FileRead(lfs_file_t* file_p, uint8_t* buff, uint32_t size);
       int FileWrite(lfs_file_t* file_p, const uint8_t* buff, uint32_t size);
       int FileSeek(lfs_file_t* file_p, uint32_t pos);
+      int FileSize(lfs_file_t* file_p);
 
       int FileDelete(const char* fileName);
 
@@ -29,7 +52,25 @@ namespace Pinetime {
       lfs_ssize_t GetFSSize();
       int Rename(const char* oldPath, const char* newPath);
       int Stat(const char* path, lfs_info* info);
+
+      // Checks which resources are present, and their size against the manifest generated by
+      // src/resources/generate-package.py. Their content is then checked by VerifyResourceSlice().
       void VerifyResource();
+      // Checks the CRC of the next few KB of resources, and the presence of the resources again if they
+      // were modified. Returns false once all the resources are checked.
+      bool VerifyResourceSlice();
+      // Resources (fonts, images) are looked up in the resource pack first, then in LittleFS
+      bool IsResourceAvailable(Resources resource) const;
+      static constexpr const char* resourceManifestFile = "/resources.mft";
+      static constexpr uint32_t resourceManifestMagic = 0x464D5249; // "IRMF"
+
+      ResourcePack& GetResourcePack() {
+        return resourcePack;
+      }
+      // Moves a resource pack uploaded as resourcePackFile to its reserved flash area.
+      // progress is called regularly, the installation can take a few seconds.
+      void InstallResourcePack(const std::function<void()>& progress);
+      static constexpr const char* resourcePackFile = "/resources.pak";
 
       static size_t getSize() {
         return size;
@@ -39,6 +80,15 @@ namespace Pinetime {
         return blockSize;
       }
 
+      // Reads that fit in a line go through readCache, larger ones are streamed from the flash
+      static constexpr size_t readCacheLineSize = 256;
+      static constexpr size_t readCacheLines = 4;
+      using FlashReadCache = ReadCache<readCacheLineSize, readCacheLines>;
+
+      FlashReadCache::Statistics GetReadCacheStatistics() const {
+        return readCache.GetStatistics();
+      }
+
     private:
       Pinetime::Drivers::SpiNorFlash& flashDriver;
 
@@ -61,22 +111,70 @@ namespace Pinetime {
        *          |                                       |
        *          |                                       |
        *          |                                       |
+       * 0x380000 +---------------------------------------+
+       *          |  Resource pack                        |
+       *          |  512 KBytes                           |
        * 0x400000 +---------------------------------------+
        *
+       * File systems formatted before the resource pack area was reserved extend up to 0x400000 (legacySize).
+       * They are still mounted as is, and the resource pack is disabled.
        */
       static constexpr size_t startAddress = 0x0B4000;
-      static constexpr size_t size = 0x34C000;
+      static constexpr size_t size = 0x2CC000;
+      static constexpr size_t legacySize = 0x34C000;
       static constexpr size_t blockSize = 4096;
+      static constexpr size_t resourcePackAddress = startAddress + size;
+      static constexpr size_t resourcePackSize = 0x80000;
+
+      struct ProfileConfig {
+        lfs_size_t cacheSize;
+        lfs_size_t lookaheadSize;
+      };
+      static constexpr ProfileConfig GetProfileConfig(Profile profile) {
+        switch (profile) {
+          case Profile::Balanced:
+            return {256, 64};
+          case Profile::Throughput:
+            return {1024, 128};
+          case Profile::Compact:
+          default:
+            return {16, 16};
+        }
+      }
+
+      struct ResourceCheck {
+        bool packed;
+        ResourcePack::Entry entry;
+        bool hasCrc;
+      };
+      // Returns the block count stored in the superblock, or 0 if the flash holds no file system
+      uint32_t ReadFormattedBlockCount();
+      static bool IsResourceFile(const char* path);
+      bool FindInManifest(lfs_file_t* manifest, uint16_t count, const char* path, ResourcePack::IndexEntry& indexEntry);
+      static constexpr size_t verifySliceSize = 2048;
+
+      // Bitmaps indexed by Resources. availableResources is read by DisplayApp.
+      std::atomic<uint32_t> availableResources {0};
+      uint32_t pendingResources = 0;
+      bool resourcesChanged = false;
+      std::array<ResourceCheck, resourcePaths.size()> resourceChecks;
+      uint32_t verifyPosition = 0;
+      uint32_t verifyCrc = 0;
 
-      bool resourcesValid = false;
-      const struct lfs_config lfsConfig;
+      bool legacyLayout = false;
+      struct lfs_config lfsConfig;
 
       lfs_t lfs;
+      FlashReadCache readCache;
+      ResourcePack resourcePack;
 
       static int SectorSync(const struct lfs_config* c);
       static int SectorErase(const struct lfs_config* c, lfs_block_t block);
       static int SectorProg(const struct lfs_config* c, lfs_block_t block, lfs_off_t off, const void* buffer, lfs_size_t size);
       static int SectorRead(const struct lfs_config* c, lfs_block_t block, lfs_off_t off, void* buffer, lfs_size_t size);
+      static int Lock(const struct lfs_config* c);
+      static int Unlock(const struct lfs_config* c);
+      SemaphoreHandle_t lfsMutex = nullptr;
     };
   }
 }
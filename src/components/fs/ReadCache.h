@@ -0,0 +1,114 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace Pinetime {
+  namespace Controllers {
+    // Small write-through LRU cache of flash lines, used between LittleFS and the flash driver.
+    // Programs update the cached copy of the lines they touch, erases invalidate them.
+    template <size_t LineSize, size_t NbLines>
+    class ReadCache {
+      static_assert((LineSize & (LineSize - 1)) == 0, "LineSize must be a power of 2");
+
+    public:
+      static constexpr size_t lineSize = LineSize;
+
+      struct Statistics {
+        uint32_t hits = 0;
+        uint32_t misses = 0;
+      };
+
+      // fetch(address, buffer, size) reads a whole line from the flash on a miss
+      template <typename Fetch>
+      void Read(uint32_t address, uint8_t* buffer, size_t size, Fetch&& fetch) {
+        while (size > 0) {
+          uint32_t lineAddress = address & ~(LineSize - 1);
+          size_t offset = address - lineAddress;
+          size_t toCopy = std::min(size, LineSize - offset);
+
+          Line* line = Find(lineAddress);
+          if (line != nullptr) {
+            statistics.hits++;
+          } else {
+            statistics.misses++;
+            line = Victim();
+            fetch(lineAddress, line->data.data(), LineSize);
+            line->address = lineAddress;
+            line->valid = true;
+          }
+          line->lastUse = ++useCounter;
+          std::memcpy(buffer, line->data.data() + offset, toCopy);
+
+          address += toCopy;
+          buffer += toCopy;
+          size -= toCopy;
+        }
+      }
+
+      void Write(uint32_t address, const uint8_t* data, size_t size) {
+        for (auto& line : lines) {
+          if (!line.valid || !Overlaps(line, address, size)) {
+            continue;
+          }
+          uint32_t start = std::max(address, line.address);
+          uint32_t end = std::min(address + size, line.address + LineSize);
+          std::memcpy(line.data.data() + (start - line.address), data + (start - address), end - start);
+        }
+      }
+
+      void Invalidate(uint32_t address, size_t size) {
+        for (auto& line : lines) {
+          if (line.valid && Overlaps(line, address, size)) {
+            line.valid = false;
+          }
+        }
+      }
+
+      Statistics GetStatistics() const {
+        return statistics;
+      }
+
+    private:
+      struct Line {
+        uint32_t address = 0;
+        uint32_t lastUse = 0;
+        bool valid = false;
+        std::array<uint8_t, LineSize> data;
+      };
+
+      static bool Overlaps(const Line& line, uint32_t address, size_t size) {
+        return address < line.address + LineSize && line.address < address + size;
+      }
+
+      Line* Find(uint32_t lineAddress) {
+        for (auto& line : lines) {
+          if (line.valid && line.address == lineAddress) {
+            return &line;
+          }
+        }
+        return nullptr;
+      }
+
+      Line* Victim() {
+        Line* victim = &lines[0];
+        for (auto& line : lines) {
+          if (!line.valid) {
+            return &line;
+          }
+          if (line.lastUse < victim->lastUse) {
+            victim = &line;
+          }
+        }
+        return victim;
+      }
+
+      std::array<Line, NbLines> lines;
+      uint32_t useCounter = 0;
+      Statistics statistics;
+    };
+  }
+}
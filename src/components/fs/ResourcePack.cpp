@@ -0,0 +1,49 @@
+#include "components/fs/ResourcePack.h"
+#include <algorithm>
+#include <cstring>
+#include <libraries/log/nrf_log.h>
+
+using namespace Pinetime::Controllers;
+
+ResourcePack::ResourcePack(Pinetime::Drivers::SpiNorFlash& flashDriver, uint32_t startAddress, size_t maxSize)
+  : flashDriver {flashDriver}, startAddress {startAddress}, maxSize {maxSize} {
+}
+
+void ResourcePack::Init() {
+  flashDriver.Read(startAddress, reinterpret_cast<uint8_t*>(&header), sizeof(header));
+  valid = header.magic == magic && header.version == version && header.size <= maxSize &&
+          sizeof(Header) + (header.count * sizeof(IndexEntry)) <= header.size;
+  NRF_LOG_INFO("[ResourcePack] valid : %d, %d files", valid, valid ? header.count : 0);
+}
+
+void ResourcePack::Disable() {
+  valid = false;
+}
+
+bool ResourcePack::Find(const char* path, Entry& entry) {
+  if (!valid) {
+    return false;
+  }
+
+  IndexEntry indexEntry;
+  for (uint16_t i = 0; i < header.count; i++) {
+    flashDriver.Read(startAddress + sizeof(Header) + (i * sizeof(IndexEntry)), reinterpret_cast<uint8_t*>(&indexEntry), sizeof(IndexEntry));
+    if (std::strncmp(indexEntry.path, path, maxPathLength) == 0) {
+      if (indexEntry.offset > header.size || indexEntry.size > header.size - indexEntry.offset) {
+        return false;
+      }
+      entry = {indexEntry.offset, indexEntry.size, indexEntry.crc};
+      return true;
+    }
+  }
+  return false;
+}
+
+size_t ResourcePack::Read(const Entry& entry, uint32_t position, uint8_t* buffer, size_t size) {
+  if (position >= entry.size) {
+    return 0;
+  }
+  size_t toRead = std::min<size_t>(size, entry.size - position);
+  flashDriver.StreamRead(startAddress + entry.offset + position, buffer, toRead);
+  return toRead;
+}
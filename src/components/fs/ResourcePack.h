@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "drivers/SpiNorFlash.h"
+
+namespace Pinetime {
+  namespace Controllers {
+    // Read-only container of the fonts and images, generated by src/resources/generate-package.py and
+    // stored in a reserved, contiguous area of the external flash. Files are read directly from the flash,
+    // without going through LittleFS.
+    //
+    // Layout (little endian): Header, Header::count IndexEntry, then the content of the files.
+    class ResourcePack {
+    public:
+      static constexpr uint32_t magic = 0x4B505249; // "IRPK"
+      static constexpr uint16_t version = 1;
+      static constexpr size_t maxPathLength = 32;
+
+      struct __attribute__((packed)) Header {
+        uint32_t magic;
+        uint16_t version;
+        uint16_t count;
+        uint32_t size;
+      };
+
+      struct __attribute__((packed)) IndexEntry {
+        char path[maxPathLength];
+        uint32_t offset;
+        uint32_t size;
+        uint32_t crc;
+      };
+
+      struct Entry {
+        uint32_t offset;
+        uint32_t size;
+        uint32_t crc;
+      };
+
+      ResourcePack(Pinetime::Drivers::SpiNorFlash& flashDriver, uint32_t startAddress, size_t maxSize);
+
+      void Init();
+      void Disable();
+      bool IsValid() const {
+        return valid;
+      }
+
+      bool Find(const char* path, Entry& entry);
+      size_t Read(const Entry& entry, uint32_t position, uint8_t* buffer, size_t size);
+
+    private:
+      Pinetime::Drivers::SpiNorFlash& flashDriver;
+      const uint32_t startAddress;
+      const size_t maxSize;
+
+      bool valid = false;
+      Header header;
+    };
+  }
+}
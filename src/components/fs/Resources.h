@@ -0,0 +1,32 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace Pinetime {
+  namespace Controllers {
+    // External resources used by the firmware, see src/resources/fonts.json and images.json
+    enum class Resources : uint8_t {
+      FontTeko,
+      FontBebas,
+      FontDots40,
+      Font7Segments40,
+      Font7Segments115,
+      ImagePineSmall,
+      ImageNavigation0,
+      ImageNavigation1,
+    };
+
+    static constexpr std::array<const char*, 8> resourcePaths {
+      "/fonts/teko.bin",
+      "/fonts/bebas.bin",
+      "/fonts/lv_font_dots_40.bin",
+      "/fonts/7segments_40.bin",
+      "/fonts/7segments_115.bin",
+      "/images/pine_small.bin",
+      "/images/navigation0.bin",
+      "/images/navigation1.bin",
+    };
+  }
+}
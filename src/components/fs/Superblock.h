@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace Pinetime {
+  namespace Controllers {
+    // Minimal reader of the superblock of a LittleFS v2 file system (see SPEC.md in littlefs).
+    // It only decodes the first commit of a superblock block, where lfs_format() and the compactions
+    // write the superblock entry.
+    class Superblock {
+    public:
+      // Number of bytes to read at the start of each of the two superblock blocks
+      static constexpr size_t readSize = 128;
+
+      // Returns true and fills revision and blockCount if data starts with a superblock
+      static bool Parse(const uint8_t* data, size_t size, uint32_t& revision, uint32_t& blockCount) {
+        if (size < sizeof(uint32_t)) {
+          return false;
+        }
+        revision = LoadLittleEndian(data);
+
+        bool hasName = false;
+        uint32_t previous = 0xffffffff;
+        size_t offset = sizeof(uint32_t);
+        while (offset + sizeof(uint32_t) <= size) {
+          // Tags are big endian and xored with the previous one
+          uint32_t tag = LoadBigEndian(data + offset) ^ previous;
+          previous = tag;
+          offset += sizeof(uint32_t);
+          if ((tag & 0x80000000u) != 0) {
+            return false;
+          }
+
+          const uint16_t type = (tag >> 20) & 0x7ffu;
+          const uint16_t id = (tag >> 10) & 0x3ffu;
+          const uint16_t length = tag & 0x3ffu;
+          if ((type & 0x700u) == typeCrc) {
+            return false;
+          }
+          const size_t dataSize = (length == 0x3ffu) ? 0 : length;
+          if (offset + dataSize > size) {
+            return false;
+          }
+
+          if (id == 0 && type == typeSuperblock && dataSize == sizeof(magic) - 1 && std::memcmp(data + offset, magic, dataSize) == 0) {
+            hasName = true;
+          } else if (id == 0 && type == typeInlineStruct && hasName && dataSize >= 3 * sizeof(uint32_t)) {
+            // version, block_size, block_count, ...
+            blockCount = LoadLittleEndian(data + offset + 2 * sizeof(uint32_t));
+            return true;
+          }
+          offset += dataSize;
+        }
+        return false;
+      }
+
+    private:
+      static constexpr uint16_t typeSuperblock = 0x0ff;
+      static constexpr uint16_t typeInlineStruct = 0x201;
+      static constexpr uint16_t typeCrc = 0x500;
+      static constexpr char magic[] = "littlefs";
+
+      static uint32_t LoadLittleEndian(const uint8_t* data) {
+        return data[0] | (data[1] << 8) | (data[2] << 16) | (static_cast<uint32_t>(data[3]) << 24);
+      }
+
+      static uint32_t LoadBigEndian(const uint8_t* data) {
+        return (static_cast<uint32_t>(data[0]) << 24) | (data[1] << 16) | (data[2] << 8) | data[3];
+      }
+    };
+  }
+}
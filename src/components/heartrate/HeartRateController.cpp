@@ -5,16 +5,22 @@
 using namespace Pinetime::Controllers;
 
 void HeartRateController::Update(HeartRateController::States newState, uint8_t heartRate) {
+  bool updated = this->state != newState;
   this->state = newState;
   if (this->heartRate != heartRate) {
     this->heartRate = heartRate;
     service->OnNewHeartRateValue(heartRate);
+    updated = true;
+  }
+  if (updated) {
+    updateBus.Publish(UpdateBus::Topic::HeartRate);
   }
 }
 
 void HeartRateController::Enable() {
   if (task != nullptr) {
     state = States::NotEnoughData;
+    updateBus.Publish(UpdateBus::Topic::HeartRate);
     task->PushMessage(Pinetime::Applications::HeartRateTask::Messages::Enable);
   }
 }
@@ -22,6 +28,7 @@ void HeartRateController::Enable() {
 void HeartRateController::Disable() {
   if (task != nullptr) {
     state = States::Stopped;
+    updateBus.Publish(UpdateBus::Topic::HeartRate);
     task->PushMessage(Pinetime::Applications::HeartRateTask::Messages::Disable);
   }
 }
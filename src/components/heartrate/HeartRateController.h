@@ -2,6 +2,7 @@
 
 #include <cstdint>
 #include <components/ble/HeartRateService.h>
+#include "components/updatebus/UpdateBus.h"
 
 namespace Pinetime {
   namespace Applications {
@@ -17,7 +18,9 @@ namespace Pinetime {
     public:
       enum class States : uint8_t { Stopped, NotEnoughData, NoTouch, Running };
 
-      HeartRateController() = default;
+      explicit HeartRateController(UpdateBus& updateBus) : updateBus {updateBus} {
+      }
+
       void Enable();
       void Disable();
       void Update(States newState, uint8_t heartRate);
@@ -35,6 +38,7 @@ namespace Pinetime {
       void SetService(Pinetime::Controllers::HeartRateService* service);
 
     private:
+      UpdateBus& updateBus;
       Applications::HeartRateTask* task = nullptr;
       States state = States::Stopped;
       uint8_t heartRate = 0;
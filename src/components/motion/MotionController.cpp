@@ -41,6 +41,7 @@ void MotionController::AdvanceDay() {
   if (service != nullptr) {
     service->OnNewStepCountValue(NbSteps(Days::Today));
   }
+  updateBus.Publish(UpdateBus::Topic::Steps);
 }
 
 void MotionController::Update(int16_t x, int16_t y, int16_t z, uint32_t nbSteps) {
@@ -78,6 +79,9 @@ void MotionController::Update(int16_t x, int16_t y, int16_t z, uint32_t nbSteps)
     currentTripSteps += deltaSteps;
   }
   SetSteps(Days::Today, nbSteps);
+  if (oldSteps != nbSteps) {
+    updateBus.Publish(UpdateBus::Topic::Steps);
+  }
 }
 
 MotionController::AccelStats MotionController::GetAccelStats() const {
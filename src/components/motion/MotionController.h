@@ -7,6 +7,7 @@
 #include "drivers/Bma421.h"
 #include "components/ble/MotionService.h"
 #include "utility/CircularBuffer.h"
+#include "components/updatebus/UpdateBus.h"
 
 namespace Pinetime {
   namespace Controllers {
@@ -25,6 +26,9 @@ namespace Pinetime {
 
       static constexpr size_t stepHistorySize = 2; // Store this many day's step counter
 
+      explicit MotionController(UpdateBus& updateBus) : updateBus {updateBus} {
+      }
+
       void AdvanceDay();
 
       void Update(int16_t x, int16_t y, int16_t z, uint32_t nbSteps);
@@ -112,6 +116,7 @@ namespace Pinetime {
 
       DeviceTypes deviceType = DeviceTypes::Unknown;
       Pinetime::Controllers::MotionService* service = nullptr;
+      UpdateBus& updateBus;
     };
   }
 }
@@ -0,0 +1,33 @@
+#include "components/updatebus/UpdateBus.h"
+#ifdef PINETIME_IS_RECOVERY
+  #include "displayapp/DisplayAppRecovery.h"
+#else
+  #include "displayapp/DisplayApp.h"
+#endif
+
+using namespace Pinetime::Controllers;
+
+void UpdateBus::Register(Applications::DisplayApp* displayApp) {
+  this->displayApp = displayApp;
+}
+
+void UpdateBus::Publish(Topic topic) {
+  Topics mask = Mask(topic);
+  Topics previous = pending.fetch_or(mask);
+  Topics wanted = subscribed.load();
+
+  // DisplayApp is only woken up by the first subscribed topic published since the last Take(),
+  // the following ones are handled by the same refresh
+  if ((mask & wanted) != 0 && (previous & wanted) == 0 && displayApp != nullptr) {
+    displayApp->PushMessage(Applications::Display::Messages::UpdatesPublished);
+  }
+}
+
+void UpdateBus::Subscribe(Topics topics) {
+  subscribed = topics;
+  pending = 0;
+}
+
+UpdateBus::Topics UpdateBus::Take() {
+  return pending.exchange(0) & subscribed.load();
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace Pinetime {
+  namespace Applications {
+    class DisplayApp;
+  }
+
+  namespace Controllers {
+    // Publish/subscribe of the changes of the state of the controllers.
+    // Controllers publish a topic when their state changes, from any task or from an interrupt. DisplayApp subscribes to the
+    // topics displayed by the current screen, and is only woken up when one of them is published. All the topics published
+    // in the meantime are handled by a single refresh of the screen.
+    class UpdateBus {
+    public:
+      enum class Topic : uint8_t {
+        Time,    // The minute changed or the time was set
+        Seconds, // Every second
+        Battery, // Percentage, charging or power present
+        Ble,     // Connection or radio
+        HeartRate,
+        Steps,
+        Notifications,
+      };
+
+      using Topics = uint32_t;
+
+      template <typename... T>
+      static constexpr Topics Mask(T... topics) {
+        return ((Topics {1} << static_cast<uint8_t>(topics)) | ... | Topics {0});
+      }
+
+      void Register(Applications::DisplayApp* displayApp);
+
+      void Publish(Topic topic);
+
+      // Replaces the topics DisplayApp is woken up for, and drops the ones published until now
+      void Subscribe(Topics topics);
+      // Returns the subscribed topics published since the last call
+      Topics Take();
+
+    private:
+      Applications::DisplayApp* displayApp = nullptr;
+      std::atomic<Topics> subscribed {0};
+      std::atomic<Topics> pending {0};
+    };
+  }
+}
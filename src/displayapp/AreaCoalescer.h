@@ -0,0 +1,61 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+namespace Pinetime {
+  namespace Components {
+    // Merges the areas invalidated during a frame when sending a bigger area to the display costs less than sending them separately.
+    // Each flush sends the column, row and write commands and their arguments in separate SPI transactions, which take about as
+    // long as sending flushOverhead bytes of pixels. Areas are any type with x1, y1, x2 and y2 members (inclusive, like lv_area_t).
+    namespace AreaCoalescer {
+      static constexpr uint32_t flushOverhead = 100;
+      static constexpr uint32_t bytesPerPixel = 2;
+
+      // Estimated cost, in bytes, of an area rendered in bands of at most bufferPixels pixels
+      template <typename Area>
+      constexpr uint32_t Cost(const Area& area, uint32_t bufferPixels) {
+        uint32_t width = (area.x2 - area.x1) + 1;
+        uint32_t height = (area.y2 - area.y1) + 1;
+        uint32_t linesPerFlush = std::max<uint32_t>(1, std::min(height, bufferPixels / width));
+        uint32_t flushes = (height + linesPerFlush - 1) / linesPerFlush;
+        return (flushes * flushOverhead) + (width * height * bytesPerPixel);
+      }
+
+      template <typename Area>
+      constexpr Area Join(const Area& a, const Area& b) {
+        Area joined = a;
+        joined.x1 = std::min(a.x1, b.x1);
+        joined.y1 = std::min(a.y1, b.y1);
+        joined.x2 = std::max(a.x2, b.x2);
+        joined.y2 = std::max(a.y2, b.y2);
+        return joined;
+      }
+
+      // Greedily merges pairs of areas as long as it lowers the total cost. Returns the new number of areas.
+      template <typename Area>
+      size_t Coalesce(Area* areas, size_t count, uint32_t bufferPixels) {
+        bool merged = true;
+        while (merged) {
+          merged = false;
+          for (size_t i = 0; i < count; i++) {
+            size_t j = i + 1;
+            while (j < count) {
+              Area joined = Join(areas[i], areas[j]);
+              if (Cost(joined, bufferPixels) <= Cost(areas[i], bufferPixels) + Cost(areas[j], bufferPixels)) {
+                areas[i] = joined;
+                areas[j] = areas[count - 1];
+                count--;
+                merged = true;
+              } else {
+                j++;
+              }
+            }
+          }
+        }
+        return count;
+      }
+    }
+  }
+}
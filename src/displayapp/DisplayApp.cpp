@@ -91,7 +91,8 @@ DisplayApp::DisplayApp(Drivers::St7789& lcd,
                        Pinetime::Controllers::BrightnessController& brightnessController,
                        Pinetime::Controllers::TouchHandler& touchHandler,
                        Pinetime::Controllers::FS& filesystem,
-                       Pinetime::Drivers::SpiNorFlash& spiNorFlash)
+                       Pinetime::Drivers::SpiNorFlash& spiNorFlash,
+                       Pinetime::Controllers::UpdateBus& updateBus)
   : lcd {lcd},
     touchPanel {touchPanel},
     batteryController {batteryController},
@@ -109,7 +110,9 @@ DisplayApp::DisplayApp(Drivers::St7789& lcd,
     touchHandler {touchHandler},
     filesystem {filesystem},
     spiNorFlash {spiNorFlash},
+    updateBus {updateBus},
     lvgl {lcd, filesystem},
+    fontCache {filesystem},
     timer(this, TimerCallback),
     controllers {batteryController,
                  bleController,
@@ -128,6 +131,7 @@ DisplayApp::DisplayApp(Drivers::St7789& lcd,
                  nullptr,
                  this,
                  lvgl,
+                 fontCache,
                  nullptr,
                  nullptr} {
 }
@@ -136,6 +140,7 @@ void DisplayApp::Start(System::BootErrors error) {
   msgQueue = xQueueCreate(queueSize, itemSize);
 
   bootError = error;
+  updateBus.Register(this);
 
   if (pdPASS != xTaskCreate(DisplayApp::Process, "displayapp", 800, this, 0, &taskHandle)) {
     APP_ERROR_HANDLER(NRF_ERROR_NO_MEM);
@@ -166,6 +171,37 @@ void DisplayApp::Init() {
   lvgl.Init();
 }
 
+uint32_t DisplayApp::MsSinceWakeUp() const {
+  return ((xTaskGetTickCount() - systemTask->GetWakeUpTick()) * 1000) / configTICK_RATE_HZ;
+}
+
+void DisplayApp::CountWakeUp() {
+  wakeUpCount++;
+  TickType_t elapsed = xTaskGetTickCount() - updateRatesStart;
+  if (elapsed >= configTICK_RATE_HZ) {
+    uint32_t refreshCount = Screens::Screen::RefreshCount();
+    // Only the watch face is measured, it is the screen displayed most of the time
+    if (currentApp == Apps::Clock && state == States::Running) {
+      uint32_t seconds = elapsed / configTICK_RATE_HZ;
+      updateRates.wakeUps = wakeUpCount / seconds;
+      updateRates.screenRefreshes = (refreshCount - updateRatesRefreshCount) / seconds;
+    }
+    wakeUpCount = 0;
+    updateRatesRefreshCount = refreshCount;
+    updateRatesStart += elapsed;
+  }
+}
+
+void DisplayApp::UpdateRefreshRate() {
+  static_assert(RefreshGovernor::levels[0].period == LV_DISP_DEF_REFR_PERIOD);
+  if (refreshGovernor.Update(xTaskGetTickCount(), touchHandler.IsTouching() || lv_anim_count_running() > 0 || lvgl.IsScrolling())) {
+    lvgl.SetRefreshPeriod(refreshGovernor.Period());
+  }
+
+  // Changes made by a refresh of the screen or by an event are drawn without waiting for the end of the period
+  lvgl.RefreshIfInvalidated();
+}
+
 TickType_t DisplayApp::CalculateSleepTime() {
   // Calculates how many system ticks DisplayApp should sleep before rendering the next AOD frame
   // Next frame time is frame count * refresh period (ms) * tick rate
@@ -203,6 +239,9 @@ TickType_t DisplayApp::CalculateSleepTime() {
 }
 
 void DisplayApp::Refresh() {
+  CountWakeUp();
+  fontCache.Trim();
+
   auto LoadPreviousScreen = [this]() {
     FullRefreshDirections returnDirection;
     switch (appStackDirections.Pop()) {
@@ -250,7 +289,11 @@ void DisplayApp::Refresh() {
         // Only advance the tick count when LVGL is done
         // Otherwise keep running the task handler while it still has things to draw
         // Note: under high graphics load, LVGL will always have more work to do
-        if (lv_task_handler() > 0) {
+        frameStatistics.OnRenderStart(lvgl);
+        bool pending = lv_task_handler() > 0;
+        frameStatistics.OnRenderEnd(lvgl);
+        lvgl.UpdatePartialArea();
+        if (pending) {
           // Drop frames that we've missed if drawing/event handling took way longer than expected
           while (queueTimeout == 0) {
             alwaysOnFrameCount += 1;
@@ -263,7 +306,18 @@ void DisplayApp::Refresh() {
       if (!currentScreen->IsRunning()) {
         LoadPreviousScreen();
       }
+      UpdateRefreshRate();
+      frameStatistics.OnRenderStart(lvgl);
       queueTimeout = lv_task_handler();
+      frameStatistics.OnRenderEnd(lvgl);
+
+      if (waitingFirstFrame && lvgl.GetFlushCount() != wakeUpFlushCount) {
+        waitingFirstFrame = false;
+        wakeUpLatency.firstFrame = MsSinceWakeUp();
+        NRF_LOG_INFO("[DisplayApp] Wake-up latency : backlight %lu ms, first frame %lu ms",
+                     wakeUpLatency.backlightOn,
+                     wakeUpLatency.firstFrame);
+      }
 
       if (!systemTask->IsSleepDisabled() && IsPastDimTime()) {
         if (!isDimmed) {
@@ -327,12 +381,14 @@ void DisplayApp::Refresh() {
           while (!lv_task_handler()) {
           };
         }
+        frameStatistics.Dump(filesystem);
         // Clear any ongoing touch pressed events
         // Without this LVGL gets stuck in the pressed state and will keep refreshing the
         // display activity timer causing the screen to never sleep after timeout
         lvgl.ClearTouchState();
         if (msg == Messages::GoToAOD) {
           lcd.LowPowerOn();
+          lvgl.SetLowPowerMode(true);
           // Record idle entry time
           alwaysOnFrameCount = 0;
           alwaysOnStartTime = xTaskGetTickCount();
@@ -342,6 +398,8 @@ void DisplayApp::Refresh() {
           lcd.Sleep();
           PushMessageToSystemTask(Pinetime::System::Messages::OnDisplayTaskSleeping);
           state = States::Idle;
+          // Nothing is drawn until the display wakes up
+          updateBus.Subscribe(0);
         }
         break;
       case Messages::NotifyDeviceActivity:
@@ -356,12 +414,23 @@ void DisplayApp::Refresh() {
         }
         if (state == States::AOD) {
           lcd.LowPowerOff();
+          lvgl.SetLowPowerMode(false);
         } else {
           lcd.Wakeup();
+          // Catch up with the updates published while sleeping
+          updateBus.Subscribe(currentScreen->Subscriptions());
+          currentScreen->OnUpdate();
         }
         lv_disp_trig_activity(nullptr);
         ApplyBrightness();
         state = States::Running;
+        // Start at full rate to draw the first frame as soon as possible
+        refreshGovernor.Restart(xTaskGetTickCount());
+
+        wakeUpLatency.backlightOn = MsSinceWakeUp();
+        wakeUpLatency.firstFrame = 0;
+        wakeUpFlushCount = lvgl.GetFlushCount();
+        waitingFirstFrame = true;
         break;
       case Messages::UpdateBleConnection:
         // Only used for recovery firmware
@@ -485,9 +554,16 @@ void DisplayApp::Refresh() {
         LoadNewScreen(Apps::Clock, DisplayApp::FullRefreshDirections::None);
         motorController.RunForDuration(35);
         break;
+      case Messages::UpdatesPublished:
+        // Handled below, as the topics can also be published while handling other messages
+        break;
     }
   }
 
+  if (updateBus.Take() != 0) {
+    currentScreen->OnUpdate();
+  }
+
   if (state == States::Running && touchHandler.IsTouching()) {
     currentScreen->OnTouchEvent(touchHandler.GetX(), touchHandler.GetY());
   }
@@ -520,6 +596,8 @@ void DisplayApp::LoadScreen(Apps app, DisplayApp::FullRefreshDirections directio
   motorController.StopRinging();
 
   currentScreen.reset(nullptr);
+  // The fonts of the previous screen are idle now, the new screen might need their memory
+  fontCache.Trim();
   SetFullRefresh(direction);
 
   switch (app) {
@@ -569,6 +647,7 @@ void DisplayApp::LoadScreen(Apps app, DisplayApp::FullRefreshDirections directio
                                                                systemTask->nimble().alertService(),
                                                                motorController,
                                                                *systemTask,
+                                                               lvgl,
                                                                Screens::Notifications::Modes::Normal);
       break;
     case Apps::NotificationsPreview:
@@ -577,6 +656,7 @@ void DisplayApp::LoadScreen(Apps app, DisplayApp::FullRefreshDirections directio
                                                                systemTask->nimble().alertService(),
                                                                motorController,
                                                                *systemTask,
+                                                               lvgl,
                                                                Screens::Notifications::Modes::Preview);
       break;
     case Apps::QuickSettings:
@@ -646,7 +726,9 @@ void DisplayApp::LoadScreen(Apps app, DisplayApp::FullRefreshDirections directio
                                                             watchdog,
                                                             motionController,
                                                             touchPanel,
-                                                            spiNorFlash);
+                                                            spiNorFlash,
+                                                            filesystem,
+                                                            fontCache);
       break;
     case Apps::FlashLight:
       currentScreen = std::make_unique<Screens::FlashLight>(*systemTask, brightnessController);
@@ -664,6 +746,7 @@ void DisplayApp::LoadScreen(Apps app, DisplayApp::FullRefreshDirections directio
     }
   }
   currentApp = app;
+  updateBus.Subscribe(state == States::Idle ? 0 : currentScreen->Subscriptions());
 }
 
 void DisplayApp::PushMessage(Messages msg) {
@@ -676,7 +759,8 @@ void DisplayApp::PushMessage(Messages msg) {
     // Make xQueueSend() non-blocking if the message is a Notification message. We do this to avoid
     // deadlock between SystemTask and DisplayApp when their respective message queues are getting full
     // when a lot of notifications are received on a very short time span.
-    if (msg == Messages::NewNotification) {
+    // UpdatesPublished can be sent by DisplayApp itself, and a lost one is recovered at the next wake-up.
+    if (msg == Messages::NewNotification || msg == Messages::UpdatesPublished) {
       timeout = static_cast<TickType_t>(0);
     }
 
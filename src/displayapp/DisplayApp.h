@@ -6,6 +6,9 @@
 #include <systemtask/Messages.h>
 #include "displayapp/apps/Apps.h"
 #include "displayapp/LittleVgl.h"
+#include "displayapp/FontCache.h"
+#include "displayapp/FrameStatistics.h"
+#include "displayapp/RefreshGovernor.h"
 #include "displayapp/TouchEvents.h"
 #include "components/brightness/BrightnessController.h"
 #include "components/motor/MotorController.h"
@@ -15,6 +18,7 @@
 #include "components/timer/Timer.h"
 #include "components/stopwatch/StopWatchController.h"
 #include "components/alarm/AlarmController.h"
+#include "components/updatebus/UpdateBus.h"
 #include "touchhandler/TouchHandler.h"
 
 #include "displayapp/Messages.h"
@@ -53,6 +57,22 @@ namespace Pinetime {
       enum class States { Idle, Running, AOD };
       enum class FullRefreshDirections { None, Up, Down, Left, Right, LeftAnim, RightAnim };
 
+      // Time from the wake-up request (button interrupt, touch, notification...) in ms
+      struct WakeUpLatency {
+        // The panel and the backlight are on, showing the last frame kept in the memory of the panel
+        uint32_t backlightOn = 0;
+        // LVGL sent the first updated frame
+        uint32_t firstFrame = 0;
+      };
+
+      // Per second, measured over the last second spent awake on the watch face
+      struct UpdateRates {
+        // Iterations of the loop of the display task
+        uint32_t wakeUps = 0;
+        // Refreshes of the current screen, from its refresh task or from the UpdateBus
+        uint32_t screenRefreshes = 0;
+      };
+
       DisplayApp(Drivers::St7789& lcd,
                  const Drivers::Cst816S&,
                  const Controllers::Battery& batteryController,
@@ -69,7 +89,8 @@ namespace Pinetime {
                  Pinetime::Controllers::BrightnessController& brightnessController,
                  Pinetime::Controllers::TouchHandler& touchHandler,
                  Pinetime::Controllers::FS& filesystem,
-                 Pinetime::Drivers::SpiNorFlash& spiNorFlash);
+                 Pinetime::Drivers::SpiNorFlash& spiNorFlash,
+                 Pinetime::Controllers::UpdateBus& updateBus);
       void Start(System::BootErrors error);
       void PushMessage(Display::Messages msg);
 
@@ -82,6 +103,22 @@ namespace Pinetime {
       void Register(Pinetime::Controllers::MusicService* musicService);
       void Register(Pinetime::Controllers::NavigationService* NavigationService);
 
+      WakeUpLatency GetWakeUpLatency() const {
+        return wakeUpLatency;
+      }
+
+      UpdateRates GetUpdateRates() const {
+        return updateRates;
+      }
+
+      Pinetime::Components::LittleVgl::FlushStatistics GetFlushStatistics() const {
+        return lvgl.GetFlushStatistics();
+      }
+
+      const FrameStatistics& GetFrameStatistics() const {
+        return frameStatistics;
+      }
+
     private:
       Pinetime::Drivers::St7789& lcd;
       const Pinetime::Drivers::Cst816S& touchPanel;
@@ -101,9 +138,11 @@ namespace Pinetime {
       Pinetime::Controllers::TouchHandler& touchHandler;
       Pinetime::Controllers::FS& filesystem;
       Pinetime::Drivers::SpiNorFlash& spiNorFlash;
+      Pinetime::Controllers::UpdateBus& updateBus;
 
       Pinetime::Controllers::FirmwareValidator validator;
       Pinetime::Components::LittleVgl lvgl;
+      Pinetime::Components::FontCache fontCache;
       Pinetime::Controllers::Timer timer;
 
       AppControllers controllers;
@@ -141,6 +180,21 @@ namespace Pinetime {
 
       bool isDimmed = false;
 
+      WakeUpLatency wakeUpLatency;
+      FrameStatistics frameStatistics;
+      bool waitingFirstFrame = false;
+      uint32_t wakeUpFlushCount = 0;
+      uint32_t MsSinceWakeUp() const;
+
+      UpdateRates updateRates;
+      uint32_t wakeUpCount = 0;
+      uint32_t updateRatesRefreshCount = 0;
+      TickType_t updateRatesStart = 0;
+      void CountWakeUp();
+
+      RefreshGovernor refreshGovernor;
+      void UpdateRefreshRate();
+
       TickType_t CalculateSleepTime();
       TickType_t alwaysOnFrameCount;
       TickType_t alwaysOnStartTime;
@@ -0,0 +1,130 @@
+#include "displayapp/FontCache.h"
+#include <cstdio>
+#include <FreeRTOS.h>
+#include <libraries/log/nrf_log.h>
+#include "components/fs/FS.h"
+#include "displayapp/LvglMemory.h"
+
+using namespace Pinetime::Components;
+
+FontCache::FontCache(Pinetime::Controllers::FS& filesystem) : filesystem {filesystem} {
+}
+
+lv_font_t* FontCache::Acquire(Pinetime::Controllers::Resources resource) {
+  for (auto& entry : entries) {
+    if (entry.font != nullptr && entry.resource == resource) {
+      statistics.hits++;
+      entry.references++;
+      entry.lastUse = ++useCounter;
+      return entry.font;
+    }
+  }
+
+  if (!filesystem.IsResourceAvailable(resource)) {
+    return nullptr;
+  }
+
+  statistics.misses++;
+  Entry* entry = Victim();
+  if (entry == nullptr) {
+    // All the entries are in use, the font is loaded but not cached
+    return Load(resource);
+  }
+  if (entry->font != nullptr) {
+    Evict(*entry);
+  }
+
+  // The memory used by the font is not known by LVGL, it is measured from the memory used by LVGL before and after loading it
+  size_t usedBefore = LvglMemory::UsedSize();
+  lv_font_t* font = Load(resource);
+  if (font == nullptr) {
+    return nullptr;
+  }
+  size_t usedAfter = LvglMemory::UsedSize();
+
+  entry->font = font;
+  entry->resource = resource;
+  entry->references = 1;
+  entry->lastUse = ++useCounter;
+  entry->size = usedAfter > usedBefore ? usedAfter - usedBefore : 0;
+  NRF_LOG_INFO("[FontCache] Loaded font %d (%d bytes)", static_cast<uint8_t>(resource), entry->size);
+  return font;
+}
+
+// LVGL picks the file system driver from the drive letter. The 'R' driver looks the file up in the resource pack,
+// then in LittleFS.
+lv_font_t* FontCache::Load(Pinetime::Controllers::Resources resource) {
+  char path[sizeof("R:") + Pinetime::Controllers::ResourcePack::maxPathLength];
+  snprintf(path, sizeof(path), "R:%s", Pinetime::Controllers::resourcePaths[static_cast<uint8_t>(resource)]);
+  return lv_font_load(path);
+}
+
+void FontCache::Release(lv_font_t* font) {
+  if (font == nullptr) {
+    return;
+  }
+
+  for (auto& entry : entries) {
+    if (entry.font == font) {
+      if (entry.references > 0) {
+        entry.references--;
+      }
+      Trim();
+      return;
+    }
+  }
+
+  // Font that was not cached
+  lv_font_free(font);
+}
+
+size_t FontCache::CachedSize() const {
+  size_t size = 0;
+  for (const auto& entry : entries) {
+    if (entry.font != nullptr) {
+      size += entry.size;
+    }
+  }
+  return size;
+}
+
+void FontCache::Trim() {
+  while (true) {
+    size_t idleSize = 0;
+    Entry* oldest = nullptr;
+    for (auto& entry : entries) {
+      if (entry.font == nullptr || entry.references > 0) {
+        continue;
+      }
+      idleSize += entry.size;
+      if (oldest == nullptr || entry.lastUse < oldest->lastUse) {
+        oldest = &entry;
+      }
+    }
+
+    if (oldest == nullptr || (idleSize <= maxIdleSize && xPortGetLargestFreeBlockSize() >= minLargestFreeBlock)) {
+      return;
+    }
+    Evict(*oldest);
+  }
+}
+
+FontCache::Entry* FontCache::Victim() {
+  Entry* victim = nullptr;
+  for (auto& entry : entries) {
+    if (entry.font == nullptr) {
+      return &entry;
+    }
+    if (entry.references == 0 && (victim == nullptr || entry.lastUse < victim->lastUse)) {
+      victim = &entry;
+    }
+  }
+  return victim;
+}
+
+void FontCache::Evict(Entry& entry) {
+  lv_font_free(entry.font);
+  entry.font = nullptr;
+  entry.size = 0;
+  statistics.evictions++;
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <lvgl/lvgl.h>
+#include "components/fs/Resources.h"
+
+namespace Pinetime {
+  namespace Controllers {
+    class FS;
+  }
+
+  namespace Components {
+    // Keeps the fonts loaded from the external flash (lv_font_load()) in RAM after the screen that used them is closed,
+    // so that going back to a watch face doesn't load and parse its fonts again.
+    // Fonts that are not used anymore are freed in LRU order when they exceed maxIdleSize or when the largest free block of
+    // the heap is smaller than minLargestFreeBlock, by Release() and by Trim().
+    class FontCache {
+    public:
+      struct Statistics {
+        uint32_t hits = 0;
+        uint32_t misses = 0;
+        uint32_t evictions = 0;
+      };
+
+      explicit FontCache(Pinetime::Controllers::FS& filesystem);
+
+      // Returns nullptr if the font is not available
+      lv_font_t* Acquire(Pinetime::Controllers::Resources resource);
+      void Release(lv_font_t* font);
+      // Called by DisplayApp when a screen is loaded and on every wake-up of its task, so that the idle fonts are freed
+      // when other screens or tasks (BLE) need the heap
+      void Trim();
+
+      Statistics GetStatistics() const {
+        return statistics;
+      }
+
+      size_t CachedSize() const;
+
+    private:
+      static constexpr size_t nbEntries = 4;
+      static constexpr size_t maxIdleSize = 8 * 1024;
+      static constexpr size_t minLargestFreeBlock = 4 * 1024;
+
+      struct Entry {
+        lv_font_t* font = nullptr;
+        Pinetime::Controllers::Resources resource;
+        uint8_t references = 0;
+        uint32_t lastUse = 0;
+        size_t size = 0;
+      };
+
+      static lv_font_t* Load(Pinetime::Controllers::Resources resource);
+      Entry* Victim();
+      void Evict(Entry& entry);
+
+      Pinetime::Controllers::FS& filesystem;
+      std::array<Entry, nbEntries> entries;
+      uint32_t useCounter = 0;
+      Statistics statistics;
+    };
+  }
+}
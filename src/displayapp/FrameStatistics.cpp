@@ -0,0 +1,108 @@
+#include "displayapp/FrameStatistics.h"
+#ifdef DEBUG
+  #include <algorithm>
+  #include <cstdio>
+  #include <limits>
+  #include <task.h>
+  #include "components/fs/FS.h"
+  #include "displayapp/LittleVgl.h"
+
+using namespace Pinetime::Applications;
+
+void FrameStatistics::Histogram::Add(uint32_t value) {
+  uint8_t bucket = 0;
+  while (value != 0 && bucket < nbBuckets - 1) {
+    value >>= 1;
+    bucket++;
+  }
+
+  if (counts[bucket] == std::numeric_limits<uint16_t>::max()) {
+    for (auto& count : counts) {
+      count /= 2;
+    }
+  }
+  counts[bucket]++;
+}
+
+uint32_t FrameStatistics::Histogram::Total() const {
+  uint32_t total = 0;
+  for (auto count : counts) {
+    total += count;
+  }
+  return total;
+}
+
+uint32_t FrameStatistics::Histogram::Percentile(uint8_t percent) const {
+  uint32_t threshold = (Total() * percent + 99) / 100;
+  uint32_t cumulated = 0;
+  for (uint8_t bucket = 0; bucket < nbBuckets; bucket++) {
+    cumulated += counts[bucket];
+    if (cumulated >= threshold && cumulated > 0) {
+      return 1U << bucket;
+    }
+  }
+  return 0;
+}
+
+void FrameStatistics::OnRenderStart(const Components::LittleVgl& lvgl) {
+  renderStart = xTaskGetTickCount();
+  flushCountStart = lvgl.GetFlushCount();
+  flushedBytesStart = lvgl.GetFlushedBytes();
+  flushWaitStart = lvgl.GetFlushWaitTicks();
+}
+
+void FrameStatistics::OnRenderEnd(const Components::LittleVgl& lvgl) {
+  TickType_t now = xTaskGetTickCount();
+  if (lvgl.GetFlushCount() != flushCountStart) {
+    // The time spent waiting for the display is not rendering time
+    TickType_t flushWait = lvgl.GetFlushWaitTicks() - flushWaitStart;
+    TickType_t render = now - renderStart;
+    histograms.renderMs.Add(TicksToMs(render - std::min(render, flushWait)));
+    histograms.flushWaitMs.Add(TicksToMs(flushWait));
+    histograms.kiloBytes.Add((lvgl.GetFlushedBytes() - flushedBytesStart) / 1024);
+    frameCount++;
+    framesInSecond++;
+  }
+
+  if (now - secondStart >= configTICK_RATE_HZ) {
+    histograms.framesPerSecond.Add(framesInSecond);
+    framesInSecond = 0;
+    secondStart = now;
+  }
+}
+
+void FrameStatistics::Dump(Controllers::FS& filesystem) const {
+  lfs_file_t file;
+  if (filesystem.FileOpen(&file, "/frame_statistics.txt", LFS_O_WRONLY | LFS_O_CREAT | LFS_O_TRUNC) != LFS_ERR_OK) {
+    return;
+  }
+
+  auto writeHistogram = [&filesystem, &file](const char* name, const Histogram& histogram) {
+    char line[80];
+    const auto& counts = histogram.Counts();
+    int length = snprintf(line,
+                          sizeof(line),
+                          "%s %u %u %u %u %u %u %u %u\n",
+                          name,
+                          counts[0],
+                          counts[1],
+                          counts[2],
+                          counts[3],
+                          counts[4],
+                          counts[5],
+                          counts[6],
+                          counts[7]);
+    filesystem.FileWrite(&file, reinterpret_cast<const uint8_t*>(line), std::min<size_t>(length, sizeof(line) - 1));
+  };
+
+  static_assert(Histogram::nbBuckets == 8);
+  char header[64];
+  int length = snprintf(header, sizeof(header), "frames %lu\nbuckets 0 1 2 4 8 16 32 64+\n", frameCount);
+  filesystem.FileWrite(&file, reinterpret_cast<const uint8_t*>(header), std::min<size_t>(length, sizeof(header) - 1));
+  writeHistogram("render_ms", histograms.renderMs);
+  writeHistogram("flush_wait_ms", histograms.flushWaitMs);
+  writeHistogram("frame_kb", histograms.kiloBytes);
+  writeHistogram("fps", histograms.framesPerSecond);
+  filesystem.FileClose(&file);
+}
+#endif
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <FreeRTOS.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace Pinetime {
+  namespace Components {
+    class LittleVgl;
+  }
+
+  namespace Controllers {
+    class FS;
+  }
+
+  namespace Applications {
+    // Rolling histograms of the time spent rendering the frames, the time spent waiting for the SPI transfers, the size of
+    // the frames and the frame rate. Only collected in debug builds, the calls compile to nothing in release builds.
+    class FrameStatistics {
+    public:
+#ifdef DEBUG
+      static constexpr bool enabled = true;
+#else
+      static constexpr bool enabled = false;
+#endif
+
+      // Bucket 0 counts the values equal to 0, bucket n the values in [2^(n-1), 2^n) and the last one everything above.
+      // The counts are halved when one of them saturates, so that the histogram follows the recent frames.
+      class Histogram {
+      public:
+        static constexpr uint8_t nbBuckets = 8;
+
+        void Add(uint32_t value);
+        uint32_t Total() const;
+        // Upper bound (exclusive) of the bucket that contains the given percentile of the values
+        uint32_t Percentile(uint8_t percent) const;
+
+        const std::array<uint16_t, nbBuckets>& Counts() const {
+          return counts;
+        }
+
+      private:
+        std::array<uint16_t, nbBuckets> counts {};
+      };
+
+      struct Histograms {
+        Histogram renderMs;
+        Histogram flushWaitMs;
+        Histogram kiloBytes;
+        Histogram framesPerSecond;
+      };
+
+#ifdef DEBUG
+      void OnRenderStart(const Components::LittleVgl& lvgl);
+      void OnRenderEnd(const Components::LittleVgl& lvgl);
+      // Writes the histograms to a text file, which can be read over BLE with the filesystem service
+      void Dump(Controllers::FS& filesystem) const;
+
+      const Histograms& Get() const {
+        return histograms;
+      }
+
+      uint32_t FrameCount() const {
+        return frameCount;
+      }
+
+    private:
+      static uint32_t TicksToMs(TickType_t ticks) {
+        return (ticks * 1000) / configTICK_RATE_HZ;
+      }
+
+      Histograms histograms;
+      uint32_t frameCount = 0;
+      TickType_t renderStart = 0;
+      uint32_t flushCountStart = 0;
+      uint32_t flushedBytesStart = 0;
+      TickType_t flushWaitStart = 0;
+      TickType_t secondStart = 0;
+      uint32_t framesInSecond = 0;
+#else
+      void OnRenderStart(const Components::LittleVgl& /*lvgl*/) {
+      }
+
+      void OnRenderEnd(const Components::LittleVgl& /*lvgl*/) {
+      }
+
+      void Dump(Controllers::FS& /*filesystem*/) const {
+      }
+#endif
+    };
+  }
+}
@@ -6,6 +6,12 @@
 #include "drivers/St7789.h"
 #include "littlefs/lfs.h"
 #include "components/fs/FS.h"
+#include "displayapp/AreaCoalescer.h"
+#include "displayapp/PixelBlend.h"
+#include "displayapp/ReadAhead.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
 
 using namespace Pinetime::Components;
 
@@ -15,14 +21,22 @@ namespace {
     lv_theme_set_act(theme);
   }
 
+  struct LvglFile {
+    lfs_file_t file;
+    uint32_t filePosition; // Position of the LittleFS file, which may differ from the one seen by LVGL
+    ReadAhead readAhead;
+  };
+
   lv_fs_res_t lvglOpen(lv_fs_drv_t* drv, void* file_p, const char* path, lv_fs_mode_t /*mode*/) {
-    lfs_file_t* file = static_cast<lfs_file_t*>(file_p);
+    LvglFile* lvglFile = static_cast<LvglFile*>(file_p);
     Pinetime::Controllers::FS* filesys = static_cast<Pinetime::Controllers::FS*>(drv->user_data);
-    int res = filesys->FileOpen(file, path, LFS_O_RDONLY);
+    int res = filesys->FileOpen(&lvglFile->file, path, LFS_O_RDONLY);
     if (res == 0) {
-      if (file->type == 0) {
+      if (lvglFile->file.type == 0) {
         return LV_FS_RES_FS_ERR;
       } else {
+        lvglFile->filePosition = 0;
+        lvglFile->readAhead.Reset();
         return LV_FS_RES_OK;
       }
     }
@@ -31,26 +45,116 @@ namespace {
 
   lv_fs_res_t lvglClose(lv_fs_drv_t* drv, void* file_p) {
     Pinetime::Controllers::FS* filesys = static_cast<Pinetime::Controllers::FS*>(drv->user_data);
-    lfs_file_t* file = static_cast<lfs_file_t*>(file_p);
-    filesys->FileClose(file);
+    LvglFile* lvglFile = static_cast<LvglFile*>(file_p);
+    filesys->FileClose(&lvglFile->file);
 
     return LV_FS_RES_OK;
   }
 
   lv_fs_res_t lvglRead(lv_fs_drv_t* drv, void* file_p, void* buf, uint32_t btr, uint32_t* br) {
     Pinetime::Controllers::FS* filesys = static_cast<Pinetime::Controllers::FS*>(drv->user_data);
-    lfs_file_t* file = static_cast<lfs_file_t*>(file_p);
-    filesys->FileRead(file, static_cast<uint8_t*>(buf), btr);
-    *br = btr;
+    LvglFile* lvglFile = static_cast<LvglFile*>(file_p);
+    auto fetch = [filesys, lvglFile](uint32_t position, uint8_t* buffer, uint32_t size) {
+      if (position != lvglFile->filePosition) {
+        int res = filesys->FileSeek(&lvglFile->file, position);
+        if (res < 0) {
+          return res;
+        }
+        lvglFile->filePosition = position;
+      }
+      int read = filesys->FileRead(&lvglFile->file, buffer, size);
+      if (read > 0) {
+        lvglFile->filePosition += read;
+      }
+      return read;
+    };
+    return lvglFile->readAhead.Read(static_cast<uint8_t*>(buf), btr, br, fetch) ? LV_FS_RES_OK : LV_FS_RES_FS_ERR;
+  }
+
+  lv_fs_res_t lvglSeek(lv_fs_drv_t* /*drv*/, void* file_p, uint32_t pos) {
+    // The LittleFS file is only moved when the data is not already buffered
+    LvglFile* lvglFile = static_cast<LvglFile*>(file_p);
+    lvglFile->readAhead.position = pos;
+    return LV_FS_RES_OK;
+  }
+
+  lv_fs_res_t lvglTell(lv_fs_drv_t* /*drv*/, void* file_p, uint32_t* pos_p) {
+    LvglFile* lvglFile = static_cast<LvglFile*>(file_p);
+    *pos_p = lvglFile->readAhead.position;
     return LV_FS_RES_OK;
   }
 
-  lv_fs_res_t lvglSeek(lv_fs_drv_t* drv, void* file_p, uint32_t pos) {
+  lv_fs_res_t lvglSize(lv_fs_drv_t* drv, void* file_p, uint32_t* size_p) {
     Pinetime::Controllers::FS* filesys = static_cast<Pinetime::Controllers::FS*>(drv->user_data);
-    lfs_file_t* file = static_cast<lfs_file_t*>(file_p);
-    filesys->FileSeek(file, pos);
+    LvglFile* lvglFile = static_cast<LvglFile*>(file_p);
+    int size = filesys->FileSize(&lvglFile->file);
+    if (size < 0) {
+      return LV_FS_RES_FS_ERR;
+    }
+    *size_p = size;
     return LV_FS_RES_OK;
   }
+
+  // Resources drive: files are read from the resource pack if it contains them, from LittleFS otherwise
+  struct ResourceFile {
+    bool packed;
+    Pinetime::Controllers::ResourcePack::Entry entry;
+    LvglFile lvglFile;
+  };
+
+  lv_fs_res_t resourceOpen(lv_fs_drv_t* drv, void* file_p, const char* path, lv_fs_mode_t mode) {
+    Pinetime::Controllers::FS* filesys = static_cast<Pinetime::Controllers::FS*>(drv->user_data);
+    ResourceFile* resource = static_cast<ResourceFile*>(file_p);
+    resource->packed = filesys->GetResourcePack().Find(path, resource->entry);
+    if (resource->packed) {
+      resource->lvglFile.readAhead.Reset();
+      return LV_FS_RES_OK;
+    }
+    return lvglOpen(drv, &resource->lvglFile, path, mode);
+  }
+
+  lv_fs_res_t resourceClose(lv_fs_drv_t* drv, void* file_p) {
+    ResourceFile* resource = static_cast<ResourceFile*>(file_p);
+    if (resource->packed) {
+      return LV_FS_RES_OK;
+    }
+    return lvglClose(drv, &resource->lvglFile);
+  }
+
+  lv_fs_res_t resourceRead(lv_fs_drv_t* drv, void* file_p, void* buf, uint32_t btr, uint32_t* br) {
+    Pinetime::Controllers::FS* filesys = static_cast<Pinetime::Controllers::FS*>(drv->user_data);
+    ResourceFile* resource = static_cast<ResourceFile*>(file_p);
+    if (resource->packed) {
+      auto fetch = [filesys, resource](uint32_t position, uint8_t* buffer, uint32_t size) {
+        return static_cast<int>(filesys->GetResourcePack().Read(resource->entry, position, buffer, size));
+      };
+      return resource->lvglFile.readAhead.Read(static_cast<uint8_t*>(buf), btr, br, fetch) ? LV_FS_RES_OK : LV_FS_RES_FS_ERR;
+    }
+    return lvglRead(drv, &resource->lvglFile, buf, btr, br);
+  }
+
+  lv_fs_res_t resourceSeek(lv_fs_drv_t* drv, void* file_p, uint32_t pos) {
+    ResourceFile* resource = static_cast<ResourceFile*>(file_p);
+    if (resource->packed) {
+      resource->lvglFile.readAhead.position = std::min(pos, resource->entry.size);
+      return LV_FS_RES_OK;
+    }
+    return lvglSeek(drv, &resource->lvglFile, pos);
+  }
+
+  lv_fs_res_t resourceTell(lv_fs_drv_t* drv, void* file_p, uint32_t* pos_p) {
+    ResourceFile* resource = static_cast<ResourceFile*>(file_p);
+    return lvglTell(drv, &resource->lvglFile, pos_p);
+  }
+
+  lv_fs_res_t resourceSize(lv_fs_drv_t* drv, void* file_p, uint32_t* size_p) {
+    ResourceFile* resource = static_cast<ResourceFile*>(file_p);
+    if (resource->packed) {
+      *size_p = resource->entry.size;
+      return LV_FS_RES_OK;
+    }
+    return lvglSize(drv, &resource->lvglFile, size_p);
+  }
 }
 
 static void disp_flush(lv_disp_drv_t* disp_drv, const lv_area_t* area, lv_color_t* color_p) {
@@ -58,6 +162,39 @@ static void disp_flush(lv_disp_drv_t* disp_drv, const lv_area_t* area, lv_color_
   lvgl->FlushDisplay(area, color_p);
 }
 
+static void refresh(lv_task_t* task) {
+  auto* disp = static_cast<lv_disp_t*>(task->user_data);
+  auto* lvgl = static_cast<LittleVgl*>(disp->driver.user_data);
+  lvgl->CoalesceAreas(disp);
+  _lv_disp_refr_task(task);
+}
+
+static void gpu_fill(lv_disp_drv_t* /*disp_drv*/,
+                     lv_color_t* dest_buf,
+                     lv_coord_t dest_width,
+                     const lv_area_t* fill_area,
+                     lv_color_t color) {
+  const uint16_t width = (fill_area->x2 - fill_area->x1) + 1;
+  lv_color_t* line = dest_buf + (fill_area->y1 * dest_width) + fill_area->x1;
+  for (lv_coord_t y = fill_area->y1; y <= fill_area->y2; y++) {
+    PixelBlend::Fill(&line->full, width, color.full);
+    line += dest_width;
+  }
+}
+
+static void gpu_blend(lv_disp_drv_t* /*disp_drv*/, lv_color_t* dest, const lv_color_t* src, uint32_t length, lv_opa_t opa) {
+  if (opa >= LV_OPA_MAX) {
+    std::memcpy(dest, src, length * sizeof(lv_color_t));
+    return;
+  }
+  PixelBlend::Blend(&dest->full, &src->full, length, opa);
+}
+
+static void disp_wait(lv_disp_drv_t* disp_drv) {
+  auto* lvgl = static_cast<LittleVgl*>(disp_drv->user_data);
+  lvgl->WaitFlush();
+}
+
 static void rounder(lv_disp_drv_t* disp_drv, lv_area_t* area) {
   auto* lvgl = static_cast<LittleVgl*>(disp_drv->user_data);
   if (lvgl->GetFullRefresh()) {
@@ -66,6 +203,11 @@ static void rounder(lv_disp_drv_t* disp_drv, lv_area_t* area) {
     area->y1 = 0;
     area->y2 = LV_VER_RES - 1;
   }
+  if (lvgl->IsLowPowerMode()) {
+    // 12-bit pixels are sent in pairs
+    area->x1 &= ~1;
+    area->x2 |= 1;
+  }
 }
 
 bool touchpad_read(lv_indev_drv_t* indev_drv, lv_indev_data_t* data) {
@@ -85,6 +227,9 @@ void LittleVgl::Init() {
 }
 
 void LittleVgl::InitDisplay() {
+  flushDone = xSemaphoreCreateBinary();
+  ASSERT(flushDone != nullptr);
+
   lv_disp_buf_init(&disp_buf_2, buf2_1, buf2_2, LV_HOR_RES_MAX * 4); /*Initialize the display buffer*/
   lv_disp_drv_init(&disp_drv);                                       /*Basic initialization*/
 
@@ -100,9 +245,24 @@ void LittleVgl::InitDisplay() {
   disp_drv.buffer = &disp_buf_2;
   disp_drv.user_data = this;
   disp_drv.rounder_cb = rounder;
+  /*Block the display task instead of spinning while the previous buffer is still being sent*/
+  disp_drv.wait_cb = disp_wait;
+  /*Fill and blend two pixels at a time*/
+  disp_drv.gpu_fill_cb = gpu_fill;
+  disp_drv.gpu_blend_cb = gpu_blend;
 
   /*Finally register the driver*/
-  lv_disp_drv_register(&disp_drv);
+  lv_disp_t* disp = lv_disp_drv_register(&disp_drv);
+  /*Merge the invalidated areas before each refresh*/
+  lv_task_set_cb(disp->refr_task, refresh);
+}
+
+void LittleVgl::CoalesceAreas(lv_disp_t* disp) {
+  // Scroll transitions rely on the full screen areas set by the rounder
+  if (scrollDirection != FullRefreshDirections::None || disp->inv_p < 2) {
+    return;
+  }
+  disp->inv_p = AreaCoalescer::Coalesce(disp->inv_areas, disp->inv_p, disp_buf_2.size);
 }
 
 void LittleVgl::InitTouchpad() {
@@ -112,23 +272,41 @@ void LittleVgl::InitTouchpad() {
   indev_drv.type = LV_INDEV_TYPE_POINTER;
   indev_drv.read_cb = touchpad_read;
   indev_drv.user_data = this;
-  lv_indev_drv_register(&indev_drv);
+  touchpad = lv_indev_drv_register(&indev_drv);
 }
 
 void LittleVgl::InitFileSystem() {
   lv_fs_drv_t fs_drv;
   lv_fs_drv_init(&fs_drv);
 
-  fs_drv.file_size = sizeof(lfs_file_t);
+  fs_drv.file_size = sizeof(LvglFile);
   fs_drv.letter = 'F';
   fs_drv.open_cb = lvglOpen;
   fs_drv.close_cb = lvglClose;
   fs_drv.read_cb = lvglRead;
   fs_drv.seek_cb = lvglSeek;
+  fs_drv.tell_cb = lvglTell;
+  fs_drv.size_cb = lvglSize;
 
   fs_drv.user_data = &filesystem;
 
   lv_fs_drv_register(&fs_drv);
+
+  lv_fs_drv_t resource_drv;
+  lv_fs_drv_init(&resource_drv);
+
+  resource_drv.file_size = sizeof(ResourceFile);
+  resource_drv.letter = 'R';
+  resource_drv.open_cb = resourceOpen;
+  resource_drv.close_cb = resourceClose;
+  resource_drv.read_cb = resourceRead;
+  resource_drv.seek_cb = resourceSeek;
+  resource_drv.tell_cb = resourceTell;
+  resource_drv.size_cb = resourceSize;
+
+  resource_drv.user_data = &filesystem;
+
+  lv_fs_drv_register(&resource_drv);
 }
 
 void LittleVgl::SetFullRefresh(FullRefreshDirections direction) {
@@ -153,9 +331,38 @@ bool LittleVgl::IsScrolling() {
   return scrollDirection != LittleVgl::FullRefreshDirections::None;
 }
 
+void LittleVgl::SetRefreshPeriod(uint32_t period) {
+  lv_task_set_period(lv_disp_get_default()->refr_task, period);
+  lv_task_set_period(touchpad->driver.read_task, period);
+  RunRefreshTasks();
+}
+
+void LittleVgl::RefreshIfInvalidated() {
+  if (lv_disp_get_default()->inv_p != 0) {
+    RunRefreshTasks();
+  }
+}
+
+void LittleVgl::RunRefreshTasks() {
+  // Both tasks run in the next lv_task_handler() and start their periods together: out of phase, they would wake the
+  // display task twice per period
+  lv_task_ready(lv_disp_get_default()->refr_task);
+  lv_task_ready(touchpad->driver.read_task);
+}
+
 void LittleVgl::FlushDisplay(const lv_area_t* area, lv_color_t* color_p) {
   uint16_t y1, y2, width, height = 0;
 
+  // A capture only renders to the file, the display keeps the content that was last sent to it
+  if (captureFile != nullptr) {
+    CaptureArea(area, color_p);
+    lv_disp_flush_ready(&disp_drv);
+    xSemaphoreGive(flushDone);
+    return;
+  }
+
+  flushCount++;
+
   if ((scrollDirection == LittleVgl::FullRefreshDirections::Down) && (area->y2 == visibleNbLines - 1)) {
     writeOffset = ((writeOffset + totalNbLines) - visibleNbLines) % totalNbLines;
   } else if ((scrollDirection == FullRefreshDirections::Up) && (area->y1 == 0)) {
@@ -214,24 +421,305 @@ void LittleVgl::FlushDisplay(const lv_area_t* area, lv_color_t* color_p) {
     }
   }
 
+  const uint8_t* data = reinterpret_cast<const uint8_t*>(color_p);
+  size_t lineSize = width * sizeof(lv_color_t);
+
+  if (lowPowerMode) {
+    QuantizeLines(area, color_p);
+
+    if (scrollDirection == FullRefreshDirections::None) {
+      if (!TrimUnchangedLines(area, color_p, y1, height)) {
+        // Nothing to send, the buffer can be given back to LVGL right away
+        lv_disp_flush_ready(&disp_drv);
+        xSemaphoreGive(flushDone);
+        return;
+      }
+      y2 = (y1 + height - 1) % totalNbLines;
+    }
+
+    // The display is in the 12-bit pixel format, the buffer is converted in place
+    data = reinterpret_cast<const uint8_t*>(color_p);
+    lineSize = LowPowerPixels::PackTo12Bit(reinterpret_cast<uint8_t*>(color_p), width * height) / height;
+  }
+
+#ifdef DEBUG
+  flushedBytes += lineSize * height;
+#endif
+
+  // The buffer is handed back to LVGL (lv_disp_flush_ready()) from the SPI interrupt once the last transfer is done.
+  // LVGL renders the next band into the other buffer in the meantime.
+  auto transferDoneHook = [this]() {
+    OnFlushDone();
+  };
+
   if (y2 < y1) {
     height = totalNbLines - y1;
 
     if (height > 0) {
-      lcd.DrawBuffer(area->x1, y1, width, height, reinterpret_cast<const uint8_t*>(color_p), width * height * 2);
+      lcd.DrawBuffer(area->x1, y1, width, height, data, lineSize * height);
     }
 
-    uint16_t pixOffset = width * height;
+    data += lineSize * height;
     height = y2 + 1;
-    lcd.DrawBuffer(area->x1, 0, width, height, reinterpret_cast<const uint8_t*>(color_p + pixOffset), width * height * 2);
+    lcd.DrawBuffer(area->x1, 0, width, height, data, lineSize * height, transferDoneHook);
 
   } else {
-    lcd.DrawBuffer(area->x1, y1, width, height, reinterpret_cast<const uint8_t*>(color_p), width * height * 2);
+    lcd.DrawBuffer(area->x1, y1, width, height, data, lineSize * height, transferDoneHook);
   }
+}
 
+// Called from the SPI interrupt
+void LittleVgl::OnFlushDone() {
   // IMPORTANT!!!
   // Inform the graphics library that you are ready with the flushing
   lv_disp_flush_ready(&disp_drv);
+
+  BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+  xSemaphoreGiveFromISR(flushDone, &xHigherPriorityTaskWoken);
+  portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+void LittleVgl::SetLowPowerMode(bool enabled) {
+  lowPowerMode = enabled;
+  lineHashes.fill(0);
+  litLines.reset();
+  partialLines = {0, 0};
+  partialMode = false;
+  // Redraw everything, so that the whole display is quantized (or back in full colours) and the lit lines are known
+  lv_obj_invalidate(lv_scr_act());
+}
+
+void LittleVgl::UpdatePartialArea() {
+  if (!lowPowerMode || scrollDirection != FullRefreshDirections::None) {
+    return;
+  }
+
+  // When everything is black, a single line is kept
+  LowPowerPixels::Lines visible {0, 0};
+  if (litLines.any()) {
+    visible.first = visibleNbLines - 1;
+    for (uint16_t line = 0; line < visibleNbLines; line++) {
+      if (litLines[line]) {
+        visible.first = std::min(visible.first, line);
+        visible.last = line;
+      }
+    }
+  }
+
+  auto lines = LowPowerPixels::ToMemoryLines(visible, writeOffset, totalNbLines);
+  if (partialMode && lines == partialLines) {
+    return;
+  }
+  lcd.PartialArea(lines.first, lines.last);
+  partialLines = lines;
+  partialMode = true;
+}
+
+// Quantizes the area to the colours of the idle mode and records which lines are not black.
+// Lines are only marked as black when the area covers their whole width.
+void LittleVgl::QuantizeLines(const lv_area_t* area, lv_color_t* color_p) {
+  const uint16_t width = (area->x2 - area->x1) + 1;
+  const bool fullWidth = area->x1 == 0 && area->x2 == LV_HOR_RES - 1;
+
+  for (lv_coord_t y = area->y1; y <= area->y2; y++) {
+    bool lit = LowPowerPixels::Quantize(reinterpret_cast<uint8_t*>(color_p + (y - area->y1) * width), width);
+    if (lit || fullWidth) {
+      litLines[y] = lit;
+    }
+  }
+}
+
+namespace {
+  // FNV-1a over the pixels of one line, seeded with its horizontal bounds
+  uint32_t LineHash(lv_coord_t x1, lv_coord_t x2, const lv_color_t* pixels) {
+    uint32_t hash = 2166136261U ^ (static_cast<uint32_t>(x1) | (static_cast<uint32_t>(x2) << 16));
+    for (lv_coord_t x = x1; x <= x2; x++) {
+      hash = (hash ^ pixels->full) * 16777619U;
+      pixels++;
+    }
+    return hash != 0 ? hash : 1;
+  }
+}
+
+// Narrows the area down to the lines between the first and the last one that changed since they were last sent.
+// Returns false when none of them changed.
+bool LittleVgl::TrimUnchangedLines(const lv_area_t* area, lv_color_t*& color_p, uint16_t& y1, uint16_t& height) {
+  const uint16_t width = (area->x2 - area->x1) + 1;
+  const uint32_t lineSize = LowPowerPixels::PackedSize(width);
+  lv_coord_t first = area->y2 + 1;
+  lv_coord_t last = area->y1 - 1;
+
+  for (lv_coord_t y = area->y1; y <= area->y2; y++) {
+    uint32_t hash = LineHash(area->x1, area->x2, color_p + (y - area->y1) * width);
+    if (hash != lineHashes[y]) {
+      lineHashes[y] = hash;
+      first = std::min(first, y);
+      last = y;
+    }
+  }
+
+  if (first > last) {
+    flushStatistics.bytesSkipped += height * lineSize;
+    return false;
+  }
+
+  uint16_t changedLines = (last - first) + 1;
+  flushStatistics.bytesSkipped += (height - changedLines) * lineSize;
+  flushStatistics.bytesSent += changedLines * lineSize;
+  color_p += (first - area->y1) * width;
+  y1 = (first + writeOffset) % totalNbLines;
+  height = changedLines;
+  return true;
+}
+
+bool LittleVgl::ScrollVertically(lv_coord_t lines, lv_coord_t fixedTop) {
+  // The exposed lines are drawn in the part of the display memory that is not visible, which only has MaxVerticalScroll() lines
+  const lv_coord_t distance = std::abs(lines);
+  if (scrollDirection != FullRefreshDirections::None || lowPowerMode || lines == 0 || distance > MaxVerticalScroll() ||
+      distance >= visibleNbLines - fixedTop) {
+    return false;
+  }
+
+  // What the caller invalidated by moving the content is already in the display memory, it only has to be shifted
+  lv_disp_t* disp = lv_disp_get_default();
+  disp->inv_p = 0;
+  writeOffset = (writeOffset + totalNbLines + lines) % totalNbLines;
+
+  // The exposed lines are drawn first, in the part of the display memory that is not visible yet
+  lv_area_t exposed;
+  exposed.x1 = 0;
+  exposed.x2 = LV_HOR_RES - 1;
+  exposed.y1 = lines > 0 ? visibleNbLines - lines : 0;
+  exposed.y2 = lines > 0 ? visibleNbLines - 1 : -lines - 1;
+  lv_obj_invalidate_area(lv_scr_act(), &exposed);
+  lv_refr_now(disp);
+
+  scrollOffset = writeOffset;
+  lcd.VerticalScrollStartAddress(scrollOffset);
+
+  // Then the lines that moved over the fixed area, or away from it
+  if (fixedTop > 0) {
+    lv_area_t fixed = exposed;
+    fixed.y1 = lines > 0 ? 0 : -lines;
+    fixed.y2 = fixed.y1 + fixedTop - 1;
+    lv_obj_invalidate_area(lv_scr_act(), &fixed);
+  }
+  return true;
+}
+
+bool LittleVgl::CaptureScreen(const char* path) {
+  lfs_file_t file;
+  if (filesystem.FileOpen(&file, path, LFS_O_WRONLY | LFS_O_CREAT | LFS_O_TRUNC) != LFS_ERR_OK) {
+    return false;
+  }
+
+  lv_img_header_t header {};
+  header.cf = LV_IMG_CF_TRUE_COLOR;
+  header.w = LV_HOR_RES;
+  header.h = LV_VER_RES;
+  captureError = filesystem.FileWrite(&file, reinterpret_cast<const uint8_t*>(&header), sizeof(header)) != sizeof(header);
+
+  if (!captureError) {
+    captureFile = &file;
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(nullptr);
+    captureFile = nullptr;
+  }
+
+  filesystem.FileClose(&file);
+  if (captureError) {
+    filesystem.FileDelete(path);
+    return false;
+  }
+  return true;
+}
+
+void LittleVgl::CaptureArea(const lv_area_t* area, const lv_color_t* color_p) {
+  const uint16_t width = (area->x2 - area->x1) + 1;
+  // Full width bands, which is how LVGL renders a full screen refresh, are contiguous in the file
+  const uint16_t rowsPerWrite = (width == LV_HOR_RES) ? (area->y2 - area->y1) + 1 : 1;
+  const uint32_t writeSize = width * rowsPerWrite * sizeof(lv_color_t);
+
+  for (lv_coord_t y = area->y1; y <= area->y2 && !captureError; y += rowsPerWrite) {
+    uint32_t position = sizeof(lv_img_header_t) + (((y * LV_HOR_RES) + area->x1) * sizeof(lv_color_t));
+    captureError = filesystem.FileSeek(captureFile, position) < 0 ||
+                   filesystem.FileWrite(captureFile, reinterpret_cast<const uint8_t*>(color_p), writeSize) != static_cast<int>(writeSize);
+    color_p += width * rowsPerWrite;
+  }
+}
+
+bool LittleVgl::DrawImage(const char* path) {
+  // The image is written where the visible lines are in the display memory, which is only known when no scrolling is in progress.
+  // In low power mode, the display expects 12-bit pixels.
+  if (scrollDirection != FullRefreshDirections::None || lowPowerMode) {
+    return false;
+  }
+
+  lfs_file_t file;
+  if (filesystem.FileOpen(&file, path, LFS_O_RDONLY) != LFS_ERR_OK) {
+    return false;
+  }
+  lineHashes.fill(0);
+  litLines.set();
+
+  lv_img_header_t header;
+  if (filesystem.FileRead(&file, reinterpret_cast<uint8_t*>(&header), sizeof(header)) != sizeof(header) ||
+      header.cf != LV_IMG_CF_TRUE_COLOR || header.w != LV_HOR_RES || header.h != LV_VER_RES) {
+    filesystem.FileClose(&file);
+    return false;
+  }
+
+  // The draw buffers of LVGL are reused, wait until the last band rendered by LVGL is sent
+  while (disp_buf_2.flushing != 0) {
+    WaitFlush();
+  }
+  xSemaphoreTake(flushDone, 0);
+
+  auto transferDoneHook = [this]() {
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    xSemaphoreGiveFromISR(flushDone, &xHigherPriorityTaskWoken);
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+  };
+
+  // After ScrollVertically(), writeOffset is not a multiple of nbWriteLines and a band can wrap around the display memory
+  static constexpr size_t lineSize = LV_HOR_RES * sizeof(lv_color_t);
+  bool success = true;
+  auto* buffer = reinterpret_cast<uint8_t*>(buf2_1);
+  for (uint16_t y = 0; y < visibleNbLines && success; y += nbWriteLines) {
+    success = filesystem.FileRead(&file, buffer, sizeof(buf2_1)) == sizeof(buf2_1);
+    if (success) {
+      const uint16_t y1 = (y + writeOffset) % totalNbLines;
+      const uint16_t height = std::min<uint16_t>(nbWriteLines, totalNbLines - y1);
+      if (height < nbWriteLines) {
+        lcd.DrawBuffer(0, y1, LV_HOR_RES, height, buffer, lineSize * height);
+        lcd.DrawBuffer(0,
+                       0,
+                       LV_HOR_RES,
+                       nbWriteLines - height,
+                       buffer + (lineSize * height),
+                       lineSize * (nbWriteLines - height),
+                       transferDoneHook);
+      } else {
+        lcd.DrawBuffer(0, y1, LV_HOR_RES, nbWriteLines, buffer, sizeof(buf2_1), transferDoneHook);
+      }
+      WaitFlush();
+    }
+  }
+
+  filesystem.FileClose(&file);
+  return success;
+}
+
+void LittleVgl::WaitFlush() {
+  // LVGL checks the flushing flag again when this returns, so a stale give from
+  // a previous flush only costs one extra loop iteration
+#ifdef DEBUG
+  TickType_t start = xTaskGetTickCount();
+  xSemaphoreTake(flushDone, portMAX_DELAY);
+  flushWaitTicks += xTaskGetTickCount() - start;
+#else
+  xSemaphoreTake(flushDone, portMAX_DELAY);
+#endif
 }
 
 void LittleVgl::SetNewTouchPoint(int16_t x, int16_t y, bool contact) {
@@ -1,7 +1,12 @@
 #pragma once
 
+#include <FreeRTOS.h>
+#include <semphr.h>
+#include <array>
+#include <bitset>
 #include <lvgl/lvgl.h>
 #include <components/fs/FS.h>
+#include "displayapp/LowPowerPixels.h"
 
 namespace Pinetime {
   namespace Drivers {
@@ -22,6 +27,9 @@ namespace Pinetime {
       void Init();
 
       void FlushDisplay(const lv_area_t* area, lv_color_t* color_p);
+      // Merges the areas invalidated since the last refresh when fewer, bigger flushes are cheaper
+      void CoalesceAreas(lv_disp_t* disp);
+      void WaitFlush();
       bool GetTouchPadInfo(lv_indev_data_t* ptr);
       void SetFullRefresh(FullRefreshDirections direction);
       void SetNewTouchPoint(int16_t x, int16_t y, bool contact);
@@ -29,6 +37,60 @@ namespace Pinetime {
       void ClearTouchState();
       bool IsScrolling();
 
+      // Retimes the refresh of the display and the reading of the touch panel (LV_DISP_DEF_REFR_PERIOD and
+      // LV_INDEV_DEF_READ_PERIOD by default), both run in the next lv_task_handler()
+      void SetRefreshPeriod(uint32_t period);
+      // Runs the next refresh and touch panel read without waiting for the end of the period if an area was invalidated
+      void RefreshIfInvalidated();
+
+      // Scrolls the display by lines (positive: the content moves up) with the vertical scrolling of the display, after the caller
+      // moved the content by the same amount. Only the exposed lines and the fixedTop lines above the scrolled area are drawn again.
+      // Returns false if the display can't be scrolled, LVGL then redraws the moved content as usual.
+      bool ScrollVertically(lv_coord_t lines, lv_coord_t fixedTop);
+      // Largest number of lines ScrollVertically() can scroll by
+      static constexpr lv_coord_t MaxVerticalScroll() {
+        return totalNbLines - visibleNbLines;
+      }
+
+      // Renders the active screen immediately and stores it in a file as an LVGL true color image.
+      // The rendered areas are not sent to the display.
+      bool CaptureScreen(const char* path);
+      // Sends an image stored by CaptureScreen() to the display without going through LVGL
+      bool DrawImage(const char* path);
+
+      uint32_t GetFlushCount() const {
+        return flushCount;
+      }
+
+#ifdef DEBUG
+      uint32_t GetFlushedBytes() const {
+        return flushedBytes;
+      }
+
+      TickType_t GetFlushWaitTicks() const {
+        return flushWaitTicks;
+      }
+#endif
+
+      struct FlushStatistics {
+        uint32_t bytesSent = 0;
+        uint32_t bytesSkipped = 0;
+      };
+
+      // Rendering mode of the always on display, to be enabled together with St7789::LowPowerOn():
+      // pixels are quantized to the 8 colours of the idle mode and sent as 12-bit pixels, only the lines that differ from what
+      // was last sent to the display are transferred, and UpdatePartialArea() restricts the display to the lines that are not black.
+      void SetLowPowerMode(bool enabled);
+      void UpdatePartialArea();
+
+      bool IsLowPowerMode() const {
+        return lowPowerMode;
+      }
+
+      FlushStatistics GetFlushStatistics() const {
+        return flushStatistics;
+      }
+
       bool GetFullRefresh() {
         bool returnValue = fullRefresh;
         if (fullRefresh) {
@@ -41,6 +103,11 @@ namespace Pinetime {
       void InitDisplay();
       void InitTouchpad();
       void InitFileSystem();
+      void RunRefreshTasks();
+      void OnFlushDone();
+      void QuantizeLines(const lv_area_t* area, lv_color_t* color_p);
+      bool TrimUnchangedLines(const lv_area_t* area, lv_color_t*& color_p, uint16_t& y1, uint16_t& height);
+      void CaptureArea(const lv_area_t* area, const lv_color_t* color_p);
 
       Pinetime::Drivers::St7789& lcd;
       Pinetime::Controllers::FS& filesystem;
@@ -50,6 +117,8 @@ namespace Pinetime {
       lv_color_t buf2_2[LV_HOR_RES_MAX * 4];
 
       lv_disp_drv_t disp_drv;
+      lv_indev_t* touchpad = nullptr;
+      SemaphoreHandle_t flushDone = nullptr;
 
       bool fullRefresh = false;
       static constexpr uint8_t nbWriteLines = 4;
@@ -67,6 +136,21 @@ namespace Pinetime {
       lv_point_t touchPoint = {};
       bool tapped = false;
       bool isCancelled = false;
+
+      uint32_t flushCount = 0;
+#ifdef DEBUG
+      uint32_t flushedBytes = 0;
+      TickType_t flushWaitTicks = 0;
+#endif
+      bool lowPowerMode = false;
+      // Hash of the last segment sent for each line of the display, 0 when unknown
+      std::array<uint32_t, visibleNbLines> lineHashes {};
+      std::bitset<visibleNbLines> litLines;
+      LowPowerPixels::Lines partialLines {0, 0};
+      bool partialMode = false;
+      FlushStatistics flushStatistics;
+      lfs_file_t* captureFile = nullptr;
+      bool captureError = false;
     };
   }
 }
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Pinetime {
+  namespace Components {
+    // Pixel and line helpers for the always on display.
+    // In idle mode, the display only uses the most significant bit of each colour channel (8 colours). Pixels are quantized to
+    // these colours and sent in the 12-bit pixel format, which needs 25% less SPI bandwidth than RGB565.
+    // Input pixels are RGB565 in the byte order they are sent to the display (LV_COLOR_16_SWAP).
+    namespace LowPowerPixels {
+      // Returns the idle mode colour of a pixel: red in bit 2, green in bit 1 and blue in bit 0
+      constexpr uint8_t IdleColor(uint8_t high, uint8_t low) {
+        return ((high >> 5) & 0x04) | ((high >> 1) & 0x02) | ((low >> 4) & 0x01);
+      }
+
+      // Size of a line of quantized pixels once converted to 12-bit pixels
+      constexpr size_t PackedSize(size_t nbPixels) {
+        return (nbPixels * 3) / 2;
+      }
+
+      // Replaces each pixel by its idle mode colour, returns true if at least one of them is not black
+      inline bool Quantize(uint8_t* pixels, size_t nbPixels) {
+        uint8_t lit = 0;
+        for (size_t i = 0; i < nbPixels; i++, pixels += 2) {
+          uint8_t color = IdleColor(pixels[0], pixels[1]);
+          pixels[0] = ((color & 0x04) != 0 ? 0xf8 : 0x00) | ((color & 0x02) != 0 ? 0x07 : 0x00);
+          pixels[1] = ((color & 0x02) != 0 ? 0xe0 : 0x00) | ((color & 0x01) != 0 ? 0x1f : 0x00);
+          lit |= color;
+        }
+        return lit != 0;
+      }
+
+      // Converts pixels to the 12-bit format (2 pixels in 3 bytes: R1G1 B1R2 G2B2), in place.
+      // nbPixels must be even. Returns the size of the converted data.
+      inline size_t PackTo12Bit(uint8_t* pixels, size_t nbPixels) {
+        auto channel = [](uint8_t color, uint8_t bit) -> uint8_t {
+          return (color & (1 << bit)) != 0 ? 0x0f : 0x00;
+        };
+
+        const uint8_t* in = pixels;
+        uint8_t* out = pixels;
+        for (size_t i = 0; i < nbPixels; i += 2, in += 4, out += 3) {
+          uint8_t first = IdleColor(in[0], in[1]);
+          uint8_t second = IdleColor(in[2], in[3]);
+          out[0] = (channel(first, 2) << 4) | channel(first, 1);
+          out[1] = (channel(first, 0) << 4) | channel(second, 2);
+          out[2] = (channel(second, 1) << 4) | channel(second, 0);
+        }
+        return PackedSize(nbPixels);
+      }
+
+      struct Lines {
+        uint16_t first;
+        uint16_t last;
+
+        constexpr bool operator==(const Lines& other) const {
+          return first == other.first && last == other.last;
+        }
+      };
+
+      // Converts visible lines to lines of the display memory, where the first visible line is stored at offset.
+      // The result wraps around the end of the memory when last < first.
+      constexpr Lines ToMemoryLines(Lines visible, uint16_t offset, uint16_t totalNbLines) {
+        return {static_cast<uint16_t>((visible.first + offset) % totalNbLines),
+                static_cast<uint16_t>((visible.last + offset) % totalNbLines)};
+      }
+    }
+  }
+}
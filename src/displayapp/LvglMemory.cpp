@@ -0,0 +1,145 @@
+#include "displayapp/LvglMemory.h"
+#include <FreeRTOS.h>
+
+using namespace Pinetime::Components;
+
+namespace {
+  struct SizeClass {
+    uint16_t blockSize;
+    uint16_t nbBlocks;
+  };
+
+  // Block sizes include the header LVGL adds to each allocation. Style properties and label texts mostly fit in 16 and 32
+  // bytes, the data of the widgets in 48 and 64 bytes, the objects (lv_obj_t and its node in the list of children) in 96 bytes.
+  // The pool is taken from the RAM of the FreeRTOS heap: the number of blocks is the peak measured by lvgl-memory-test
+  // (42, 39, 12, 12 and 16 blocks) with a few more, the larger allocations and the overflow go to the heap. 5.9 KB in total.
+  constexpr std::array<SizeClass, LvglMemory::nbClasses> sizeClasses {{{16, 48}, {32, 48}, {48, 16}, {64, 16}, {96, 20}}};
+
+  // Offset of the slab of each class in the pool, the last element is the size of the pool
+  constexpr std::array<size_t, LvglMemory::nbClasses + 1> slabOffsets = [] {
+    std::array<size_t, LvglMemory::nbClasses + 1> offsets {};
+    for (size_t i = 0; i < LvglMemory::nbClasses; i++) {
+      offsets[i + 1] = offsets[i] + sizeClasses[i].blockSize * sizeClasses[i].nbBlocks;
+    }
+    return offsets;
+  }();
+
+  struct FreeBlock {
+    FreeBlock* next;
+  };
+
+  // Allocations served by the heap are prefixed with their size, so that the statistics can be updated when they are freed.
+  // Aligned like the blocks returned by pvPortMalloc().
+  struct alignas(portBYTE_ALIGNMENT) HeapHeader {
+    size_t size;
+  };
+
+  alignas(portBYTE_ALIGNMENT) uint8_t pool[slabOffsets.back()];
+  std::array<FreeBlock*, LvglMemory::nbClasses> freeBlocks {};
+  std::array<uint16_t, LvglMemory::nbClasses> usedBlocks {};
+  std::array<uint16_t, LvglMemory::nbClasses> peakBlocks {};
+  bool initialized = false;
+
+  size_t usedSize = 0;
+  size_t peakSize = 0;
+  size_t heapUsedSize = 0;
+  uint32_t heapAllocations = 0;
+
+  void Initialize() {
+    for (size_t i = 0; i < LvglMemory::nbClasses; i++) {
+      FreeBlock** last = &freeBlocks[i];
+      for (size_t offset = slabOffsets[i]; offset < slabOffsets[i + 1]; offset += sizeClasses[i].blockSize) {
+        auto* block = reinterpret_cast<FreeBlock*>(&pool[offset]);
+        *last = block;
+        last = &block->next;
+      }
+      *last = nullptr;
+    }
+    initialized = true;
+  }
+
+  void AddUsed(size_t size) {
+    usedSize += size;
+    if (usedSize > peakSize) {
+      peakSize = usedSize;
+    }
+  }
+}
+
+void* lvgl_memory_alloc(size_t size) {
+  if (!initialized) {
+    Initialize();
+  }
+
+  for (size_t i = 0; i < LvglMemory::nbClasses; i++) {
+    if (size <= sizeClasses[i].blockSize && freeBlocks[i] != nullptr) {
+      FreeBlock* block = freeBlocks[i];
+      freeBlocks[i] = block->next;
+      usedBlocks[i]++;
+      if (usedBlocks[i] > peakBlocks[i]) {
+        peakBlocks[i] = usedBlocks[i];
+      }
+      AddUsed(sizeClasses[i].blockSize);
+      return block;
+    }
+  }
+
+  auto* header = static_cast<HeapHeader*>(pvPortMalloc(sizeof(HeapHeader) + size));
+  if (header == nullptr) {
+    return nullptr;
+  }
+  header->size = size;
+  heapUsedSize += size;
+  heapAllocations++;
+  AddUsed(size);
+  return header + 1;
+}
+
+void lvgl_memory_free(void* data) {
+  if (data == nullptr) {
+    return;
+  }
+
+  auto* bytes = static_cast<uint8_t*>(data);
+  if (bytes >= pool && bytes < pool + sizeof(pool)) {
+    size_t offset = bytes - pool;
+    size_t i = 0;
+    while (offset >= slabOffsets[i + 1]) {
+      i++;
+    }
+    auto* block = static_cast<FreeBlock*>(data);
+    block->next = freeBlocks[i];
+    freeBlocks[i] = block;
+    usedBlocks[i]--;
+    usedSize -= sizeClasses[i].blockSize;
+    return;
+  }
+
+  auto* header = static_cast<HeapHeader*>(data) - 1;
+  heapUsedSize -= header->size;
+  usedSize -= header->size;
+  vPortFree(header);
+}
+
+size_t LvglMemory::UsedSize() {
+  return usedSize;
+}
+
+LvglMemory::Statistics LvglMemory::GetStatistics() {
+  Statistics statistics {};
+  statistics.used = usedSize;
+  statistics.peak = peakSize;
+  statistics.heapUsed = heapUsedSize;
+  statistics.heapAllocations = heapAllocations;
+
+  size_t largestHeapBlock = xPortGetLargestFreeBlockSize();
+  statistics.largestFree = largestHeapBlock > sizeof(HeapHeader) ? largestHeapBlock - sizeof(HeapHeader) : 0;
+  for (size_t i = 0; i < nbClasses; i++) {
+    statistics.classes[i] = {sizeClasses[i].blockSize, sizeClasses[i].nbBlocks, usedBlocks[i], peakBlocks[i]};
+    bool hasFreeBlock = usedBlocks[i] < sizeClasses[i].nbBlocks;
+    if (hasFreeBlock && sizeClasses[i].blockSize > statistics.largestFree) {
+      statistics.largestFree = sizeClasses[i].blockSize;
+    }
+  }
+  return statistics;
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Allocator of LVGL (LV_MEM_CUSTOM_ALLOC and LV_MEM_CUSTOM_FREE in lv_conf.h).
+// LVGL is only used by the DisplayApp task, these functions must not be called from any other task.
+void* lvgl_memory_alloc(size_t size);
+void lvgl_memory_free(void* data);
+
+#ifdef __cplusplus
+}
+
+  #include <array>
+  #include <cstdint>
+
+namespace Pinetime {
+  namespace Components {
+    // Screen transitions create and destroy hundreds of small LVGL allocations (objects, widget data, style lists, style
+    // properties, label texts). They are served from slabs of fixed size blocks, one slab per size class, so that they can't
+    // fragment the FreeRTOS heap between the large allocations (fonts, images). An allocation goes to the smallest class that
+    // has a free block, and to the heap when it is larger than the largest class or when all the slabs that fit are full.
+    namespace LvglMemory {
+      static constexpr size_t nbClasses = 5;
+
+      struct ClassStatistics {
+        uint16_t blockSize;
+        uint16_t nbBlocks;
+        uint16_t used;
+        uint16_t peak;
+      };
+
+      struct Statistics {
+        // Bytes used in the slabs (whole blocks) and in the heap
+        size_t used;
+        size_t peak;
+        size_t heapUsed;
+        // Number of allocations that were served by the heap
+        uint32_t heapAllocations;
+        // Largest allocation that can currently succeed
+        size_t largestFree;
+        std::array<ClassStatistics, nbClasses> classes;
+      };
+
+      // Cheap, unlike GetStatistics() which walks the free blocks of the heap
+      size_t UsedSize();
+      Statistics GetStatistics();
+    }
+  }
+}
+#endif
@@ -24,6 +24,8 @@ namespace Pinetime {
         AlarmTriggered,
         Chime,
         BleRadioEnableToggle,
+        // Topics the current screen subscribed to were published on the UpdateBus
+        UpdatesPublished,
       };
     }
   }
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#if defined(__ARM_FEATURE_DSP)
+  #include <arm_acle.h>
+#endif
+
+namespace Pinetime {
+  namespace Components {
+    // Fill and blend kernels for the LVGL draw buffers: RGB565 pixels with swapped bytes (LV_COLOR_16_SWAP).
+    // Two pixels are processed at a time in a 32-bit word, with each colour channel in its own 16-bit lane. The results are
+    // the same as the generic LVGL code (lv_color_fill() and lv_color_mix()).
+    namespace PixelBlend {
+      // Swaps the bytes of both pixels of a pair (REV16)
+      inline uint32_t SwapPair(uint32_t pair) {
+#if defined(__ARM_FEATURE_DSP)
+        return __rev16(pair);
+#else
+        return ((pair & 0x00ff00ffU) << 8) | ((pair >> 8) & 0x00ff00ffU);
+#endif
+      }
+
+      // Divides both 16-bit lanes by 255, rounding down like LV_MATH_UDIV255(). Lanes must be lower than 0x4000.
+      constexpr uint32_t DivideBy255(uint32_t lanes) {
+        return ((lanes + 0x00010001U + ((lanes >> 8) & 0x00ff00ffU)) >> 8) & 0x00ff00ffU;
+      }
+
+      // Red and blue of a native RGB565 pixel, in the low and the high lane
+      constexpr uint32_t RedBlue(uint32_t pixel) {
+        return ((pixel >> 11) & 0x1fU) | ((pixel & 0x1fU) << 16);
+      }
+
+      // Greens of a pair of native RGB565 pixels, in the low and the high lane
+      constexpr uint32_t Greens(uint32_t pair) {
+        return (pair >> 5) & 0x003f003fU;
+      }
+
+      // (foreground * mix + background * (255 - mix) + 128) / 255 for each channel of a pair of native RGB565 pixels
+      constexpr uint32_t MixPair(uint32_t foreground, uint32_t background, uint8_t mix) {
+        constexpr uint32_t rounding = 0x00800080U;
+        const uint32_t inverse = 255 - mix;
+        uint32_t redBlue0 = DivideBy255((RedBlue(foreground) * mix) + (RedBlue(background) * inverse) + rounding);
+        uint32_t redBlue1 = DivideBy255((RedBlue(foreground >> 16) * mix) + (RedBlue(background >> 16) * inverse) + rounding);
+        uint32_t greens = DivideBy255((Greens(foreground) * mix) + (Greens(background) * inverse) + rounding);
+
+        uint32_t pixel0 = ((redBlue0 & 0x1fU) << 11) | ((greens & 0x3fU) << 5) | (redBlue0 >> 16);
+        uint32_t pixel1 = ((redBlue1 & 0x1fU) << 11) | (((greens >> 16) & 0x3fU) << 5) | (redBlue1 >> 16);
+        return pixel0 | (pixel1 << 16);
+      }
+
+      inline void Fill(uint16_t* dest, size_t length, uint16_t color) {
+        if (length > 0 && (reinterpret_cast<uintptr_t>(dest) & 0x03) != 0) {
+          *dest++ = color;
+          length--;
+        }
+
+        const uint32_t pair = color | (static_cast<uint32_t>(color) << 16);
+        auto* words = reinterpret_cast<uint32_t*>(dest);
+        size_t nbWords = length / 2;
+        while (nbWords >= 4) {
+          words[0] = pair;
+          words[1] = pair;
+          words[2] = pair;
+          words[3] = pair;
+          words += 4;
+          nbWords -= 4;
+        }
+        while (nbWords > 0) {
+          *words++ = pair;
+          nbWords--;
+        }
+
+        if ((length & 1) != 0) {
+          dest[length - 1] = color;
+        }
+      }
+
+      // dest = mix of src (weight mix / 255) and dest
+      inline void Blend(uint16_t* dest, const uint16_t* src, size_t length, uint8_t mix) {
+        size_t i = 0;
+        for (; i + 1 < length; i += 2) {
+          uint32_t foreground;
+          uint32_t background;
+          std::memcpy(&foreground, src + i, sizeof(foreground));
+          std::memcpy(&background, dest + i, sizeof(background));
+          uint32_t result = SwapPair(MixPair(SwapPair(foreground), SwapPair(background), mix));
+          std::memcpy(dest + i, &result, sizeof(result));
+        }
+
+        if (i < length) {
+          uint32_t result = SwapPair(MixPair(SwapPair(src[i]), SwapPair(dest[i]), mix));
+          dest[i] = static_cast<uint16_t>(result);
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+namespace Pinetime {
+  namespace Components {
+    // Fonts and images are decoded with many small reads (glyph descriptors, bitmap rows,...).
+    // They are served from a per-file buffer refilled with larger reads instead of going to the flash each time.
+    struct ReadAhead {
+      static constexpr uint32_t size = 128;
+
+      uint32_t position; // Position of the next byte returned to LVGL
+      uint32_t start;    // Position of data[0] in the file
+      uint32_t length;   // Number of valid bytes in data
+      std::array<uint8_t, size> data;
+
+      void Reset() {
+        position = 0;
+        start = 0;
+        length = 0;
+      }
+
+      // fetch(position, buffer, size) reads from the underlying file and returns the number of bytes read, or a negative error code.
+      // Reads that are at least as large as the buffer bypass it. *br is the number of bytes read, lower than btr at the end of the
+      // file. Returns false if fetch failed.
+      template <typename Fetch>
+      bool Read(uint8_t* buffer, uint32_t btr, uint32_t* br, Fetch&& fetch) {
+        *br = 0;
+        while (btr > 0) {
+          if (position >= start && position < start + length) {
+            uint32_t offset = position - start;
+            uint32_t toCopy = std::min(btr, length - offset);
+            std::memcpy(buffer, data.data() + offset, toCopy);
+            position += toCopy;
+            buffer += toCopy;
+            btr -= toCopy;
+            *br += toCopy;
+            continue;
+          }
+
+          if (btr >= size) {
+            int read = fetch(position, buffer, btr);
+            if (read < 0) {
+              return false;
+            }
+            position += read;
+            *br += read;
+            break;
+          }
+
+          int read = fetch(position, data.data(), size);
+          if (read < 0) {
+            return false;
+          }
+          start = position;
+          length = read;
+          if (read == 0) {
+            break;
+          }
+        }
+        return true;
+      }
+    };
+  }
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <FreeRTOS.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace Pinetime {
+  namespace Applications {
+    // Refresh rates of the display and of the touch panel while running: full rate while the screen is touched or animated,
+    // lower rates once it has been static for idleTime
+    class RefreshGovernor {
+    public:
+      struct Level {
+        TickType_t idleTime;
+        uint32_t period;
+      };
+
+      static constexpr std::array<Level, 3> levels {{
+        {0, 20}, // LV_DISP_DEF_REFR_PERIOD
+        {pdMS_TO_TICKS(500), 100},
+        {pdMS_TO_TICKS(3000), 250},
+      }};
+
+      // active: the screen is touched, animated or scrolled. Returns true if the level changed, Period() must then be applied.
+      bool Update(TickType_t now, bool active) {
+        if (active) {
+          lastInteraction = now;
+        }
+
+        size_t newLevel = 0;
+        while (newLevel + 1 < levels.size() && now - lastInteraction >= levels[newLevel + 1].idleTime) {
+          newLevel++;
+        }
+        if (newLevel == level) {
+          return false;
+        }
+        level = newLevel;
+        return true;
+      }
+
+      // Back to full rate at the next update, to draw the first frame after a wake-up as soon as possible
+      void Restart(TickType_t now) {
+        lastInteraction = now;
+      }
+
+      size_t Level() const {
+        return level;
+      }
+
+      uint32_t Period() const {
+        return levels[level].period;
+      }
+
+    private:
+      size_t level = 0;
+      TickType_t lastInteraction = 0;
+    };
+  }
+}
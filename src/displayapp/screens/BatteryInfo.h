@@ -3,6 +3,7 @@
 #include <cstdint>
 #include "displayapp/screens/Screen.h"
 #include <lvgl/lvgl.h>
+#include "utility/Format.h"
 
 namespace Pinetime {
   namespace Controllers {
@@ -27,6 +28,8 @@ namespace Pinetime {
         lv_obj_t* chargingArc;
         lv_obj_t* status;
 
+        Utility::LabelText<5> percentText;
+
         lv_task_t* taskRefresh;
 
         uint8_t batteryPercent = 0;
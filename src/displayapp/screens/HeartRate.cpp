@@ -66,11 +66,10 @@ HeartRate::HeartRate(Controllers::HeartRateController& heartRateController, Syst
     wakeLock.Lock();
   }
 
-  taskRefresh = lv_task_create(RefreshTaskCallback, 100, LV_TASK_PRIO_MID, this);
+  Refresh();
 }
 
 HeartRate::~HeartRate() {
-  lv_task_del(taskRefresh);
   lv_obj_clean(lv_scr_act());
 }
 
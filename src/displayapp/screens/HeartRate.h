@@ -24,6 +24,11 @@ namespace Pinetime {
 
         void Refresh() override;
 
+        Controllers::UpdateBus::Topics Subscriptions() const override {
+          using Topic = Controllers::UpdateBus::Topic;
+          return Controllers::UpdateBus::Mask(Topic::HeartRate);
+        }
+
         void OnStartStopEvent(lv_event_t event);
 
       private:
@@ -36,7 +41,6 @@ namespace Pinetime {
         lv_obj_t* btn_startStop;
         lv_obj_t* label_startStop;
 
-        lv_task_t* taskRefresh;
       };
     }
 
@@ -77,8 +77,8 @@ namespace {
   constexpr uint16_t iconHeight = -80;
   constexpr uint8_t flagIndex = 18;
   constexpr uint8_t maxIconsPerFile = 25;
-  const char* iconsFile0 = "F:/images/navigation0.bin";
-  const char* iconsFile1 = "F:/images/navigation1.bin";
+  const char* iconsFile0 = "R:/images/navigation0.bin";
+  const char* iconsFile1 = "R:/images/navigation1.bin";
 
   constexpr std::array<std::pair<const char*, uint8_t>, 86> iconMap = {{
     {"arrive-left", 1},
@@ -269,17 +269,6 @@ void Navigation::Refresh() {
 }
 
 bool Navigation::IsAvailable(Pinetime::Controllers::FS& filesystem) {
-  lfs_file file = {};
-
-  if (filesystem.FileOpen(&file, "/images/navigation0.bin", LFS_O_RDONLY) < 0) {
-    return false;
-  }
-  filesystem.FileClose(&file);
-
-  if (filesystem.FileOpen(&file, "/images/navigation1.bin", LFS_O_RDONLY) < 0) {
-    return false;
-  }
-  filesystem.FileClose(&file);
-
-  return true;
+  return filesystem.IsResourceAvailable(Controllers::Resources::ImageNavigation0) &&
+         filesystem.IsResourceAvailable(Controllers::Resources::ImageNavigation1);
 }
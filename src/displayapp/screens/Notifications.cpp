@@ -15,11 +15,13 @@ Notifications::Notifications(DisplayApp* app,
                              Pinetime::Controllers::AlertNotificationService& alertNotificationService,
                              Pinetime::Controllers::MotorController& motorController,
                              System::SystemTask& systemTask,
+                             Components::LittleVgl& lvgl,
                              Modes mode)
   : app {app},
     notificationManager {notificationManager},
     alertNotificationService {alertNotificationService},
     motorController {motorController},
+    lvgl {lvgl},
     wakeLock(systemTask),
     mode {mode} {
 
@@ -33,10 +35,11 @@ Notifications::Notifications(DisplayApp* app,
                                                      notification.category,
                                                      notificationManager.NbNotifications(),
                                                      alertNotificationService,
-                                                     motorController);
+                                                     motorController,
+                                                     lvgl);
     validDisplay = true;
   } else {
-    currentItem = std::make_unique<NotificationItem>(alertNotificationService, motorController);
+    currentItem = std::make_unique<NotificationItem>(alertNotificationService, motorController, lvgl);
     validDisplay = false;
   }
   if (mode == Modes::Preview) {
@@ -109,7 +112,8 @@ void Notifications::Refresh() {
                                                        notification.category,
                                                        notificationManager.NbNotifications(),
                                                        alertNotificationService,
-                                                       motorController);
+                                                       motorController,
+                                                       lvgl);
     } else {
       running = false;
     }
@@ -180,6 +184,10 @@ bool Notifications::OnTouchEvent(Pinetime::Applications::TouchEvents event) {
       }
       return false;
     case Pinetime::Applications::TouchEvents::SwipeDown: {
+      if (currentItem->Scroll(-scrollStep)) {
+        return true;
+      }
+
       Controllers::NotificationManager::Notification previousNotification;
       if (validDisplay) {
         previousNotification = notificationManager.GetPrevious(currentId);
@@ -202,10 +210,15 @@ bool Notifications::OnTouchEvent(Pinetime::Applications::TouchEvents event) {
                                                        previousNotification.category,
                                                        notificationManager.NbNotifications(),
                                                        alertNotificationService,
-                                                       motorController);
+                                                       motorController,
+                                                       lvgl);
     }
       return true;
     case Pinetime::Applications::TouchEvents::SwipeUp: {
+      if (currentItem->Scroll(scrollStep)) {
+        return true;
+      }
+
       Controllers::NotificationManager::Notification nextNotification;
       if (validDisplay) {
         nextNotification = notificationManager.GetNext(currentId);
@@ -229,7 +242,8 @@ bool Notifications::OnTouchEvent(Pinetime::Applications::TouchEvents event) {
                                                        nextNotification.category,
                                                        notificationManager.NbNotifications(),
                                                        alertNotificationService,
-                                                       motorController);
+                                                       motorController,
+                                                       lvgl);
     }
       return true;
     default:
@@ -245,14 +259,16 @@ namespace {
 }
 
 Notifications::NotificationItem::NotificationItem(Pinetime::Controllers::AlertNotificationService& alertNotificationService,
-                                                  Pinetime::Controllers::MotorController& motorController)
+                                                  Pinetime::Controllers::MotorController& motorController,
+                                                  Components::LittleVgl& lvgl)
   : NotificationItem("Notifications",
                      "No notifications to display",
                      0,
                      Controllers::NotificationManager::Categories::Unknown,
                      0,
                      alertNotificationService,
-                     motorController) {
+                     motorController,
+                     lvgl) {
 }
 
 Notifications::NotificationItem::NotificationItem(const char* title,
@@ -261,8 +277,9 @@ Notifications::NotificationItem::NotificationItem(const char* title,
                                                   Controllers::NotificationManager::Categories category,
                                                   uint8_t notifNb,
                                                   Pinetime::Controllers::AlertNotificationService& alertNotificationService,
-                                                  Pinetime::Controllers::MotorController& motorController)
-  : alertNotificationService {alertNotificationService}, motorController {motorController} {
+                                                  Pinetime::Controllers::MotorController& motorController,
+                                                  Components::LittleVgl& lvgl)
+  : alertNotificationService {alertNotificationService}, motorController {motorController}, scrollView {lvgl} {
   container = lv_cont_create(lv_scr_act(), nullptr);
   lv_obj_set_size(container, LV_HOR_RES, LV_VER_RES);
   lv_obj_set_style_local_bg_color(container, LV_CONT_PART_MAIN, LV_STATE_DEFAULT, LV_COLOR_BLACK);
@@ -270,13 +287,21 @@ Notifications::NotificationItem::NotificationItem(const char* title,
   lv_obj_set_style_local_pad_inner(container, LV_CONT_PART_MAIN, LV_STATE_DEFAULT, 0);
   lv_obj_set_style_local_border_width(container, LV_CONT_PART_MAIN, LV_STATE_DEFAULT, 0);
 
-  subject_container = lv_cont_create(container, nullptr);
+  // Long messages are scrolled below the title, calls keep their buttons at the bottom of the screen
+  const bool isCall = category == Controllers::NotificationManager::Categories::IncomingCall;
+  lv_obj_t* subjectParent = container;
+  if (!isCall) {
+    scrollView.Create(container, 50);
+    subjectParent = scrollView.GetContent();
+  }
+
+  subject_container = lv_cont_create(subjectParent, nullptr);
   lv_obj_set_style_local_bg_color(subject_container, LV_CONT_PART_MAIN, LV_STATE_DEFAULT, Colors::bgAlt);
   lv_obj_set_style_local_pad_all(subject_container, LV_CONT_PART_MAIN, LV_STATE_DEFAULT, 10);
   lv_obj_set_style_local_pad_inner(subject_container, LV_CONT_PART_MAIN, LV_STATE_DEFAULT, 5);
   lv_obj_set_style_local_border_width(subject_container, LV_CONT_PART_MAIN, LV_STATE_DEFAULT, 0);
 
-  lv_obj_set_pos(subject_container, 0, 50);
+  lv_obj_set_pos(subject_container, 0, isCall ? 50 : 0);
   lv_obj_set_size(subject_container, LV_HOR_RES, LV_VER_RES - 50);
   lv_cont_set_layout(subject_container, LV_LAYOUT_COLUMN_LEFT);
   lv_cont_set_fit(subject_container, LV_FIT_NONE);
@@ -310,6 +335,8 @@ Notifications::NotificationItem::NotificationItem(const char* title,
   switch (category) {
     default:
       lv_label_set_text(alert_subject, msg);
+      lv_obj_set_height(subject_container, std::max<lv_coord_t>(LV_VER_RES - 50, lv_obj_get_height(alert_subject) + 20));
+      lv_obj_set_height(scrollView.GetContent(), lv_obj_get_height(subject_container));
       break;
     case Controllers::NotificationManager::Categories::IncomingCall: {
       lv_obj_set_height(subject_container, 108);
@@ -9,12 +9,17 @@
 #include "components/motor/MotorController.h"
 #include "systemtask/SystemTask.h"
 #include "systemtask/WakeLock.h"
+#include "displayapp/widgets/ScrollView.h"
 
 namespace Pinetime {
   namespace Controllers {
     class AlertNotificationService;
   }
 
+  namespace Components {
+    class LittleVgl;
+  }
+
   namespace Applications {
     namespace Screens {
 
@@ -26,6 +31,7 @@ namespace Pinetime {
                                Pinetime::Controllers::AlertNotificationService& alertNotificationService,
                                Pinetime::Controllers::MotorController& motorController,
                                System::SystemTask& systemTask,
+                               Components::LittleVgl& lvgl,
                                Modes mode);
         ~Notifications() override;
 
@@ -38,14 +44,16 @@ namespace Pinetime {
         class NotificationItem {
         public:
           NotificationItem(Pinetime::Controllers::AlertNotificationService& alertNotificationService,
-                           Pinetime::Controllers::MotorController& motorController);
+                           Pinetime::Controllers::MotorController& motorController,
+                           Components::LittleVgl& lvgl);
           NotificationItem(const char* title,
                            const char* msg,
                            uint8_t notifNr,
                            Controllers::NotificationManager::Categories,
                            uint8_t notifNb,
                            Pinetime::Controllers::AlertNotificationService& alertNotificationService,
-                           Pinetime::Controllers::MotorController& motorController);
+                           Pinetime::Controllers::MotorController& motorController,
+                           Components::LittleVgl& lvgl);
           ~NotificationItem();
 
           bool IsRunning() const {
@@ -54,6 +62,11 @@ namespace Pinetime {
 
           void OnCallButtonEvent(lv_obj_t*, lv_event_t event);
 
+          // Scrolls long messages, returns false when the end of the message in that direction is already shown
+          bool Scroll(lv_coord_t lines) {
+            return scrollView.Scroll(lines);
+          }
+
         private:
           lv_obj_t* container;
           lv_obj_t* subject_container;
@@ -65,6 +78,7 @@ namespace Pinetime {
           lv_obj_t* label_reject;
           Pinetime::Controllers::AlertNotificationService& alertNotificationService;
           Pinetime::Controllers::MotorController& motorController;
+          Widgets::ScrollView scrollView;
 
           bool running = true;
         };
@@ -74,6 +88,7 @@ namespace Pinetime {
         Pinetime::Controllers::NotificationManager& notificationManager;
         Pinetime::Controllers::AlertNotificationService& alertNotificationService;
         Pinetime::Controllers::MotorController& motorController;
+        Components::LittleVgl& lvgl;
         System::WakeLock wakeLock;
         Modes mode = Modes::Normal;
         std::unique_ptr<NotificationItem> currentItem;
@@ -86,6 +101,7 @@ namespace Pinetime {
         TickType_t timeoutTickCountStart;
 
         static const TickType_t timeoutLength = pdMS_TO_TICKS(7000);
+        static constexpr lv_coord_t scrollStep = 140;
         bool interacted = true;
 
         bool dismissingNotification = false;
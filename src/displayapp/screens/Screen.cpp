@@ -1,6 +1,9 @@
 #include "displayapp/screens/Screen.h"
 using namespace Pinetime::Applications::Screens;
 
+uint32_t Screen::refreshCount = 0;
+
 void Screen::RefreshTaskCallback(lv_task_t* task) {
+  refreshCount++;
   static_cast<Screen*>(task->user_data)->Refresh();
 }
@@ -2,6 +2,7 @@
 
 #include <cstdint>
 #include "displayapp/TouchEvents.h"
+#include "components/updatebus/UpdateBus.h"
 #include <lvgl/lvgl.h>
 
 namespace Pinetime {
@@ -21,6 +22,22 @@ namespace Pinetime {
 
         static void RefreshTaskCallback(lv_task_t* task);
 
+        // Topics of the UpdateBus this screen is refreshed on, instead of polling the controllers in a refresh task
+        virtual Controllers::UpdateBus::Topics Subscriptions() const {
+          return 0;
+        }
+
+        // Called by DisplayApp when at least one of the topics in Subscriptions() has been published
+        void OnUpdate() {
+          refreshCount++;
+          Refresh();
+        }
+
+        // Number of refreshes of all the screens since boot, from refresh tasks and from the UpdateBus
+        static uint32_t RefreshCount() {
+          return refreshCount;
+        }
+
         bool IsRunning() const {
           return running;
         }
@@ -42,6 +59,9 @@ namespace Pinetime {
 
       protected:
         bool running = true;
+
+      private:
+        static uint32_t refreshCount;
       };
     }
   }
@@ -39,7 +39,7 @@ Steps::Steps(Controllers::MotionController& motionController, Controllers::Setti
   lSteps = lv_label_create(lv_scr_act(), nullptr);
   lv_obj_set_style_local_text_color(lSteps, LV_LABEL_PART_MAIN, LV_STATE_DEFAULT, LV_COLOR_LIME);
   lv_obj_set_style_local_text_font(lSteps, LV_LABEL_PART_MAIN, LV_STATE_DEFAULT, &jetbrains_mono_42);
-  lv_label_set_text_fmt(lSteps, "%lu", stepsCount);
+  lv_label_set_text_static(lSteps, stepText.Format("%d", stepsCount));
   lv_obj_align(lSteps, nullptr, LV_ALIGN_CENTER, 0, -40);
 
   lv_obj_t* lstepsL = lv_label_create(lv_scr_act(), nullptr);
@@ -75,12 +75,9 @@ Steps::Steps(Controllers::MotionController& motionController, Controllers::Setti
   lv_obj_set_style_local_text_color(tripLabel, LV_LABEL_PART_MAIN, LV_STATE_DEFAULT, LV_COLOR_YELLOW);
   lv_label_set_text_fmt(tripLabel, "Trip: %5li", currentTripSteps);
   lv_obj_align(tripLabel, lstepsGoal, LV_ALIGN_IN_LEFT_MID, 0, 20);
-
-  taskRefresh = lv_task_create(RefreshTaskCallback, 100, LV_TASK_PRIO_MID, this);
 }
 
 Steps::~Steps() {
-  lv_task_del(taskRefresh);
   lv_obj_clean(lv_scr_act());
 }
 
@@ -88,7 +85,7 @@ void Steps::Refresh() {
   stepsCount = motionController.NbSteps();
   currentTripSteps = motionController.GetTripSteps();
 
-  lv_label_set_text_fmt(lSteps, "%lu", stepsCount);
+  lv_label_set_text_static(lSteps, stepText.Format("%d", stepsCount));
   lv_obj_align(lSteps, nullptr, LV_ALIGN_CENTER, 0, -40);
 
   lv_label_set_text_fmt(lStepsYesterday, yesterdayStr, motionController.NbSteps(Days::Yesterday));
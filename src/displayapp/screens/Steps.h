@@ -7,6 +7,7 @@
 #include "displayapp/apps/Apps.h"
 #include "displayapp/Controllers.h"
 #include "Symbols.h"
+#include "utility/Format.h"
 
 namespace Pinetime {
 
@@ -23,6 +24,11 @@ namespace Pinetime {
         ~Steps() override;
 
         void Refresh() override;
+
+        Controllers::UpdateBus::Topics Subscriptions() const override {
+          using Topic = Controllers::UpdateBus::Topic;
+          return Controllers::UpdateBus::Mask(Topic::Steps);
+        }
         void lapBtnEventHandler(lv_event_t event);
 
       private:
@@ -38,9 +44,10 @@ namespace Pinetime {
         lv_obj_t* resetButtonLabel;
         lv_obj_t* tripLabel;
 
+        Utility::LabelText<11> stepText;
+
         uint32_t stepsCount;
 
-        lv_task_t* taskRefresh;
       };
     }
 
@@ -12,6 +12,9 @@
 #include "components/brightness/BrightnessController.h"
 #include "components/datetime/DateTimeController.h"
 #include "components/motion/MotionController.h"
+#include "components/fs/FS.h"
+#include "displayapp/FontCache.h"
+#include "displayapp/LvglMemory.h"
 #include "drivers/Watchdog.h"
 #include "displayapp/InfiniTimeTheme.h"
 
@@ -39,8 +42,11 @@ SystemInfo::SystemInfo(Pinetime::Applications::DisplayApp* app,
                        const Pinetime::Drivers::Watchdog& watchdog,
                        Pinetime::Controllers::MotionController& motionController,
                        const Pinetime::Drivers::Cst816S& touchPanel,
-                       const Pinetime::Drivers::SpiNorFlash& spiNorFlash)
-  : dateTimeController {dateTimeController},
+                       const Pinetime::Drivers::SpiNorFlash& spiNorFlash,
+                       const Pinetime::Controllers::FS& filesystem,
+                       const Pinetime::Components::FontCache& fontCache)
+  : app {app},
+    dateTimeController {dateTimeController},
     batteryController {batteryController},
     brightnessController {brightnessController},
     bleController {bleController},
@@ -48,6 +54,8 @@ SystemInfo::SystemInfo(Pinetime::Applications::DisplayApp* app,
     motionController {motionController},
     touchPanel {touchPanel},
     spiNorFlash {spiNorFlash},
+    filesystem {filesystem},
+    fontCache {fontCache},
     screens {app,
              0,
              {[this]() -> std::unique_ptr<Screen> {
@@ -62,9 +70,24 @@ SystemInfo::SystemInfo(Pinetime::Applications::DisplayApp* app,
               [this]() -> std::unique_ptr<Screen> {
                 return CreateScreen4();
               },
+              [this]() -> std::unique_ptr<Screen> {
+                return CreateLvglMemoryScreen();
+              },
+              [this]() -> std::unique_ptr<Screen> {
+                return CreateHeapScreen();
+              },
               [this]() -> std::unique_ptr<Screen> {
                 return CreateScreen5();
-              }},
+              },
+              [this]() -> std::unique_ptr<Screen> {
+                return CreateScreen6();
+              },
+#ifdef DEBUG
+              [this]() -> std::unique_ptr<Screen> {
+                return CreateFrameStatisticsScreen();
+              },
+#endif
+             },
              Screens::ScreenListModes::UpDown} {
 }
 
@@ -96,7 +119,7 @@ std::unique_ptr<Screen> SystemInfo::CreateScreen1() {
                         BootloaderVersion::VersionString());
   lv_label_set_align(label, LV_LABEL_ALIGN_CENTER);
   lv_obj_align(label, lv_scr_act(), LV_ALIGN_CENTER, 0, 0);
-  return std::make_unique<Screens::Label>(0, 5, label);
+  return std::make_unique<Screens::Label>(0, nbScreens, label);
 }
 
 std::unique_ptr<Screen> SystemInfo::CreateScreen2() {
@@ -175,7 +198,7 @@ std::unique_ptr<Screen> SystemInfo::CreateScreen2() {
                         touchPanel.GetFwVersion(),
                         TARGET_DEVICE_NAME);
   lv_obj_align(label, lv_scr_act(), LV_ALIGN_CENTER, 0, 0);
-  return std::make_unique<Screens::Label>(1, 5, label);
+  return std::make_unique<Screens::Label>(1, nbScreens, label);
 }
 
 extern int mallocFailedCount;
@@ -214,14 +237,130 @@ std::unique_ptr<Screen> SystemInfo::CreateScreen3() {
                         mallocFailedCount,
                         stackOverflowCount);
   lv_obj_align(label, lv_scr_act(), LV_ALIGN_CENTER, 0, 0);
-  return std::make_unique<Screens::Label>(2, 5, label);
+  return std::make_unique<Screens::Label>(2, nbScreens, label);
+}
+
+std::unique_ptr<Screen> SystemInfo::CreateScreen4() {
+  auto fontCacheStatistics = fontCache.GetStatistics();
+  auto readCacheStatistics = filesystem.GetReadCacheStatistics();
+  auto wakeUpLatency = app->GetWakeUpLatency();
+  auto flushStatistics = app->GetFlushStatistics();
+  auto updateRates = app->GetUpdateRates();
+
+  lv_obj_t* label = lv_label_create(lv_scr_act(), nullptr);
+  lv_label_set_recolor(label, true);
+  lv_label_set_text_fmt(label,
+                        "#808080 Font cache#\n"
+                        " #808080 Hit/miss# %lu/%lu\n"
+                        " #808080 Evict# %lu #808080 Size# %d\n"
+                        "#808080 Flash read cache#\n"
+                        " #808080 Hit/miss# %lu/%lu\n"
+                        "#808080 Wake-up# %lu/%lums\n"
+                        "#808080 AOD flush#\n"
+                        " #808080 Sent# %luk #808080 Skip# %luk\n"
+                        "#808080 Clock wake/s# %lu #808080 Draw/s# %lu",
+                        fontCacheStatistics.hits,
+                        fontCacheStatistics.misses,
+                        fontCacheStatistics.evictions,
+                        fontCache.CachedSize(),
+                        readCacheStatistics.hits,
+                        readCacheStatistics.misses,
+                        wakeUpLatency.backlightOn,
+                        wakeUpLatency.firstFrame,
+                        flushStatistics.bytesSent / 1024,
+                        flushStatistics.bytesSkipped / 1024,
+                        updateRates.wakeUps,
+                        updateRates.screenRefreshes);
+  lv_obj_align(label, lv_scr_act(), LV_ALIGN_CENTER, 0, 0);
+  return std::make_unique<Screens::Label>(3, nbScreens, label);
+}
+
+std::unique_ptr<Screen> SystemInfo::CreateLvglMemoryScreen() {
+  auto statistics = Components::LvglMemory::GetStatistics();
+  const auto& classes = statistics.classes;
+
+  lv_obj_t* label = lv_label_create(lv_scr_act(), nullptr);
+  lv_label_set_recolor(label, true);
+  lv_label_set_text_fmt(label,
+                        "#FFFF00 LVGL memory#\n"
+                        "#808080 Used# %d #808080 Peak# %d\n"
+                        "#808080 Heap# %d #808080 Nb# %lu\n"
+                        "#808080 Largest free# %d\n"
+                        "#808080 Size:used/blocks#\n"
+                        " %3d:%2d/%2d %3d:%2d/%2d\n"
+                        " %3d:%2d/%2d %3d:%2d/%2d\n"
+                        " %3d:%2d/%2d",
+                        statistics.used,
+                        statistics.peak,
+                        statistics.heapUsed,
+                        statistics.heapAllocations,
+                        statistics.largestFree,
+                        classes[0].blockSize,
+                        classes[0].used,
+                        classes[0].nbBlocks,
+                        classes[1].blockSize,
+                        classes[1].used,
+                        classes[1].nbBlocks,
+                        classes[2].blockSize,
+                        classes[2].used,
+                        classes[2].nbBlocks,
+                        classes[3].blockSize,
+                        classes[3].used,
+                        classes[3].nbBlocks,
+                        classes[4].blockSize,
+                        classes[4].used,
+                        classes[4].nbBlocks);
+  lv_obj_align(label, lv_scr_act(), LV_ALIGN_CENTER, 0, 0);
+  return std::make_unique<Screens::Label>(4, nbScreens, label);
+}
+
+std::unique_ptr<Screen> SystemInfo::CreateHeapScreen() {
+  HeapStatistics_t statistics;
+  vPortGetHeapStatistics(&statistics);
+  const auto& used = statistics.usAllocatedBlocks;
+  const auto& peak = statistics.usPeakAllocatedBlocks;
+
+  // Allocated blocks of each size class, by upper bound of the class: current/high-water mark.
+  // The few blocks larger than 8KB are grouped, without high-water mark.
+  lv_obj_t* label = lv_label_create(lv_scr_act(), nullptr);
+  lv_label_set_recolor(label, true);
+  lv_label_set_text_fmt(label,
+                        "#FFFF00 Heap#\n"
+                        "#808080 Largest free# %d\n"
+                        "#808080 Fragmentation# %d%%\n"
+                        "#808080 <64# %d/%d #808080 <128# %d/%d\n"
+                        "#808080 <256# %d/%d #808080 <512# %d/%d\n"
+                        "#808080 <1k# %d/%d #808080 <2k# %d/%d\n"
+                        "#808080 <4k# %d/%d #808080 <8k# %d/%d\n"
+                        "#808080 >8k# %d",
+                        statistics.xLargestFreeBlock,
+                        statistics.ucFragmentation,
+                        used[0],
+                        peak[0],
+                        used[1],
+                        peak[1],
+                        used[2],
+                        peak[2],
+                        used[3],
+                        peak[3],
+                        used[4],
+                        peak[4],
+                        used[5],
+                        peak[5],
+                        used[6],
+                        peak[6],
+                        used[7],
+                        peak[7],
+                        used[8] + used[9] + used[10]);
+  lv_obj_align(label, lv_scr_act(), LV_ALIGN_CENTER, 0, 0);
+  return std::make_unique<Screens::Label>(5, nbScreens, label);
 }
 
 bool SystemInfo::sortById(const TaskStatus_t& lhs, const TaskStatus_t& rhs) {
   return lhs.xTaskNumber < rhs.xTaskNumber;
 }
 
-std::unique_ptr<Screen> SystemInfo::CreateScreen4() {
+std::unique_ptr<Screen> SystemInfo::CreateScreen5() {
   static constexpr uint8_t maxTaskCount = 9;
   TaskStatus_t tasksStatus[maxTaskCount];
 
@@ -280,10 +419,10 @@ std::unique_ptr<Screen> SystemInfo::CreateScreen4() {
     }
     lv_table_set_cell_value(infoTask, i + 1, 3, buffer);
   }
-  return std::make_unique<Screens::Label>(3, 5, infoTask);
+  return std::make_unique<Screens::Label>(6, nbScreens, infoTask);
 }
 
-std::unique_ptr<Screen> SystemInfo::CreateScreen5() {
+std::unique_ptr<Screen> SystemInfo::CreateScreen6() {
   lv_obj_t* label = lv_label_create(lv_scr_act(), nullptr);
   lv_label_set_recolor(label, true);
   lv_label_set_text_static(label,
@@ -297,5 +436,33 @@ std::unique_ptr<Screen> SystemInfo::CreateScreen5() {
                            "#FFFF00 InfiniTime#");
   lv_label_set_align(label, LV_LABEL_ALIGN_CENTER);
   lv_obj_align(label, lv_scr_act(), LV_ALIGN_CENTER, 0, 0);
-  return std::make_unique<Screens::Label>(4, 5, label);
+  return std::make_unique<Screens::Label>(7, nbScreens, label);
+}
+
+#ifdef DEBUG
+std::unique_ptr<Screen> SystemInfo::CreateFrameStatisticsScreen() {
+  const auto& frameStatistics = app->GetFrameStatistics();
+  const auto& histograms = frameStatistics.Get();
+
+  lv_obj_t* label = lv_label_create(lv_scr_act(), nullptr);
+  lv_label_set_recolor(label, true);
+  lv_label_set_text_fmt(label,
+                        "#FFFF00 Frames# %lu\n"
+                        "#808080 p50/p90 below#\n"
+                        "#808080 Render# %lu/%lums\n"
+                        "#808080 SPI wait# %lu/%lums\n"
+                        "#808080 Size# %lu/%lukB\n"
+                        "#808080 FPS# %lu/%lu",
+                        frameStatistics.FrameCount(),
+                        histograms.renderMs.Percentile(50),
+                        histograms.renderMs.Percentile(90),
+                        histograms.flushWaitMs.Percentile(50),
+                        histograms.flushWaitMs.Percentile(90),
+                        histograms.kiloBytes.Percentile(50),
+                        histograms.kiloBytes.Percentile(90),
+                        histograms.framesPerSecond.Percentile(50),
+                        histograms.framesPerSecond.Percentile(90));
+  lv_obj_align(label, lv_scr_act(), LV_ALIGN_CENTER, 0, 0);
+  return std::make_unique<Screens::Label>(8, nbScreens, label);
 }
+#endif
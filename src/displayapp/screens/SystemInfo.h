@@ -3,6 +3,7 @@
 #include <memory>
 #include "displayapp/screens/Screen.h"
 #include "displayapp/screens/ScreenList.h"
+#include "displayapp/FrameStatistics.h"
 
 namespace Pinetime {
   namespace Controllers {
@@ -10,6 +11,11 @@ namespace Pinetime {
     class Battery;
     class BrightnessController;
     class Ble;
+    class FS;
+  }
+
+  namespace Components {
+    class FontCache;
   }
 
   namespace Drivers {
@@ -30,11 +36,14 @@ namespace Pinetime {
                             const Pinetime::Drivers::Watchdog& watchdog,
                             Pinetime::Controllers::MotionController& motionController,
                             const Pinetime::Drivers::Cst816S& touchPanel,
-                            const Pinetime::Drivers::SpiNorFlash& spiNorFlash);
+                            const Pinetime::Drivers::SpiNorFlash& spiNorFlash,
+                            const Pinetime::Controllers::FS& filesystem,
+                            const Pinetime::Components::FontCache& fontCache);
         ~SystemInfo() override;
         bool OnTouchEvent(TouchEvents event) override;
 
       private:
+        const DisplayApp* app;
         Pinetime::Controllers::DateTime& dateTimeController;
         const Pinetime::Controllers::Battery& batteryController;
         Pinetime::Controllers::BrightnessController& brightnessController;
@@ -43,8 +52,12 @@ namespace Pinetime {
         Pinetime::Controllers::MotionController& motionController;
         const Pinetime::Drivers::Cst816S& touchPanel;
         const Pinetime::Drivers::SpiNorFlash& spiNorFlash;
+        const Pinetime::Controllers::FS& filesystem;
+        const Pinetime::Components::FontCache& fontCache;
 
-        ScreenList<5> screens;
+        // The frame statistics are only collected in debug builds
+        static constexpr uint8_t nbScreens = FrameStatistics::enabled ? 9 : 8;
+        ScreenList<nbScreens> screens;
 
         static bool sortById(const TaskStatus_t& lhs, const TaskStatus_t& rhs);
 
@@ -52,7 +65,13 @@ namespace Pinetime {
         std::unique_ptr<Screen> CreateScreen2();
         std::unique_ptr<Screen> CreateScreen3();
         std::unique_ptr<Screen> CreateScreen4();
+        std::unique_ptr<Screen> CreateLvglMemoryScreen();
+        std::unique_ptr<Screen> CreateHeapScreen();
         std::unique_ptr<Screen> CreateScreen5();
+        std::unique_ptr<Screen> CreateScreen6();
+#ifdef DEBUG
+        std::unique_ptr<Screen> CreateFrameStatisticsScreen();
+#endif
       };
     }
   }
@@ -35,6 +35,11 @@ namespace Pinetime {
 
         void Refresh() override;
 
+        Controllers::UpdateBus::Topics Subscriptions() const override {
+          using Topic = Controllers::UpdateBus::Topic;
+          return Controllers::UpdateBus::Mask(Topic::Seconds, Topic::Battery, Topic::Ble, Topic::Notifications);
+        }
+
       private:
         uint8_t sHour, sMinute, sSecond;
 
@@ -84,7 +89,6 @@ namespace Pinetime {
         void UpdateClock();
         void SetBatteryIcon();
 
-        lv_task_t* taskRefresh;
       };
     }
 
@@ -10,6 +10,7 @@
 #include "components/datetime/DateTimeController.h"
 #include "components/ble/BleController.h"
 #include "utility/DirtyValue.h"
+#include "utility/Format.h"
 #include "displayapp/apps/Apps.h"
 
 namespace Pinetime {
@@ -34,11 +35,21 @@ namespace Pinetime {
                                  Controllers::Settings& settingsController,
                                  Controllers::HeartRateController& heartRateController,
                                  Controllers::MotionController& motionController,
-                                 Controllers::FS& filesystem);
+                                 Components::FontCache& fontCache);
         ~WatchFaceCasioStyleG7710() override;
 
         void Refresh() override;
 
+        Controllers::UpdateBus::Topics Subscriptions() const override {
+          using Topic = Controllers::UpdateBus::Topic;
+          return Controllers::UpdateBus::Mask(Topic::Time,
+                                              Topic::Battery,
+                                              Topic::Ble,
+                                              Topic::HeartRate,
+                                              Topic::Steps,
+                                              Topic::Notifications);
+        }
+
         static bool IsAvailable(Pinetime::Controllers::FS& filesystem);
 
       private:
@@ -85,6 +96,10 @@ namespace Pinetime {
         lv_obj_t* notificationIcon;
         lv_obj_t* line_icons;
 
+        Utility::LabelText<6> timeText;
+        Utility::LabelText<5> batteryText;
+        Utility::LabelText<11> stepText;
+
         BatteryIcon batteryIcon;
 
         Controllers::DateTime& dateTimeController;
@@ -95,10 +110,11 @@ namespace Pinetime {
         Controllers::HeartRateController& heartRateController;
         Controllers::MotionController& motionController;
 
-        lv_task_t* taskRefresh;
         lv_font_t* font_dot40 = nullptr;
         lv_font_t* font_segment40 = nullptr;
         lv_font_t* font_segment115 = nullptr;
+
+        Components::FontCache& fontCache;
       };
     }
 
@@ -115,7 +131,7 @@ namespace Pinetime {
                                                      controllers.settingsController,
                                                      controllers.heartRateController,
                                                      controllers.motionController,
-                                                     controllers.filesystem);
+                                                     controllers.fontCache);
       };
 
       static bool IsAvailable(Pinetime::Controllers::FS& filesystem) {
@@ -10,6 +10,7 @@
 #include "components/ble/BleController.h"
 #include "displayapp/widgets/StatusIcons.h"
 #include "utility/DirtyValue.h"
+#include "utility/Format.h"
 #include "displayapp/apps/Apps.h"
 
 namespace Pinetime {
@@ -41,6 +42,16 @@ namespace Pinetime {
 
         void Refresh() override;
 
+        Controllers::UpdateBus::Topics Subscriptions() const override {
+          using Topic = Controllers::UpdateBus::Topic;
+          return Controllers::UpdateBus::Mask(Topic::Time,
+                                              Topic::Battery,
+                                              Topic::Ble,
+                                              Topic::HeartRate,
+                                              Topic::Steps,
+                                              Topic::Notifications);
+        }
+
       private:
         uint8_t displayedHour = -1;
         uint8_t displayedMinute = -1;
@@ -65,6 +76,9 @@ namespace Pinetime {
         lv_obj_t* weatherIcon;
         lv_obj_t* temperature;
 
+        Utility::LabelText<6> timeText;
+        Utility::LabelText<11> stepText;
+
         Controllers::DateTime& dateTimeController;
         Controllers::NotificationManager& notificationManager;
         Controllers::Settings& settingsController;
@@ -72,7 +86,6 @@ namespace Pinetime {
         Controllers::MotionController& motionController;
         Controllers::SimpleWeatherService& weatherService;
 
-        lv_task_t* taskRefresh;
         Widgets::StatusIcons statusIcons;
       };
     }
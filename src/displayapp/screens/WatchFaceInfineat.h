@@ -8,6 +8,7 @@
 #include "displayapp/screens/Screen.h"
 #include "components/datetime/DateTimeController.h"
 #include "utility/DirtyValue.h"
+#include "utility/Format.h"
 #include "displayapp/apps/Apps.h"
 
 namespace Pinetime {
@@ -31,7 +32,7 @@ namespace Pinetime {
                           Controllers::NotificationManager& notificationManager,
                           Controllers::Settings& settingsController,
                           Controllers::MotionController& motionController,
-                          Controllers::FS& fs);
+                          Components::FontCache& fontCache);
 
         ~WatchFaceInfineat() override;
 
@@ -83,6 +84,10 @@ namespace Pinetime {
         lv_obj_t* labelBtnSettings;
         lv_obj_t* lblToggle;
 
+        Utility::LabelText<3> hourText;
+        Utility::LabelText<3> minuteText;
+        Utility::LabelText<11> stepText;
+
         lv_obj_t* lines[nLines];
 
         Controllers::DateTime& dateTimeController;
@@ -98,6 +103,8 @@ namespace Pinetime {
         lv_task_t* taskRefresh;
         lv_font_t* font_teko = nullptr;
         lv_font_t* font_bebas = nullptr;
+
+        Components::FontCache& fontCache;
       };
     }
 
@@ -113,7 +120,7 @@ namespace Pinetime {
                                               controllers.notificationManager,
                                               controllers.settingsController,
                                               controllers.motionController,
-                                              controllers.filesystem);
+                                              controllers.fontCache);
       };
 
       static bool IsAvailable(Pinetime::Controllers::FS& filesystem) {
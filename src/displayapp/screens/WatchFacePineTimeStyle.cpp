@@ -34,6 +34,7 @@
 #include "components/motion/MotionController.h"
 #include "components/settings/Settings.h"
 #include "displayapp/DisplayApp.h"
+#include "displayapp/LittleVgl.h"
 #include "components/ble/SimpleWeatherService.h"
 
 using namespace Pinetime::Applications::Screens;
@@ -43,6 +44,11 @@ namespace {
     auto* screen = static_cast<WatchFacePineTimeStyle*>(obj->user_data);
     screen->UpdateSelected(obj, event);
   }
+
+  void CaptureTaskCallback(lv_task_t* task) {
+    auto* screen = static_cast<WatchFacePineTimeStyle*>(task->user_data);
+    screen->CaptureStaticLayer();
+  }
 }
 
 WatchFacePineTimeStyle::WatchFacePineTimeStyle(Controllers::DateTime& dateTimeController,
@@ -51,7 +57,9 @@ WatchFacePineTimeStyle::WatchFacePineTimeStyle(Controllers::DateTime& dateTimeCo
                                                Controllers::NotificationManager& notificationManager,
                                                Controllers::Settings& settingsController,
                                                Controllers::MotionController& motionController,
-                                               Controllers::SimpleWeatherService& weatherService)
+                                               Controllers::SimpleWeatherService& weatherService,
+                                               Components::LittleVgl& lvgl,
+                                               Controllers::FS& filesystem)
   : currentDateTime {{}},
     batteryIcon(false),
     dateTimeController {dateTimeController},
@@ -60,7 +68,12 @@ WatchFacePineTimeStyle::WatchFacePineTimeStyle(Controllers::DateTime& dateTimeCo
     notificationManager {notificationManager},
     settingsController {settingsController},
     motionController {motionController},
-    weatherService {weatherService} {
+    weatherService {weatherService},
+    staticLayer {lvgl, filesystem, "/layers/pinetimestyle.bin", StaticLayerKey()} {
+
+  // The background bars and the calendar icon are stored in the static layer: when it is stored, it is sent to the
+  // display before the first frame, which only draws the other objects
+  bool staticLayerStored = staticLayer.Load();
 
   // Create a 200px wide background rectangle
   timebar = lv_obj_create(lv_scr_act(), nullptr);
@@ -69,6 +82,59 @@ WatchFacePineTimeStyle::WatchFacePineTimeStyle(Controllers::DateTime& dateTimeCo
   lv_obj_set_size(timebar, 200, 240);
   lv_obj_align(timebar, lv_scr_act(), LV_ALIGN_IN_TOP_LEFT, 0, 0);
 
+  // Create a 40px wide bar down the right side of the screen
+  sidebar = lv_obj_create(lv_scr_act(), nullptr);
+  lv_obj_set_style_local_bg_color(sidebar, LV_BTN_PART_MAIN, LV_STATE_DEFAULT, Convert(settingsController.GetPTSColorBar()));
+  lv_obj_set_style_local_radius(sidebar, LV_BTN_PART_MAIN, LV_STATE_DEFAULT, 0);
+  lv_obj_set_size(sidebar, 40, 240);
+  lv_obj_align(sidebar, lv_scr_act(), LV_ALIGN_IN_TOP_RIGHT, 0, 0);
+
+  // Calendar icon
+  calendarOuter = lv_obj_create(lv_scr_act(), nullptr);
+  lv_obj_set_style_local_bg_color(calendarOuter, LV_BTN_PART_MAIN, LV_STATE_DEFAULT, LV_COLOR_BLACK);
+  lv_obj_set_style_local_radius(calendarOuter, LV_BTN_PART_MAIN, LV_STATE_DEFAULT, 0);
+  lv_obj_set_size(calendarOuter, 34, 34);
+  if (settingsController.GetPTSWeather() == Pinetime::Controllers::Settings::PTSWeather::On) {
+    lv_obj_align(calendarOuter, sidebar, LV_ALIGN_CENTER, 0, 20);
+  } else {
+    lv_obj_align(calendarOuter, sidebar, LV_ALIGN_CENTER, 0, 0);
+  }
+
+  calendarInner = lv_obj_create(lv_scr_act(), nullptr);
+  lv_obj_set_style_local_bg_color(calendarInner, LV_BTN_PART_MAIN, LV_STATE_DEFAULT, LV_COLOR_WHITE);
+  lv_obj_set_style_local_radius(calendarInner, LV_BTN_PART_MAIN, LV_STATE_DEFAULT, 0);
+  lv_obj_set_size(calendarInner, 27, 27);
+  lv_obj_align(calendarInner, calendarOuter, LV_ALIGN_CENTER, 0, 0);
+
+  calendarBar1 = lv_obj_create(lv_scr_act(), nullptr);
+  lv_obj_set_style_local_bg_color(calendarBar1, LV_BTN_PART_MAIN, LV_STATE_DEFAULT, LV_COLOR_BLACK);
+  lv_obj_set_style_local_radius(calendarBar1, LV_BTN_PART_MAIN, LV_STATE_DEFAULT, 0);
+  lv_obj_set_size(calendarBar1, 3, 12);
+  lv_obj_align(calendarBar1, calendarOuter, LV_ALIGN_IN_TOP_MID, -6, -3);
+
+  calendarBar2 = lv_obj_create(lv_scr_act(), nullptr);
+  lv_obj_set_style_local_bg_color(calendarBar2, LV_BTN_PART_MAIN, LV_STATE_DEFAULT, LV_COLOR_BLACK);
+  lv_obj_set_style_local_radius(calendarBar2, LV_BTN_PART_MAIN, LV_STATE_DEFAULT, 0);
+  lv_obj_set_size(calendarBar2, 3, 12);
+  lv_obj_align(calendarBar2, calendarOuter, LV_ALIGN_IN_TOP_MID, 6, -3);
+
+  calendarCrossBar1 = lv_obj_create(lv_scr_act(), nullptr);
+  lv_obj_set_style_local_bg_color(calendarCrossBar1, LV_BTN_PART_MAIN, LV_STATE_DEFAULT, LV_COLOR_BLACK);
+  lv_obj_set_style_local_radius(calendarCrossBar1, LV_BTN_PART_MAIN, LV_STATE_DEFAULT, 0);
+  lv_obj_set_size(calendarCrossBar1, 8, 3);
+  lv_obj_align(calendarCrossBar1, calendarBar1, LV_ALIGN_IN_BOTTOM_MID, 0, 0);
+
+  calendarCrossBar2 = lv_obj_create(lv_scr_act(), nullptr);
+  lv_obj_set_style_local_bg_color(calendarCrossBar2, LV_BTN_PART_MAIN, LV_STATE_DEFAULT, LV_COLOR_BLACK);
+  lv_obj_set_style_local_radius(calendarCrossBar2, LV_BTN_PART_MAIN, LV_STATE_DEFAULT, 0);
+  lv_obj_set_size(calendarCrossBar2, 8, 3);
+  lv_obj_align(calendarCrossBar2, calendarBar2, LV_ALIGN_IN_BOTTOM_MID, 0, 0);
+
+  if (!staticLayerStored) {
+    // Writing the layer takes a while, it is done once the watch face is on the display
+    taskCapture = lv_task_create(CaptureTaskCallback, captureDelay, LV_TASK_PRIO_LOWEST, this);
+  }
+
   // Display the time
   timeDD1 = lv_label_create(lv_scr_act(), nullptr);
   lv_obj_set_style_local_text_font(timeDD1, LV_LABEL_PART_MAIN, LV_STATE_DEFAULT, &open_sans_light);
@@ -88,17 +154,11 @@ WatchFacePineTimeStyle::WatchFacePineTimeStyle(Controllers::DateTime& dateTimeCo
   lv_label_set_text_static(timeAMPM, "");
   lv_obj_align(timeAMPM, timebar, LV_ALIGN_IN_BOTTOM_LEFT, 2, -20);
 
-  // Create a 40px wide bar down the right side of the screen
-  sidebar = lv_obj_create(lv_scr_act(), nullptr);
-  lv_obj_set_style_local_bg_color(sidebar, LV_BTN_PART_MAIN, LV_STATE_DEFAULT, Convert(settingsController.GetPTSColorBar()));
-  lv_obj_set_style_local_radius(sidebar, LV_BTN_PART_MAIN, LV_STATE_DEFAULT, 0);
-  lv_obj_set_size(sidebar, 40, 240);
-  lv_obj_align(sidebar, lv_scr_act(), LV_ALIGN_IN_TOP_RIGHT, 0, 0);
-
   // Display icons
-  batteryIcon.Create(sidebar);
+  // On the screen, not in the sidebar: the static layer must not contain it
+  batteryIcon.Create(lv_scr_act());
   batteryIcon.SetColor(LV_COLOR_BLACK);
-  lv_obj_align(batteryIcon.GetObject(), nullptr, LV_ALIGN_IN_TOP_MID, 10, 2);
+  lv_obj_align(batteryIcon.GetObject(), sidebar, LV_ALIGN_IN_TOP_MID, 10, 2);
 
   plugIcon = lv_label_create(lv_scr_act(), nullptr);
   lv_label_set_text_static(plugIcon, Symbols::plug);
@@ -135,47 +195,6 @@ WatchFacePineTimeStyle::WatchFacePineTimeStyle(Controllers::DateTime& dateTimeCo
     lv_obj_set_hidden(temperature, true);
   }
 
-  // Calendar icon
-  calendarOuter = lv_obj_create(lv_scr_act(), nullptr);
-  lv_obj_set_style_local_bg_color(calendarOuter, LV_BTN_PART_MAIN, LV_STATE_DEFAULT, LV_COLOR_BLACK);
-  lv_obj_set_style_local_radius(calendarOuter, LV_BTN_PART_MAIN, LV_STATE_DEFAULT, 0);
-  lv_obj_set_size(calendarOuter, 34, 34);
-  if (settingsController.GetPTSWeather() == Pinetime::Controllers::Settings::PTSWeather::On) {
-    lv_obj_align(calendarOuter, sidebar, LV_ALIGN_CENTER, 0, 20);
-  } else {
-    lv_obj_align(calendarOuter, sidebar, LV_ALIGN_CENTER, 0, 0);
-  }
-
-  calendarInner = lv_obj_create(lv_scr_act(), nullptr);
-  lv_obj_set_style_local_bg_color(calendarInner, LV_BTN_PART_MAIN, LV_STATE_DEFAULT, LV_COLOR_WHITE);
-  lv_obj_set_style_local_radius(calendarInner, LV_BTN_PART_MAIN, LV_STATE_DEFAULT, 0);
-  lv_obj_set_size(calendarInner, 27, 27);
-  lv_obj_align(calendarInner, calendarOuter, LV_ALIGN_CENTER, 0, 0);
-
-  calendarBar1 = lv_obj_create(lv_scr_act(), nullptr);
-  lv_obj_set_style_local_bg_color(calendarBar1, LV_BTN_PART_MAIN, LV_STATE_DEFAULT, LV_COLOR_BLACK);
-  lv_obj_set_style_local_radius(calendarBar1, LV_BTN_PART_MAIN, LV_STATE_DEFAULT, 0);
-  lv_obj_set_size(calendarBar1, 3, 12);
-  lv_obj_align(calendarBar1, calendarOuter, LV_ALIGN_IN_TOP_MID, -6, -3);
-
-  calendarBar2 = lv_obj_create(lv_scr_act(), nullptr);
-  lv_obj_set_style_local_bg_color(calendarBar2, LV_BTN_PART_MAIN, LV_STATE_DEFAULT, LV_COLOR_BLACK);
-  lv_obj_set_style_local_radius(calendarBar2, LV_BTN_PART_MAIN, LV_STATE_DEFAULT, 0);
-  lv_obj_set_size(calendarBar2, 3, 12);
-  lv_obj_align(calendarBar2, calendarOuter, LV_ALIGN_IN_TOP_MID, 6, -3);
-
-  calendarCrossBar1 = lv_obj_create(lv_scr_act(), nullptr);
-  lv_obj_set_style_local_bg_color(calendarCrossBar1, LV_BTN_PART_MAIN, LV_STATE_DEFAULT, LV_COLOR_BLACK);
-  lv_obj_set_style_local_radius(calendarCrossBar1, LV_BTN_PART_MAIN, LV_STATE_DEFAULT, 0);
-  lv_obj_set_size(calendarCrossBar1, 8, 3);
-  lv_obj_align(calendarCrossBar1, calendarBar1, LV_ALIGN_IN_BOTTOM_MID, 0, 0);
-
-  calendarCrossBar2 = lv_obj_create(lv_scr_act(), nullptr);
-  lv_obj_set_style_local_bg_color(calendarCrossBar2, LV_BTN_PART_MAIN, LV_STATE_DEFAULT, LV_COLOR_BLACK);
-  lv_obj_set_style_local_radius(calendarCrossBar2, LV_BTN_PART_MAIN, LV_STATE_DEFAULT, 0);
-  lv_obj_set_size(calendarCrossBar2, 8, 3);
-  lv_obj_align(calendarCrossBar2, calendarBar2, LV_ALIGN_IN_BOTTOM_MID, 0, 0);
-
   // Display date
   dateDayOfWeek = lv_label_create(lv_scr_act(), nullptr);
   lv_obj_set_style_local_text_color(dateDayOfWeek, LV_LABEL_PART_MAIN, LV_STATE_DEFAULT, LV_COLOR_BLACK);
@@ -396,10 +415,15 @@ WatchFacePineTimeStyle::WatchFacePineTimeStyle(Controllers::DateTime& dateTimeCo
 
   taskRefresh = lv_task_create(RefreshTaskCallback, LV_DISP_DEF_REFR_PERIOD, LV_TASK_PRIO_MID, this);
   Refresh();
+
+  staticLayer.Draw({timebar, sidebar, calendarOuter, calendarInner, calendarBar1, calendarBar2, calendarCrossBar1, calendarCrossBar2});
 }
 
 WatchFacePineTimeStyle::~WatchFacePineTimeStyle() {
   lv_task_del(taskRefresh);
+  if (taskCapture != nullptr) {
+    lv_task_del(taskCapture);
+  }
   lv_obj_clean(lv_scr_act());
 }
 
@@ -501,11 +525,11 @@ void WatchFacePineTimeStyle::Refresh() {
         }
         lv_label_set_text(timeAMPM, ampmChar);
         // Should be padded with blank spaces, but the space character doesn't exist in the font
-        lv_label_set_text_fmt(timeDD1, "%02d", hour);
-        lv_label_set_text_fmt(timeDD2, "%02d", minute);
+        lv_label_set_text_static(timeDD1, hourText.Format("%02d", hour));
+        lv_label_set_text_static(timeDD2, minuteText.Format("%02d", minute));
       } else {
-        lv_label_set_text_fmt(timeDD1, "%02d", hour);
-        lv_label_set_text_fmt(timeDD2, "%02d", minute);
+        lv_label_set_text_static(timeDD1, hourText.Format("%02d", hour));
+        lv_label_set_text_static(timeDD2, minuteText.Format("%02d", minute));
       }
     }
 
@@ -531,7 +555,7 @@ void WatchFacePineTimeStyle::Refresh() {
   if (stepCount.IsUpdated()) {
     lv_gauge_set_value(stepGauge, 0, (stepCount.Get() / (settingsController.GetStepsGoal() / 100)) % 100);
     lv_obj_realign(stepGauge);
-    lv_label_set_text_fmt(stepValue, "%luK", (stepCount.Get() / 1000));
+    lv_label_set_text_static(stepValue, stepText.Format("%dK", (stepCount.Get() / 1000)));
     lv_obj_realign(stepValue);
     if (stepCount.Get() > settingsController.GetStepsGoal()) {
       lv_obj_set_style_local_line_color(stepGauge, LV_GAUGE_PART_MAIN, LV_STATE_DEFAULT, LV_COLOR_WHITE);
@@ -566,12 +590,36 @@ void WatchFacePineTimeStyle::Refresh() {
   }
 }
 
+uint32_t WatchFacePineTimeStyle::StaticLayerKey() const {
+  return static_cast<uint32_t>(settingsController.GetPTSColorBG()) | (static_cast<uint32_t>(settingsController.GetPTSColorBar()) << 8) |
+         (static_cast<uint32_t>(settingsController.GetPTSWeather()) << 16);
+}
+
+void WatchFacePineTimeStyle::CaptureStaticLayer() {
+  if (staticLayer.Capture({timebar, sidebar, calendarOuter, calendarInner, calendarBar1, calendarBar2, calendarCrossBar1, calendarCrossBar2})) {
+    lv_task_del(taskCapture);
+    taskCapture = nullptr;
+  }
+}
+
+void WatchFacePineTimeStyle::DropStaticLayer() {
+  // The settings of the layer are being changed, it is captured on the next load if its key changed
+  if (taskCapture != nullptr) {
+    lv_task_del(taskCapture);
+    taskCapture = nullptr;
+  }
+}
+
 void WatchFacePineTimeStyle::UpdateSelected(lv_obj_t* object, lv_event_t event) {
   auto valueTime = settingsController.GetPTSColorTime();
   auto valueBar = settingsController.GetPTSColorBar();
   auto valueBG = settingsController.GetPTSColorBG();
 
   if (event == LV_EVENT_CLICKED) {
+    if (object == btnNextBar || object == btnPrevBar || object == btnNextBG || object == btnPrevBG || object == btnReset ||
+        object == btnRandom || object == btnWeather) {
+      DropStaticLayer();
+    }
     if (object == btnNextTime) {
       valueTime = GetNext(valueTime);
       if (valueTime == valueBG) {
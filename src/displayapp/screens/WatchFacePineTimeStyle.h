@@ -7,11 +7,13 @@
 #include <displayapp/Controllers.h>
 #include "displayapp/screens/Screen.h"
 #include "displayapp/screens/BatteryIcon.h"
+#include "displayapp/widgets/StaticLayer.h"
 #include "displayapp/Colors.h"
 #include "components/datetime/DateTimeController.h"
 #include "components/ble/SimpleWeatherService.h"
 #include "components/ble/BleController.h"
 #include "utility/DirtyValue.h"
+#include "utility/Format.h"
 
 namespace Pinetime {
   namespace Controllers {
@@ -33,7 +35,9 @@ namespace Pinetime {
                                Controllers::NotificationManager& notificationManager,
                                Controllers::Settings& settingsController,
                                Controllers::MotionController& motionController,
-                               Controllers::SimpleWeatherService& weather);
+                               Controllers::SimpleWeatherService& weather,
+                               Components::LittleVgl& lvgl,
+                               Controllers::FS& filesystem);
         ~WatchFacePineTimeStyle() override;
 
         bool OnTouchEvent(TouchEvents event) override;
@@ -42,8 +46,11 @@ namespace Pinetime {
         void Refresh() override;
 
         void UpdateSelected(lv_obj_t* object, lv_event_t event);
+        void CaptureStaticLayer();
 
       private:
+        static constexpr uint32_t captureDelay = 1000;
+
         uint8_t displayedHour = -1;
         uint8_t displayedMinute = -1;
         uint8_t displayedSecond = -1;
@@ -102,6 +109,11 @@ namespace Pinetime {
         lv_obj_t* btnSetOpts;
         lv_obj_t* stepIcon;
         lv_obj_t* stepValue;
+
+        Utility::LabelText<3> hourText;
+        Utility::LabelText<3> minuteText;
+        Utility::LabelText<9> stepText;
+
         lv_color_t needle_colors[1];
 
         BatteryIcon batteryIcon;
@@ -114,10 +126,15 @@ namespace Pinetime {
         Controllers::MotionController& motionController;
         Controllers::SimpleWeatherService& weatherService;
 
+        Widgets::StaticLayer staticLayer;
+
+        uint32_t StaticLayerKey() const;
+        void DropStaticLayer();
         void SetBatteryIcon();
         void CloseMenu();
 
         lv_task_t* taskRefresh;
+        lv_task_t* taskCapture = nullptr;
       };
     }
 
@@ -133,7 +150,9 @@ namespace Pinetime {
                                                    controllers.notificationManager,
                                                    controllers.settingsController,
                                                    controllers.motionController,
-                                                   *controllers.weatherController);
+                                                   *controllers.weatherController,
+                                                   controllers.lvgl,
+                                                   controllers.filesystem);
       };
 
       static bool IsAvailable(Pinetime::Controllers::FS& /*filesystem*/) {
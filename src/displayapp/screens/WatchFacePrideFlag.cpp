@@ -198,10 +198,9 @@ void WatchFacePrideFlag::Refresh() {
   bleState = bleController.IsConnected();
   batteryPercentRemaining = batteryController.PercentRemaining();
   if (batteryPercentRemaining.IsUpdated() || powerPresent.IsUpdated() || themeChanged) {
-    lv_label_set_text_fmt(batteryValue, "%d%%", batteryPercentRemaining.Get());
-    if (batteryController.IsPowerPresent()) {
-      lv_label_ins_text(batteryValue, LV_LABEL_POS_LAST, " Charging");
-    }
+    lv_label_set_text_static(
+      batteryValue,
+      batteryText.Format("%d%%%s", batteryPercentRemaining.Get(), batteryController.IsPowerPresent() ? " Charging" : ""));
   }
   if (bleState.IsUpdated()) {
     if (bleState.Get()) {
@@ -238,7 +237,7 @@ void WatchFacePrideFlag::Refresh() {
       }
     }
 
-    lv_label_set_text_fmt(labelTime, "%02d:%02d:%02d", hour, minute, second);
+    lv_label_set_text_static(labelTime, timeText.Format("%02d:%02d:%02d", hour, minute, second));
 
     currentDate = std::chrono::time_point_cast<std::chrono::days>(currentDateTime.Get());
     if (currentDate.IsUpdated() || ampmChar.IsUpdated() || themeChanged) {
@@ -257,7 +256,7 @@ void WatchFacePrideFlag::Refresh() {
 
   stepCount = motionController.NbSteps();
   if (stepCount.IsUpdated() || themeChanged) {
-    lv_label_set_text_fmt(stepValue, "%lu steps", stepCount.Get());
+    lv_label_set_text_static(stepValue, stepText.Format("%d steps", stepCount.Get()));
   }
   if (themeChanged) {
     themeChanged = false;
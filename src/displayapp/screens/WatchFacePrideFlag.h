@@ -8,6 +8,7 @@
 #include <FreeRTOS.h>
 #include "displayapp/screens/Screen.h"
 #include "utility/DirtyValue.h"
+#include "utility/Format.h"
 #include "components/settings/Settings.h"
 #include "components/battery/BatteryController.h"
 
@@ -68,6 +69,11 @@ namespace Pinetime {
         lv_obj_t* btnNextFlag;
         lv_obj_t* btnPrevFlag;
 
+        Utility::LabelText<9> timeText;
+        // "100% Charging"
+        Utility::LabelText<14> batteryText;
+        Utility::LabelText<17> stepText;
+
         Controllers::DateTime& dateTimeController;
         const Controllers::Battery& batteryController;
         const Controllers::Ble& bleController;
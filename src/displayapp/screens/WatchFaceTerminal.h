@@ -9,6 +9,7 @@
 #include "components/datetime/DateTimeController.h"
 #include "components/ble/SimpleWeatherService.h"
 #include "utility/DirtyValue.h"
+#include "utility/Format.h"
 
 namespace Pinetime {
   namespace Controllers {
@@ -37,6 +38,16 @@ namespace Pinetime {
 
         void Refresh() override;
 
+        Controllers::UpdateBus::Topics Subscriptions() const override {
+          using Topic = Controllers::UpdateBus::Topic;
+          return Controllers::UpdateBus::Mask(Topic::Seconds,
+                                              Topic::Battery,
+                                              Topic::Ble,
+                                              Topic::HeartRate,
+                                              Topic::Steps,
+                                              Topic::Notifications);
+        }
+
       private:
         Utility::DirtyValue<int> batteryPercentRemaining {};
         Utility::DirtyValue<bool> powerPresent {};
@@ -62,6 +73,11 @@ namespace Pinetime {
         lv_obj_t* connectState;
         lv_obj_t* labelPrompt2;
 
+        Utility::LabelText<48> timeText;
+        // "#ffffff [BATT]# 100% Charging"
+        Utility::LabelText<30> batteryText;
+        Utility::LabelText<36> stepText;
+
         Controllers::DateTime& dateTimeController;
         const Controllers::Battery& batteryController;
         const Controllers::Ble& bleController;
@@ -71,7 +87,6 @@ namespace Pinetime {
         Controllers::MotionController& motionController;
         Controllers::SimpleWeatherService& weatherService;
 
-        lv_task_t* taskRefresh;
       };
     }
 
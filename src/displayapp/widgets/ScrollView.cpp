@@ -0,0 +1,81 @@
+#include "displayapp/widgets/ScrollView.h"
+#include <algorithm>
+#include "displayapp/LittleVgl.h"
+
+using namespace Pinetime::Applications::Widgets;
+
+ScrollView::ScrollView(Components::LittleVgl& lvgl) : lvgl {lvgl} {
+}
+
+ScrollView::~ScrollView() {
+  lv_anim_del(this, nullptr);
+}
+
+void ScrollView::Create(lv_obj_t* parent, lv_coord_t y) {
+  top = y;
+
+  viewport = lv_cont_create(parent, nullptr);
+  lv_obj_set_style_local_bg_opa(viewport, LV_CONT_PART_MAIN, LV_STATE_DEFAULT, LV_OPA_TRANSP);
+  lv_obj_set_style_local_border_width(viewport, LV_CONT_PART_MAIN, LV_STATE_DEFAULT, 0);
+  lv_obj_set_style_local_pad_all(viewport, LV_CONT_PART_MAIN, LV_STATE_DEFAULT, 0);
+  lv_obj_set_pos(viewport, 0, y);
+  lv_obj_set_size(viewport, LV_HOR_RES, LV_VER_RES - y);
+
+  content = lv_cont_create(viewport, nullptr);
+  lv_obj_set_style_local_bg_opa(content, LV_CONT_PART_MAIN, LV_STATE_DEFAULT, LV_OPA_TRANSP);
+  lv_obj_set_style_local_border_width(content, LV_CONT_PART_MAIN, LV_STATE_DEFAULT, 0);
+  lv_obj_set_style_local_pad_all(content, LV_CONT_PART_MAIN, LV_STATE_DEFAULT, 0);
+  lv_obj_set_pos(content, 0, 0);
+  lv_obj_set_size(content, LV_HOR_RES, LV_VER_RES - y);
+}
+
+bool ScrollView::Scroll(lv_coord_t lines) {
+  if (!IsScrollable()) {
+    return false;
+  }
+
+  lv_coord_t newTarget = std::clamp<lv_coord_t>(target + lines, 0, MaxPosition());
+  if (newTarget == target) {
+    return false;
+  }
+  target = newTarget;
+
+  lv_anim_t animation;
+  lv_anim_init(&animation);
+  lv_anim_set_var(&animation, this);
+  lv_anim_set_exec_cb(&animation, ScrollAnimationCallback);
+  lv_anim_set_values(&animation, position, target);
+  lv_anim_set_time(&animation, animationTime);
+  lv_anim_start(&animation);
+  return true;
+}
+
+void ScrollView::ScrollAnimationCallback(void* scrollView, lv_anim_value_t position) {
+  static_cast<ScrollView*>(scrollView)->SetPosition(position);
+}
+
+void ScrollView::SetPosition(lv_coord_t newPosition) {
+  if (newPosition == position) {
+    return;
+  }
+
+  // The display can only be scrolled by a few lines at once, larger steps are split
+  static constexpr lv_coord_t maxStep = Components::LittleVgl::MaxVerticalScroll();
+  while (position != newPosition) {
+    // Pending changes, including the fixed lines of the previous step, are drawn where the content currently is
+    lv_refr_now(nullptr);
+    lv_coord_t step = std::clamp<lv_coord_t>(newPosition - position, -maxStep, maxStep);
+    lv_obj_set_y(content, -(position + step));
+    if (!lvgl.ScrollVertically(step, top)) {
+      // LVGL draws the content at its new position as usual
+      lv_obj_set_y(content, -newPosition);
+      break;
+    }
+    position += step;
+  }
+  position = newPosition;
+}
+
+lv_coord_t ScrollView::MaxPosition() const {
+  return std::max<lv_coord_t>(0, lv_obj_get_height(content) - lv_obj_get_height(viewport));
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <lvgl/lvgl.h>
+
+namespace Pinetime {
+  namespace Components {
+    class LittleVgl;
+  }
+
+  namespace Applications {
+    namespace Widgets {
+      // Viewport on content taller than the screen, from a given line to the bottom of the screen.
+      //
+      // The content is scrolled with the vertical scrolling of the display: the lines already drawn are shifted in the
+      // display memory, and LVGL only draws the lines exposed by each step and the fixed lines above the viewport.
+      class ScrollView {
+      public:
+        explicit ScrollView(Components::LittleVgl& lvgl);
+        ~ScrollView();
+
+        void Create(lv_obj_t* parent, lv_coord_t y);
+
+        // Objects to scroll are created in the content, its height must be set once they are created
+        lv_obj_t* GetContent() const {
+          return content;
+        }
+
+        bool IsScrollable() const {
+          return content != nullptr && MaxPosition() > 0;
+        }
+
+        // Scrolls by at most lines (positive: towards the end of the content) in a short animation.
+        // Returns false if the content is already at that end.
+        bool Scroll(lv_coord_t lines);
+
+      private:
+        static void ScrollAnimationCallback(void* scrollView, lv_anim_value_t position);
+        void SetPosition(lv_coord_t newPosition);
+        lv_coord_t MaxPosition() const;
+
+        static constexpr uint16_t animationTime = 200;
+
+        Components::LittleVgl& lvgl;
+        lv_obj_t* viewport = nullptr;
+        lv_obj_t* content = nullptr;
+        lv_coord_t top = 0;
+        lv_coord_t position = 0;
+        lv_coord_t target = 0;
+      };
+    }
+  }
+}
@@ -0,0 +1,126 @@
+#include "displayapp/widgets/StaticLayer.h"
+#include <algorithm>
+#include <bitset>
+#include <cstdio>
+#include <FreeRTOS.h>
+#include "components/fs/FS.h"
+#include "displayapp/LittleVgl.h"
+
+using namespace Pinetime::Applications::Widgets;
+
+namespace {
+  constexpr const char* layersDirectory = "/layers";
+}
+
+StaticLayer::StaticLayer(Components::LittleVgl& lvgl, Controllers::FS& filesystem, const char* path, uint32_t key)
+  : lvgl {lvgl}, filesystem {filesystem}, path {path}, key {key} {
+}
+
+bool StaticLayer::Load() {
+  stored = IsStored();
+  return stored;
+}
+
+bool StaticLayer::Capture(std::initializer_list<lv_obj_t*> staticObjects) {
+  if (lvgl.IsScrolling()) {
+    return false;
+  }
+  // Another instance of the screen might have captured the layer already
+  if (IsStored()) {
+    return true;
+  }
+
+  // The layer would contain objects that change, it is never captured
+  bool misplaced = ContainsOtherObjects(staticObjects);
+  ASSERT(!misplaced);
+  lv_obj_t* screen = lv_scr_act();
+  if (lv_obj_count_children(screen) > maxObjects || misplaced) {
+    return true;
+  }
+
+  std::bitset<maxObjects> hidden;
+  size_t index = 0;
+  for (lv_obj_t* child = lv_obj_get_child(screen, nullptr); child != nullptr; child = lv_obj_get_child(screen, child), index++) {
+    if (!IsStatic(staticObjects, child) && !lv_obj_get_hidden(child)) {
+      lv_obj_set_hidden(child, true);
+      hidden.set(index);
+    }
+  }
+
+  filesystem.DirCreate(layersDirectory);
+  if (lvgl.CaptureScreen(path)) {
+    StoreKey();
+  }
+
+  index = 0;
+  for (lv_obj_t* child = lv_obj_get_child(screen, nullptr); child != nullptr; child = lv_obj_get_child(screen, child), index++) {
+    if (hidden.test(index)) {
+      lv_obj_set_hidden(child, false);
+    }
+  }
+  // The display still shows all the objects, they don't need to be drawn again
+  lv_disp_get_default()->inv_p = 0;
+  return true;
+}
+
+void StaticLayer::StoreKey() {
+  // The key is stored after the image, DrawImage() only reads the lines of the display
+  lfs_file_t file;
+  if (filesystem.FileOpen(&file, path, LFS_O_WRONLY | LFS_O_APPEND) != LFS_ERR_OK) {
+    return;
+  }
+  bool written = filesystem.FileWrite(&file, reinterpret_cast<const uint8_t*>(&key), sizeof(key)) == sizeof(key);
+  filesystem.FileClose(&file);
+  if (!written) {
+    filesystem.FileDelete(path);
+  }
+}
+
+void StaticLayer::Draw(std::initializer_list<lv_obj_t*> staticObjects) {
+  if (!stored || !lvgl.DrawImage(path)) {
+    // LVGL draws the whole screen, including the static objects
+    return;
+  }
+
+  // The static objects are already on the display, only the other objects are drawn by LVGL
+  lv_disp_get_default()->inv_p = 0;
+  lv_obj_t* screen = lv_scr_act();
+  for (lv_obj_t* child = lv_obj_get_child(screen, nullptr); child != nullptr; child = lv_obj_get_child(screen, child)) {
+    if (!IsStatic(staticObjects, child)) {
+      lv_obj_invalidate(child);
+    }
+  }
+}
+
+bool StaticLayer::IsStored() {
+  lfs_file_t file;
+  if (filesystem.FileOpen(&file, path, LFS_O_RDONLY) != LFS_ERR_OK) {
+    return false;
+  }
+
+  uint32_t storedKey = 0;
+  bool stored = filesystem.FileSize(&file) == static_cast<int>(imageSize + sizeof(storedKey)) &&
+                filesystem.FileSeek(&file, imageSize) >= 0 &&
+                filesystem.FileRead(&file, reinterpret_cast<uint8_t*>(&storedKey), sizeof(storedKey)) == sizeof(storedKey) &&
+                storedKey == key;
+  filesystem.FileClose(&file);
+  return stored;
+}
+
+bool StaticLayer::IsStatic(std::initializer_list<lv_obj_t*> staticObjects, lv_obj_t* object) {
+  return std::find(staticObjects.begin(), staticObjects.end(), object) != staticObjects.end();
+}
+
+bool StaticLayer::ContainsOtherObjects(std::initializer_list<lv_obj_t*> staticObjects) {
+  for (lv_obj_t* object : staticObjects) {
+    if (lv_obj_get_parent(object) != lv_scr_act()) {
+      return true;
+    }
+    for (lv_obj_t* child = lv_obj_get_child(object, nullptr); child != nullptr; child = lv_obj_get_child(object, child)) {
+      if (!IsStatic(staticObjects, child)) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <lvgl/lvgl.h>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+
+namespace Pinetime {
+  namespace Components {
+    class LittleVgl;
+  }
+
+  namespace Controllers {
+    class FS;
+  }
+
+  namespace Applications {
+    namespace Widgets {
+      // Pre-rendered background of a screen, stored in the filesystem.
+      //
+      // The first time a screen is shown, the objects that never change (the static layer) are rendered alone and
+      // captured to a file. On the next loads, the file is sent to the display directly and LVGL only draws the areas of
+      // the other objects. The static objects stay on the screen and LVGL draws them under the other objects, and
+      // everywhere once the screen changes: the file is only read once, for the first frame. The layer is captured again
+      // when its key changes, the key must identify the settings the static objects depend on.
+      //
+      // The static objects must be children of the screen, and must not contain any other object: the other objects
+      // would be captured with them.
+      class StaticLayer {
+      public:
+        StaticLayer(Components::LittleVgl& lvgl, Controllers::FS& filesystem, const char* path, uint32_t key);
+
+        // Returns false if no layer matching the key is stored, the static objects must then be captured
+        bool Load();
+        // Captures the layer once the screen is on the display. The other objects of the screen are hidden while the
+        // static objects are rendered to the file, the display is not updated.
+        // Returns false if a screen transition is running and the capture must be tried again later.
+        bool Capture(std::initializer_list<lv_obj_t*> staticObjects);
+        // Called at the end of the creation of the screen: sends the stored layer to the display, and only the other
+        // objects are drawn by LVGL in the first frame
+        void Draw(std::initializer_list<lv_obj_t*> staticObjects);
+
+      private:
+        static constexpr size_t imageSize = sizeof(lv_img_header_t) + (LV_HOR_RES_MAX * LV_VER_RES_MAX * sizeof(lv_color_t));
+        static constexpr size_t maxPathLength = 32;
+        static constexpr size_t maxObjects = 64;
+
+        bool IsStored();
+        void StoreKey();
+        static bool IsStatic(std::initializer_list<lv_obj_t*> staticObjects, lv_obj_t* object);
+        static bool ContainsOtherObjects(std::initializer_list<lv_obj_t*> staticObjects);
+
+        Components::LittleVgl& lvgl;
+        Controllers::FS& filesystem;
+        const char* path;
+        const uint32_t key;
+        bool stored = false;
+      };
+    }
+  }
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include <cstdint>
+
+#include "nrf_ppi.h"
+
+namespace Pinetime {
+  // Allocation of the PPI channels and channel groups. The channels not listed here are taken by NimBLE (4, 5 and 17 to 31,
+  // see ble_phy.c) or free: channels 9 to 16 are free to use.
+  namespace PpiMap {
+    // SpiMaster: erratum workaround (single byte transfers)
+    static constexpr nrf_ppi_channel_t SpiWorkaround = NRF_PPI_CHANNEL0;
+
+    // BrightnessController: backlight PWM
+    static constexpr nrf_ppi_channel_t BacklightOn = NRF_PPI_CHANNEL1;
+    static constexpr nrf_ppi_channel_t BacklightOff = NRF_PPI_CHANNEL2;
+
+    // SpiMaster: ArrayList transfers
+    static constexpr nrf_ppi_channel_t SpiListChain = NRF_PPI_CHANNEL3;
+    static constexpr nrf_ppi_channel_t SpiListCount = NRF_PPI_CHANNEL6;
+    static constexpr nrf_ppi_channel_t SpiListLast = NRF_PPI_CHANNEL7;
+    static constexpr nrf_ppi_channel_t SpiListStop = NRF_PPI_CHANNEL8;
+    static constexpr nrf_ppi_channel_group_t SpiListChainGroup = NRF_PPI_CHANNEL_GROUP0;
+
+    namespace Details {
+      constexpr uint32_t Mask(nrf_ppi_channel_t channel) {
+        return 1UL << channel;
+      }
+
+      static constexpr nrf_ppi_channel_t channels[] {
+        SpiWorkaround, BacklightOn, BacklightOff, SpiListChain, SpiListCount, SpiListLast, SpiListStop};
+
+      constexpr bool Unique() {
+        uint32_t used = 0;
+        for (auto channel : channels) {
+          if ((used & Mask(channel)) != 0) {
+            return false;
+          }
+          used |= Mask(channel);
+        }
+        return true;
+      }
+
+      constexpr bool FreeOfNimble() {
+        constexpr uint32_t nimbleChannels = Mask(NRF_PPI_CHANNEL4) | Mask(NRF_PPI_CHANNEL5) | 0xfffe0000UL;
+        for (auto channel : channels) {
+          if ((nimbleChannels & Mask(channel)) != 0) {
+            return false;
+          }
+        }
+        return true;
+      }
+    }
+
+    static_assert(Details::Unique(), "A PPI channel is allocated twice");
+    static_assert(Details::FreeOfNimble(), "A PPI channel is used by NimBLE");
+  }
+}
@@ -4,17 +4,21 @@
 
 using namespace Pinetime::Drivers;
 
-Spi::Spi(SpiMaster& spiMaster, uint8_t pinCsn) : spiMaster {spiMaster}, pinCsn {pinCsn} {
+Spi::Spi(SpiMaster& spiMaster, uint8_t pinCsn, SpiMaster::Priority priority)
+  : spiMaster {spiMaster}, pinCsn {pinCsn}, priority {priority} {
   nrf_gpio_cfg_output(pinCsn);
   nrf_gpio_pin_set(pinCsn);
 }
 
-bool Spi::Write(const uint8_t* data, size_t size, const std::function<void()>& preTransactionHook) {
-  return spiMaster.Write(pinCsn, data, size, preTransactionHook);
+bool Spi::Write(const uint8_t* data,
+                size_t size,
+                const std::function<void()>& preTransactionHook,
+                const std::function<void()>& postTransactionHook) {
+  return spiMaster.Write(pinCsn, priority, data, size, preTransactionHook, postTransactionHook);
 }
 
 bool Spi::Read(uint8_t* cmd, size_t cmdSize, uint8_t* data, size_t dataSize) {
-  return spiMaster.Read(pinCsn, cmd, cmdSize, data, dataSize);
+  return spiMaster.Read(pinCsn, priority, cmd, cmdSize, data, dataSize);
 }
 
 void Spi::Sleep() {
@@ -23,7 +27,7 @@ void Spi::Sleep() {
 }
 
 bool Spi::WriteCmdAndBuffer(const uint8_t* cmd, size_t cmdSize, const uint8_t* data, size_t dataSize) {
-  return spiMaster.WriteCmdAndBuffer(pinCsn, cmd, cmdSize, data, dataSize);
+  return spiMaster.WriteCmdAndBuffer(pinCsn, priority, cmd, cmdSize, data, dataSize);
 }
 
 bool Spi::Init() {
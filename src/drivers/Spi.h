@@ -8,14 +8,17 @@ namespace Pinetime {
   namespace Drivers {
     class Spi {
     public:
-      Spi(SpiMaster& spiMaster, uint8_t pinCsn);
+      Spi(SpiMaster& spiMaster, uint8_t pinCsn, SpiMaster::Priority priority);
       Spi(const Spi&) = delete;
       Spi& operator=(const Spi&) = delete;
       Spi(Spi&&) = delete;
       Spi& operator=(Spi&&) = delete;
 
       bool Init();
-      bool Write(const uint8_t* data, size_t size, const std::function<void()>& preTransactionHook);
+      bool Write(const uint8_t* data,
+                 size_t size,
+                 const std::function<void()>& preTransactionHook,
+                 const std::function<void()>& postTransactionHook);
       bool Read(uint8_t* cmd, size_t cmdSize, uint8_t* data, size_t dataSize);
       bool WriteCmdAndBuffer(const uint8_t* cmd, size_t cmdSize, const uint8_t* data, size_t dataSize);
       void Sleep();
@@ -24,6 +27,7 @@ namespace Pinetime {
     private:
       SpiMaster& spiMaster;
       uint8_t pinCsn;
+      SpiMaster::Priority priority;
     };
   }
 }
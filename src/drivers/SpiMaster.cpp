@@ -6,13 +6,26 @@
 
 using namespace Pinetime::Drivers;
 
+namespace {
+  // EasyDMA and PPI take 32 bit addresses
+  uint32_t Address(const volatile void* pointer) {
+    return static_cast<uint32_t>(reinterpret_cast<uintptr_t>(pointer));
+  }
+}
+
 SpiMaster::SpiMaster(const SpiMaster::SpiModule spi, const SpiMaster::Parameters& params) : spi {spi}, params {params} {
 }
 
 bool SpiMaster::Init() {
-  if (mutex == nullptr) {
-    mutex = xSemaphoreCreateBinary();
-    ASSERT(mutex != nullptr);
+  for (auto& grant : busGrant) {
+    if (grant == nullptr) {
+      grant = xSemaphoreCreateBinary();
+      ASSERT(grant != nullptr);
+    }
+  }
+  if (transferDone == nullptr) {
+    transferDone = xSemaphoreCreateBinary();
+    ASSERT(transferDone != nullptr);
   }
 
   /* Configure GPIO pins used for pselsck, pselmosi, pselmiso and pselss for SPI0 */
@@ -83,17 +96,105 @@ bool SpiMaster::Init() {
 
   spiBaseAddress->INTENSET = ((unsigned) 1 << (unsigned) 6);
   spiBaseAddress->INTENSET = ((unsigned) 1 << (unsigned) 1);
-  spiBaseAddress->INTENSET = ((unsigned) 1 << (unsigned) 19);
+  // OnStartedEvent() has nothing to do: the STARTED interrupt would double the interrupts of a transfer and
+  // interrupt every chunk of an ArrayList
+  spiBaseAddress->INTENCLR = ((unsigned) 1 << (unsigned) 19);
 
   spiBaseAddress->ENABLE = (SPIM_ENABLE_ENABLE_Enabled << SPIM_ENABLE_ENABLE_Pos);
 
   NRFX_IRQ_PRIORITY_SET(SPIM0_SPIS0_TWIM0_TWIS0_SPI0_TWI0_IRQn, 2);
   NRFX_IRQ_ENABLE(SPIM0_SPIS0_TWIM0_TWIS0_SPI0_TWI0_IRQn);
 
-  xSemaphoreGive(mutex);
+  SetupListTransfer();
+
   return true;
 }
 
+void SpiMaster::SetupListTransfer() {
+  listTimer->TASKS_STOP = 1;
+  listTimer->MODE = TIMER_MODE_MODE_Counter;
+  listTimer->BITMODE = TIMER_BITMODE_BITMODE_16Bit;
+  listTimer->INTENCLR = 0xFFFFFFFF;
+
+  nrf_ppi_channel_endpoint_setup(listChainPpi,
+                                 Address(&spiBaseAddress->EVENTS_END),
+                                 Address(&spiBaseAddress->TASKS_START));
+  nrf_ppi_channel_endpoint_setup(listCountPpi,
+                                 Address(&spiBaseAddress->EVENTS_END),
+                                 Address(&listTimer->TASKS_COUNT));
+  nrf_ppi_channel_endpoint_setup(listLastPpi,
+                                 Address(&listTimer->EVENTS_COMPARE[0]),
+                                 Address(&NRF_PPI->TASKS_CHG[listChainGroup].DIS));
+  nrf_ppi_channel_endpoint_setup(listStopPpi,
+                                 Address(&listTimer->EVENTS_COMPARE[1]),
+                                 Address(&spiBaseAddress->TASKS_STOP));
+  nrf_ppi_channel_include_in_group(listChainPpi, listChainGroup);
+  nrf_ppi_group_disable(listChainGroup);
+  nrf_ppi_channel_disable(listCountPpi);
+  nrf_ppi_channel_disable(listLastPpi);
+  nrf_ppi_channel_disable(listStopPpi);
+  listTransferActive = false;
+}
+
+// Returns the size of the chunks used to transfer a buffer in ArrayList mode, or 0 if it
+// should be transferred chunk by chunk. All the chunks of a list have the same size, so prefer
+// a size that divides the buffer (a 240px wide band is sent in 240 byte chunks). Otherwise
+// the remainder is sent as a separate transaction after the list.
+size_t SpiMaster::ListChunkSize(size_t size) {
+  if (size < 2 * maxChunkSize) {
+    return 0;
+  }
+  for (size_t chunkSize = maxChunkSize; chunkSize >= minListChunkSize; chunkSize--) {
+    if (size % chunkSize == 0) {
+      return chunkSize;
+    }
+  }
+  return maxChunkSize;
+}
+
+void SpiMaster::StartListTransfer(uint32_t bufferAddress, size_t chunkSize, size_t chunkCount) {
+  if (currentDirection == TransferDirection::Rx) {
+    PrepareRx(bufferAddress, chunkSize);
+    spiBaseAddress->RXD.LIST = SPIM_RXD_LIST_LIST_ArrayList << SPIM_RXD_LIST_LIST_Pos;
+  } else {
+    PrepareTx(bufferAddress, chunkSize);
+    spiBaseAddress->TXD.LIST = SPIM_TXD_LIST_LIST_ArrayList << SPIM_TXD_LIST_LIST_Pos;
+  }
+  spiBaseAddress->EVENTS_STOPPED = 0;
+
+  listTimer->TASKS_CLEAR = 1;
+  listTimer->EVENTS_COMPARE[0] = 0;
+  listTimer->EVENTS_COMPARE[1] = 0;
+  listTimer->CC[0] = chunkCount - 1;
+  listTimer->CC[1] = chunkCount;
+  listTimer->TASKS_START = 1;
+
+  // Only the STOPPED event at the end of the list should interrupt the CPU
+  spiBaseAddress->INTENCLR = (1 << 6);
+  listTransferActive = true;
+
+  nrf_ppi_group_enable(listChainGroup);
+  nrf_ppi_channel_enable(listCountPpi);
+  nrf_ppi_channel_enable(listLastPpi);
+  nrf_ppi_channel_enable(listStopPpi);
+
+  spiBaseAddress->TASKS_START = 1;
+}
+
+void SpiMaster::StopListTransfer() {
+  nrf_ppi_group_disable(listChainGroup);
+  nrf_ppi_channel_disable(listCountPpi);
+  nrf_ppi_channel_disable(listLastPpi);
+  nrf_ppi_channel_disable(listStopPpi);
+  listTimer->TASKS_STOP = 1;
+
+  listTransferActive = false;
+  spiBaseAddress->TXD.LIST = 0;
+  spiBaseAddress->RXD.LIST = 0;
+  spiBaseAddress->EVENTS_END = 0;
+  spiBaseAddress->INTENSET = (1 << 6);
+}
+
 void SpiMaster::SetupWorkaroundForErratum58() {
   nrfx_gpiote_pin_t pin = spiBaseAddress->PSEL.SCK;
   nrfx_gpiote_in_config_t gpioteCfg = {.sense = NRF_GPIOTE_POLARITY_TOGGLE,
@@ -127,11 +228,12 @@ void SpiMaster::DisableWorkaroundForErratum58() {
     nrf_ppi_channel_disable(workaroundPpi);
   }
   spiBaseAddress->EVENTS_END = 0;
+  // The workaround stops the SPIM, don't mistake it for the end of a list transfer
+  spiBaseAddress->EVENTS_STOPPED = 0;
 
   // Enable IRQ
   spiBaseAddress->INTENSET = (1 << 6);
   spiBaseAddress->INTENSET = (1 << 1);
-  spiBaseAddress->INTENSET = (1 << 19);
   workaroundActive = false;
 }
 
@@ -140,10 +242,43 @@ void SpiMaster::OnEndEvent() {
     return;
   }
 
+  statistics.interrupts++;
+  ContinueTransfer();
+}
+
+void SpiMaster::OnStoppedEvent() {
+  if (!listTransferActive) {
+    return;
+  }
+
+  statistics.interrupts++;
+  StopListTransfer();
+  ContinueTransfer();
+}
+
+void SpiMaster::ContinueTransfer() {
+  if (currentBufferSize == 0 && nextBufferSize > 0) {
+    currentBufferAddr = nextBufferAddr;
+    currentBufferSize = nextBufferSize;
+    currentDirection = nextDirection;
+    nextBufferSize = 0;
+  }
+
   auto s = currentBufferSize;
-  if (s > 0) {
-    auto currentSize = std::min((size_t) 255, s);
-    PrepareTx(currentBufferAddr, currentSize);
+  auto listChunkSize = ListChunkSize(s);
+  if (listChunkSize > 0) {
+    auto listChunkCount = s / listChunkSize;
+    auto listAddress = currentBufferAddr;
+    currentBufferAddr = currentBufferAddr + (listChunkSize * listChunkCount);
+    currentBufferSize = s - (listChunkSize * listChunkCount);
+    StartListTransfer(listAddress, listChunkSize, listChunkCount);
+  } else if (s > 0) {
+    auto currentSize = std::min(maxChunkSize, s);
+    if (currentDirection == TransferDirection::Rx) {
+      PrepareRx(currentBufferAddr, currentSize);
+    } else {
+      PrepareTx(currentBufferAddr, currentSize);
+    }
     currentBufferAddr = currentBufferAddr + currentSize;
     currentBufferSize = currentBufferSize - currentSize;
 
@@ -151,8 +286,16 @@ void SpiMaster::OnEndEvent() {
   } else {
     nrf_gpio_pin_set(this->pinCsn);
     currentBufferAddr = 0;
+    if (postTransactionHook != nullptr) {
+      postTransactionHook();
+    }
     BaseType_t xHigherPriorityTaskWoken = pdFALSE;
-    xSemaphoreGiveFromISR(mutex, &xHigherPriorityTaskWoken);
+    if (waitingForTransfer) {
+      waitingForTransfer = false;
+      xSemaphoreGiveFromISR(transferDone, &xHigherPriorityTaskWoken);
+    } else {
+      ReleaseBusFromISR(&xHigherPriorityTaskWoken);
+    }
     portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
   }
 }
@@ -180,13 +323,81 @@ void SpiMaster::PrepareRx(const uint32_t bufferAddress, const size_t size) {
   spiBaseAddress->EVENTS_END = 0;
 }
 
-bool SpiMaster::Write(uint8_t pinCsn, const uint8_t* data, size_t size, const std::function<void()>& preTransactionHook) {
-  if (data == nullptr)
+void SpiMaster::AcquireBus(Priority priority) {
+  auto index = static_cast<size_t>(priority);
+  TickType_t start = xTaskGetTickCount();
+
+  taskENTER_CRITICAL();
+  bool mustWait = busOwned;
+  if (mustWait) {
+    busWaiters[index]++;
+  } else {
+    busOwned = true;
+  }
+  taskEXIT_CRITICAL();
+
+  if (mustWait) {
+    auto ok = xSemaphoreTake(busGrant[index], portMAX_DELAY);
+    ASSERT(ok == true);
+  }
+
+  TickType_t waited = xTaskGetTickCount() - start;
+  auto& latency = statistics.latency[index];
+  latency.transactions++;
+  latency.totalTicks += waited;
+  latency.maxTicks = std::max(latency.maxTicks, waited);
+  statistics.stallTicks += waited;
+}
+
+// Returns the index of the highest priority class waiting for the bus, or -1 if none.
+// Must be called in a critical section.
+int SpiMaster::NextBusOwner() {
+  for (size_t i = 0; i < nbPriorities; i++) {
+    if (busWaiters[i] > 0) {
+      busWaiters[i]--;
+      return i;
+    }
+  }
+  busOwned = false;
+  return -1;
+}
+
+void SpiMaster::ReleaseBus() {
+  taskENTER_CRITICAL();
+  int next = NextBusOwner();
+  taskEXIT_CRITICAL();
+
+  if (next >= 0) {
+    xSemaphoreGive(busGrant[next]);
+  }
+}
+
+void SpiMaster::ReleaseBusFromISR(BaseType_t* higherPriorityTaskWoken) {
+  auto status = taskENTER_CRITICAL_FROM_ISR();
+  int next = NextBusOwner();
+  taskEXIT_CRITICAL_FROM_ISR(status);
+
+  if (next >= 0) {
+    xSemaphoreGiveFromISR(busGrant[next], higherPriorityTaskWoken);
+  }
+}
+
+bool SpiMaster::Write(uint8_t pinCsn,
+                      Priority priority,
+                      const uint8_t* data,
+                      size_t size,
+                      const std::function<void()>& preTransactionHook,
+                      const std::function<void()>& postTransactionHook) {
+  if (data == nullptr || size == 0)
     return false;
-  auto ok = xSemaphoreTake(mutex, portMAX_DELAY);
-  ASSERT(ok == true);
+  AcquireBus(priority);
+  statistics.bytesTransferred += size;
 
   this->pinCsn = pinCsn;
+  this->postTransactionHook = postTransactionHook;
+  currentDirection = TransferDirection::Tx;
+  nextBufferSize = 0;
+  waitingForTransfer = false;
 
   if (size == 1) {
     SetupWorkaroundForErratum58();
@@ -199,58 +410,29 @@ bool SpiMaster::Write(uint8_t pinCsn, const uint8_t* data, size_t size, const st
   }
   nrf_gpio_pin_clear(this->pinCsn);
 
-  currentBufferAddr = (uint32_t) data;
+  currentBufferAddr = Address(data);
   currentBufferSize = size;
-
-  auto currentSize = std::min((size_t) 255, (size_t) currentBufferSize);
-  PrepareTx(currentBufferAddr, currentSize);
-  currentBufferSize = currentBufferSize - currentSize;
-  currentBufferAddr = currentBufferAddr + currentSize;
-  spiBaseAddress->TASKS_START = 1;
+  ContinueTransfer();
 
   if (size == 1) {
     while (spiBaseAddress->EVENTS_END == 0)
       ;
     nrf_gpio_pin_set(this->pinCsn);
     currentBufferAddr = 0;
+    if (this->postTransactionHook != nullptr) {
+      this->postTransactionHook();
+    }
 
     DisableWorkaroundForErratum58();
 
-    xSemaphoreGive(mutex);
+    ReleaseBus();
   }
 
   return true;
 }
 
-bool SpiMaster::Read(uint8_t pinCsn, uint8_t* cmd, size_t cmdSize, uint8_t* data, size_t dataSize) {
-  xSemaphoreTake(mutex, portMAX_DELAY);
-
-  this->pinCsn = pinCsn;
-  DisableWorkaroundForErratum58();
-  spiBaseAddress->INTENCLR = (1 << 6);
-  spiBaseAddress->INTENCLR = (1 << 1);
-  spiBaseAddress->INTENCLR = (1 << 19);
-
-  nrf_gpio_pin_clear(this->pinCsn);
-
-  currentBufferAddr = 0;
-  currentBufferSize = 0;
-
-  PrepareTx((uint32_t) cmd, cmdSize);
-  spiBaseAddress->TASKS_START = 1;
-  while (spiBaseAddress->EVENTS_END == 0)
-    ;
-
-  PrepareRx((uint32_t) data, dataSize);
-  spiBaseAddress->TASKS_START = 1;
-
-  while (spiBaseAddress->EVENTS_END == 0)
-    ;
-  nrf_gpio_pin_set(this->pinCsn);
-
-  xSemaphoreGive(mutex);
-
-  return true;
+bool SpiMaster::Read(uint8_t pinCsn, Priority priority, uint8_t* cmd, size_t cmdSize, uint8_t* data, size_t dataSize) {
+  return TransferCmdAndBuffer(pinCsn, priority, cmd, cmdSize, Address(data), dataSize, TransferDirection::Rx);
 }
 
 void SpiMaster::Sleep() {
@@ -269,33 +451,46 @@ void SpiMaster::Wakeup() {
   NRF_LOG_INFO("[SPIMASTER] Wakeup");
 }
 
-bool SpiMaster::WriteCmdAndBuffer(uint8_t pinCsn, const uint8_t* cmd, size_t cmdSize, const uint8_t* data, size_t dataSize) {
-  xSemaphoreTake(mutex, portMAX_DELAY);
+bool SpiMaster::WriteCmdAndBuffer(
+  uint8_t pinCsn, Priority priority, const uint8_t* cmd, size_t cmdSize, const uint8_t* data, size_t dataSize) {
+  return TransferCmdAndBuffer(pinCsn, priority, cmd, cmdSize, Address(data), dataSize, TransferDirection::Tx);
+}
+
+// Sends the command and then sends or receives the data while keeping CS low. The transfer
+// is driven by the END interrupt, the calling task sleeps until it is done.
+bool SpiMaster::TransferCmdAndBuffer(uint8_t pinCsn,
+                                     Priority priority,
+                                     const uint8_t* cmd,
+                                     size_t cmdSize,
+                                     uint32_t dataAddress,
+                                     size_t dataSize,
+                                     TransferDirection dataDirection) {
+  if (cmdSize + dataSize == 0) {
+    return true;
+  }
+
+  AcquireBus(priority);
+  statistics.bytesTransferred += cmdSize + dataSize;
 
   this->pinCsn = pinCsn;
+  this->postTransactionHook = nullptr;
   DisableWorkaroundForErratum58();
-  spiBaseAddress->INTENCLR = (1 << 6);
-  spiBaseAddress->INTENCLR = (1 << 1);
-  spiBaseAddress->INTENCLR = (1 << 19);
 
   nrf_gpio_pin_clear(this->pinCsn);
 
-  currentBufferAddr = 0;
-  currentBufferSize = 0;
+  currentBufferAddr = Address(cmd);
+  currentBufferSize = cmdSize;
+  currentDirection = TransferDirection::Tx;
+  nextBufferAddr = dataAddress;
+  nextBufferSize = dataSize;
+  nextDirection = dataDirection;
+  waitingForTransfer = true;
+  ContinueTransfer();
 
-  PrepareTx((uint32_t) cmd, cmdSize);
-  spiBaseAddress->TASKS_START = 1;
-  while (spiBaseAddress->EVENTS_END == 0)
-    ;
-
-  PrepareTx((uint32_t) data, dataSize);
-  spiBaseAddress->TASKS_START = 1;
-
-  while (spiBaseAddress->EVENTS_END == 0)
-    ;
-  nrf_gpio_pin_set(this->pinCsn);
+  auto ok = xSemaphoreTake(transferDone, portMAX_DELAY);
+  ASSERT(ok == true);
 
-  xSemaphoreGive(mutex);
+  ReleaseBus();
 
   return true;
 }
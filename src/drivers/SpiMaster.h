@@ -1,4 +1,5 @@
 #pragma once
+#include <array>
 #include <cstddef>
 #include <cstdint>
 #include <functional>
@@ -8,6 +9,7 @@
 #include <task.h>
 #include "nrfx_gpiote.h"
 #include "nrf_ppi.h"
+#include "drivers/PpiMap.h"
 
 namespace Pinetime {
   namespace Drivers {
@@ -18,6 +20,25 @@ namespace Pinetime {
       enum class Modes : uint8_t { Mode0, Mode1, Mode2, Mode3 };
       enum class Frequencies : uint8_t { Freq8Mhz };
 
+      // When several clients are waiting for the bus, it is handed to the one with the highest
+      // priority (lowest value) once the current transaction is done.
+      enum class Priority : uint8_t { Display, Storage, Background };
+      static constexpr size_t nbPriorities = 3;
+
+      struct Latency {
+        uint32_t transactions = 0;
+        uint32_t totalTicks = 0;
+        uint32_t maxTicks = 0;
+      };
+
+      struct Statistics {
+        uint32_t bytesTransferred = 0;
+        uint32_t interrupts = 0;
+        // Time spent by tasks waiting for the bus to be available, in ticks
+        uint32_t stallTicks = 0;
+        std::array<Latency, nbPriorities> latency;
+      };
+
       struct Parameters {
         BitOrder bitOrder;
         Modes mode;
@@ -34,22 +55,52 @@ namespace Pinetime {
       SpiMaster& operator=(SpiMaster&&) = delete;
 
       bool Init();
-      bool Write(uint8_t pinCsn, const uint8_t* data, size_t size, const std::function<void()>& preTransactionHook);
-      bool Read(uint8_t pinCsn, uint8_t* cmd, size_t cmdSize, uint8_t* data, size_t dataSize);
+      // postTransactionHook is called from the SPI interrupt once the last byte has been sent
+      bool Write(uint8_t pinCsn,
+                 Priority priority,
+                 const uint8_t* data,
+                 size_t size,
+                 const std::function<void()>& preTransactionHook,
+                 const std::function<void()>& postTransactionHook);
+      bool Read(uint8_t pinCsn, Priority priority, uint8_t* cmd, size_t cmdSize, uint8_t* data, size_t dataSize);
 
-      bool WriteCmdAndBuffer(uint8_t pinCsn, const uint8_t* cmd, size_t cmdSize, const uint8_t* data, size_t dataSize);
+      bool WriteCmdAndBuffer(
+        uint8_t pinCsn, Priority priority, const uint8_t* cmd, size_t cmdSize, const uint8_t* data, size_t dataSize);
 
       void OnStartedEvent();
       void OnEndEvent();
+      void OnStoppedEvent();
+
+      Statistics GetStatistics() const {
+        return statistics;
+      }
 
       void Sleep();
       void Wakeup();
 
     private:
+      enum class TransferDirection : uint8_t { Tx, Rx };
+
       void SetupWorkaroundForErratum58();
       void DisableWorkaroundForErratum58();
-      void PrepareTx(const volatile uint32_t bufferAddress, const volatile size_t size);
-      void PrepareRx(const volatile uint32_t bufferAddress, const volatile size_t size);
+      void PrepareTx(uint32_t bufferAddress, size_t size);
+      void PrepareRx(uint32_t bufferAddress, size_t size);
+      void AcquireBus(Priority priority);
+      void ReleaseBus();
+      void ReleaseBusFromISR(BaseType_t* higherPriorityTaskWoken);
+      int NextBusOwner();
+      void SetupListTransfer();
+      void StartListTransfer(uint32_t bufferAddress, size_t chunkSize, size_t chunkCount);
+      void StopListTransfer();
+      void ContinueTransfer();
+      bool TransferCmdAndBuffer(uint8_t pinCsn,
+                                Priority priority,
+                                const uint8_t* cmd,
+                                size_t cmdSize,
+                                uint32_t dataAddress,
+                                size_t dataSize,
+                                TransferDirection dataDirection);
+      static size_t ListChunkSize(size_t size);
 
       NRF_SPIM_Type* spiBaseAddress;
       uint8_t pinCsn;
@@ -59,9 +110,41 @@ namespace Pinetime {
 
       volatile uint32_t currentBufferAddr = 0;
       volatile size_t currentBufferSize = 0;
-      SemaphoreHandle_t mutex = nullptr;
-      static constexpr nrf_ppi_channel_t workaroundPpi = NRF_PPI_CHANNEL0;
+      volatile TransferDirection currentDirection = TransferDirection::Tx;
+      // Data phase of Read() and WriteCmdAndBuffer(), started once the command has been sent
+      volatile uint32_t nextBufferAddr = 0;
+      volatile size_t nextBufferSize = 0;
+      volatile TransferDirection nextDirection = TransferDirection::Tx;
+      std::function<void()> postTransactionHook;
+
+      // The bus is owned from AcquireBus() until the end of the transaction. On release, ownership
+      // is passed directly to a waiting client by giving its semaphore, so a lower priority client
+      // cannot take the bus in between.
+      bool busOwned = false;
+      std::array<uint8_t, nbPriorities> busWaiters {};
+      std::array<SemaphoreHandle_t, nbPriorities> busGrant {};
+
+      // Given from the ISR when a blocking transfer is done, the caller then releases the bus
+      SemaphoreHandle_t transferDone = nullptr;
+      volatile bool waitingForTransfer = false;
+      static constexpr nrf_ppi_channel_t workaroundPpi = PpiMap::SpiWorkaround;
       bool workaroundActive = false;
+
+      // EasyDMA can only move 255 bytes per transaction. Longer buffers are moved as an ArrayList:
+      // END restarts the SPIM (listChainPpi) and is counted by listTimer. Once the last chunk has
+      // started, the chain is cut (listLastPpi) and the end of the last chunk stops the SPIM
+      // (listStopPpi), which raises a single STOPPED interrupt for the whole list.
+      static constexpr size_t maxChunkSize = 255;
+      static constexpr size_t minListChunkSize = 128;
+      static constexpr nrf_ppi_channel_t listChainPpi = PpiMap::SpiListChain;
+      static constexpr nrf_ppi_channel_t listCountPpi = PpiMap::SpiListCount;
+      static constexpr nrf_ppi_channel_t listLastPpi = PpiMap::SpiListLast;
+      static constexpr nrf_ppi_channel_t listStopPpi = PpiMap::SpiListStop;
+      static constexpr nrf_ppi_channel_group_t listChainGroup = PpiMap::SpiListChainGroup;
+      NRF_TIMER_Type* const listTimer = NRF_TIMER3;
+      volatile bool listTransferActive = false;
+
+      Statistics statistics;
     };
   }
 }
@@ -1,4 +1,6 @@
 #include "drivers/SpiNorFlash.h"
+#include <algorithm>
+#include <cstring>
 #include <hal/nrf_gpio.h>
 #include <libraries/delay/nrf_delay.h>
 #include <libraries/log/nrf_log.h>
@@ -10,11 +12,53 @@ SpiNorFlash::SpiNorFlash(Spi& spi) : spi {spi} {
 }
 
 void SpiNorFlash::Init() {
+  if (mutex == nullptr) {
+    mutex = xSemaphoreCreateMutex();
+    ASSERT(mutex != nullptr);
+  }
+  if (writeMutex == nullptr) {
+    writeMutex = xSemaphoreCreateMutex();
+    ASSERT(writeMutex != nullptr);
+  }
+
   device_id = ReadIdentification();
   NRF_LOG_INFO("[SpiNorFlash] Manufacturer : %d, Memory type : %d, memory density : %d",
                device_id.manufacturer,
                device_id.type,
                device_id.density);
+  ProbeFastRead();
+}
+
+// Fast Read clocks the data out at higher frequencies than Read, at the cost of a dummy byte.
+// JESD216 requires every device with an SFDP table to support Fast Read, so the SFDP signature is checked first:
+// it is read with the same command, address and dummy byte framing as Fast Read, and is never erased.
+// Fast Read must then also return the same data as Read at the start of the flash. That data may be erased,
+// in which case only the SFDP check is meaningful.
+void SpiNorFlash::ProbeFastRead() {
+  static constexpr size_t probeSize = 16;
+  static constexpr uint8_t sfdpSignature[] = {'S', 'F', 'D', 'P'};
+  static constexpr uint8_t cmdSize = 5;
+  uint8_t cmd[cmdSize] = {static_cast<uint8_t>(Commands::ReadSfdp), 0, 0, 0, 0};
+  uint8_t signature[sizeof(sfdpSignature)];
+  uint8_t expected[probeSize];
+  uint8_t actual[probeSize];
+
+  fastRead = false;
+  spi.Read(cmd, cmdSize, signature, sizeof(signature));
+  if (std::memcmp(signature, sfdpSignature, sizeof(sfdpSignature)) != 0) {
+    NRF_LOG_INFO("[SpiNorFlash] Fast read : 0 (no SFDP)");
+    return;
+  }
+
+  ReadTransaction(0, expected, probeSize);
+  fastRead = true;
+  ReadTransaction(0, actual, probeSize);
+  fastRead = std::memcmp(expected, actual, probeSize) == 0;
+  NRF_LOG_INFO("[SpiNorFlash] Fast read : %d", fastRead);
+}
+
+bool SpiNorFlash::FastReadSupported() const {
+  return fastRead;
 }
 
 void SpiNorFlash::Uninit() {
@@ -22,7 +66,7 @@ void SpiNorFlash::Uninit() {
 
 void SpiNorFlash::Sleep() {
   auto cmd = static_cast<uint8_t>(Commands::DeepPowerDown);
-  spi.Write(&cmd, sizeof(uint8_t), nullptr);
+  spi.Write(&cmd, sizeof(uint8_t), nullptr, nullptr);
   NRF_LOG_INFO("[SpiNorFlash] Sleep")
 }
 
@@ -71,12 +115,46 @@ uint8_t SpiNorFlash::ReadConfigurationRegister() {
 }
 
 void SpiNorFlash::Read(uint32_t address, uint8_t* buffer, size_t size) {
-  static constexpr uint8_t cmdSize = 4;
-  uint8_t cmd[cmdSize] = {static_cast<uint8_t>(Commands::Read),
+  xSemaphoreTake(mutex, portMAX_DELAY);
+  bool suspended = SuspendErase();
+  // Large reads are split so that the display can get the bus between two chunks
+  while (size > 0) {
+    size_t toRead = std::min(size, maxReadSize);
+    ReadTransaction(address, buffer, toRead);
+    address += toRead;
+    buffer += toRead;
+    size -= toRead;
+  }
+  if (suspended) {
+    ResumeErase();
+  }
+  xSemaphoreGive(mutex);
+}
+
+void SpiNorFlash::StreamRead(uint32_t address, uint8_t* buffer, size_t size) {
+  xSemaphoreTake(mutex, portMAX_DELAY);
+  bool suspended = SuspendErase();
+  while (size > 0) {
+    size_t toRead = std::min(size, maxStreamReadSize);
+    ReadTransaction(address, buffer, toRead);
+    address += toRead;
+    buffer += toRead;
+    size -= toRead;
+  }
+  if (suspended) {
+    ResumeErase();
+  }
+  xSemaphoreGive(mutex);
+}
+
+void SpiNorFlash::ReadTransaction(uint32_t address, uint8_t* buffer, size_t size) {
+  static constexpr uint8_t cmdSize = 5;
+  uint8_t cmd[cmdSize] = {static_cast<uint8_t>(fastRead ? Commands::FastRead : Commands::Read),
                           static_cast<uint8_t>(address >> 16U),
                           static_cast<uint8_t>(address >> 8U),
-                          static_cast<uint8_t>(address)};
-  spi.Read(reinterpret_cast<uint8_t*>(&cmd), cmdSize, buffer, size);
+                          static_cast<uint8_t>(address),
+                          0}; // Dummy byte, only sent for FastRead
+  spi.Read(reinterpret_cast<uint8_t*>(&cmd), fastRead ? cmdSize : cmdSize - 1, buffer, size);
 }
 
 void SpiNorFlash::WriteEnable() {
@@ -85,20 +163,79 @@ void SpiNorFlash::WriteEnable() {
 }
 
 void SpiNorFlash::SectorErase(uint32_t sectorAddress) {
+  EraseRange(sectorAddress, sectorSize);
+}
+
+void SpiNorFlash::EraseRange(uint32_t address, size_t size) {
+  uint32_t start = address & ~(sectorSize - 1u);
+  uint32_t end = (address + size + sectorSize - 1u) & ~(sectorSize - 1u);
+
+  xSemaphoreTake(writeMutex, portMAX_DELAY);
+  while (start < end) {
+    auto step = PlanErase(start, end - start);
+    Erase(step.command, start);
+    start += step.size;
+  }
+  xSemaphoreGive(writeMutex);
+}
+
+void SpiNorFlash::Erase(uint8_t command, uint32_t address) {
   static constexpr uint8_t cmdSize = 4;
-  uint8_t cmd[cmdSize] = {static_cast<uint8_t>(Commands::SectorErase),
-                          static_cast<uint8_t>(sectorAddress >> 16U),
-                          static_cast<uint8_t>(sectorAddress >> 8U),
-                          static_cast<uint8_t>(sectorAddress)};
+  uint8_t cmd[cmdSize] = {command,
+                          static_cast<uint8_t>(address >> 16U),
+                          static_cast<uint8_t>(address >> 8U),
+                          static_cast<uint8_t>(address)};
 
+  xSemaphoreTake(mutex, portMAX_DELAY);
   WriteEnable();
   while (!WriteEnabled())
     vTaskDelay(1);
 
   spi.Read(reinterpret_cast<uint8_t*>(&cmd), cmdSize, nullptr, 0);
+  eraseInProgress = true;
+  resumeTick = xTaskGetTickCount();
+  xSemaphoreGive(mutex);
 
-  while (WriteInProgress())
+  // A read suspends the erase and resumes it before giving the mutex back,
+  // so WriteInProgress() is only checked while the mutex is held.
+  bool done = false;
+  while (!done) {
     vTaskDelay(1);
+    xSemaphoreTake(mutex, portMAX_DELAY);
+    done = !WriteInProgress();
+    if (done) {
+      eraseInProgress = false;
+    }
+    xSemaphoreGive(mutex);
+  }
+}
+
+// Must be called with the mutex held. Returns true if an erase was suspended.
+bool SpiNorFlash::SuspendErase() {
+  if (!eraseInProgress || !WriteInProgress()) {
+    return false;
+  }
+  // Back-to-back reads must not suspend the erase again right after it was resumed,
+  // or it could never complete.
+  TickType_t sinceResume = xTaskGetTickCount() - resumeTick;
+  if (sinceResume < minResumeToSuspendTicks) {
+    vTaskDelay(minResumeToSuspendTicks - sinceResume);
+    if (!WriteInProgress()) {
+      return false;
+    }
+  }
+  auto cmd = static_cast<uint8_t>(Commands::EraseSuspend);
+  spi.Read(&cmd, sizeof(cmd), nullptr, 0);
+  // The flash needs a few tens of µs to suspend the erase
+  while (WriteInProgress())
+    ;
+  return true;
+}
+
+void SpiNorFlash::ResumeErase() {
+  auto cmd = static_cast<uint8_t>(Commands::EraseResume);
+  spi.Read(&cmd, sizeof(cmd), nullptr, 0);
+  resumeTick = xTaskGetTickCount();
 }
 
 uint8_t SpiNorFlash::ReadSecurityRegister() {
@@ -119,6 +256,9 @@ bool SpiNorFlash::EraseFailed() {
 void SpiNorFlash::Write(uint32_t address, const uint8_t* buffer, size_t size) {
   static constexpr uint8_t cmdSize = 4;
 
+  xSemaphoreTake(writeMutex, portMAX_DELAY);
+  xSemaphoreTake(mutex, portMAX_DELAY);
+
   size_t len = size;
   uint32_t addr = address;
   const uint8_t* b = buffer;
@@ -144,6 +284,8 @@ void SpiNorFlash::Write(uint32_t address, const uint8_t* buffer, size_t size) {
     b += toWrite;
     len -= toWrite;
   }
+  xSemaphoreGive(mutex);
+  xSemaphoreGive(writeMutex);
 }
 
 SpiNorFlash::Identification SpiNorFlash::GetIdentification() const {
@@ -1,6 +1,8 @@
 #pragma once
 #include <cstddef>
 #include <cstdint>
+#include <FreeRTOS.h>
+#include <semphr.h>
 
 namespace Pinetime {
   namespace Drivers {
@@ -25,14 +27,19 @@ namespace Pinetime {
       bool WriteEnabled();
       uint8_t ReadConfigurationRegister();
       void Read(uint32_t address, uint8_t* buffer, size_t size);
+      // Reads a large contiguous area, such as a font or an image, with one DMA transaction per block
+      void StreamRead(uint32_t address, uint8_t* buffer, size_t size);
       void Write(uint32_t address, const uint8_t* buffer, size_t size);
       void WriteEnable();
       void SectorErase(uint32_t sectorAddress);
+      // Erases all the sectors overlapping [address, address + size), using block erases where possible
+      void EraseRange(uint32_t address, size_t size);
       uint8_t ReadSecurityRegister();
       bool ProgramFailed();
       bool EraseFailed();
 
       Identification GetIdentification() const;
+      bool FastReadSupported() const;
 
       void Init();
       void Uninit();
@@ -40,25 +47,70 @@ namespace Pinetime {
       void Sleep();
       void Wakeup();
 
+      struct EraseStep {
+        uint8_t command;
+        uint32_t size;
+      };
+
+      // Returns the largest erase that starts at address and does not go past size
+      static constexpr EraseStep PlanErase(uint32_t address, size_t size) {
+        if ((address % block64KSize) == 0 && size >= block64KSize) {
+          return {static_cast<uint8_t>(Commands::BlockErase64K), block64KSize};
+        }
+        if ((address % block32KSize) == 0 && size >= block32KSize) {
+          return {static_cast<uint8_t>(Commands::BlockErase32K), block32KSize};
+        }
+        return {static_cast<uint8_t>(Commands::SectorErase), sectorSize};
+      }
+
     private:
       Identification ReadIdentification();
 
+      void Erase(uint8_t command, uint32_t address);
+      bool SuspendErase();
+      void ResumeErase();
+      void ProbeFastRead();
+      void ReadTransaction(uint32_t address, uint8_t* buffer, size_t size);
+
       enum class Commands : uint8_t {
         PageProgram = 0x02,
         Read = 0x03,
+        FastRead = 0x0B,
         ReadStatusRegister = 0x05,
         WriteEnable = 0x06,
         ReadConfigurationRegister = 0x15,
         SectorErase = 0x20,
+        BlockErase32K = 0x52,
+        EraseSuspend = 0x75,
+        EraseResume = 0x7A,
+        BlockErase64K = 0xD8,
         ReadSecurityRegister = 0x2B,
         ReadIdentification = 0x9F,
+        ReadSfdp = 0x5A,
         ReleaseFromDeepPowerDown = 0xAB,
         DeepPowerDown = 0xB9
       };
       static constexpr uint16_t pageSize = 256;
+      static constexpr uint32_t sectorSize = 0x1000;
+      static constexpr uint32_t block32KSize = 0x8000;
+      static constexpr uint32_t block64KSize = 0x10000;
+      // Upper bound of a single read transaction, about 1ms of bus time at 8MHz
+      static constexpr size_t maxReadSize = 1024;
+      static constexpr size_t maxStreamReadSize = 4096;
+      // Minimum time between an erase resume and the next suspend. tRS is 100µs in the datasheet,
+      // 2 ticks guarantee at least one full tick (~1ms) so that the erase keeps progressing.
+      static constexpr TickType_t minResumeToSuspendTicks = 2;
 
       Spi& spi;
       Identification device_id;
+      bool fastRead = false;
+
+      // mutex protects each command sequence. writeMutex serializes program and erase operations:
+      // an erase releases mutex while it is running so that reads can suspend it.
+      SemaphoreHandle_t mutex = nullptr;
+      SemaphoreHandle_t writeMutex = nullptr;
+      bool eraseInProgress = false;
+      TickType_t resumeTick = 0;
     };
   }
 }
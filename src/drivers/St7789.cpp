@@ -40,9 +40,17 @@ void St7789::WriteData(uint8_t data) {
 }
 
 void St7789::WriteData(const uint8_t* data, size_t size) {
-  WriteSpi(data, size, [pinDataCommand = pinDataCommand]() {
-    nrf_gpio_pin_set(pinDataCommand);
-  });
+  WriteData(data, size, nullptr);
+}
+
+void St7789::WriteData(const uint8_t* data, size_t size, const std::function<void()>& transferDoneHook) {
+  WriteSpi(
+    data,
+    size,
+    [pinDataCommand = pinDataCommand]() {
+      nrf_gpio_pin_set(pinDataCommand);
+    },
+    transferDoneHook);
 }
 
 void St7789::WriteCommand(uint8_t data) {
@@ -50,13 +58,20 @@ void St7789::WriteCommand(uint8_t data) {
 }
 
 void St7789::WriteCommand(const uint8_t* data, size_t size) {
-  WriteSpi(data, size, [pinDataCommand = pinDataCommand]() {
-    nrf_gpio_pin_clear(pinDataCommand);
-  });
+  WriteSpi(
+    data,
+    size,
+    [pinDataCommand = pinDataCommand]() {
+      nrf_gpio_pin_clear(pinDataCommand);
+    },
+    nullptr);
 }
 
-void St7789::WriteSpi(const uint8_t* data, size_t size, const std::function<void()>& preTransactionHook) {
-  spi.Write(data, size, preTransactionHook);
+void St7789::WriteSpi(const uint8_t* data,
+                      size_t size,
+                      const std::function<void()>& preTransactionHook,
+                      const std::function<void()>& postTransactionHook) {
+  spi.Write(data, size, preTransactionHook, postTransactionHook);
 }
 
 void St7789::SoftwareReset() {
@@ -120,6 +135,12 @@ void St7789::PixelFormat() {
   WriteData(0x55);
 }
 
+void St7789::PixelFormat12Bit() {
+  WriteCommand(static_cast<uint8_t>(Commands::PixelFormat));
+  // 4K colours, 12-bit per pixel
+  WriteData(0x53);
+}
+
 void St7789::MemoryDataAccessControl() {
   WriteCommand(static_cast<uint8_t>(Commands::MemoryDataAccessControl));
 #ifdef DRIVER_DISPLAY_MIRROR
@@ -237,9 +258,9 @@ void St7789::SetAddrWindow(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1) {
   WriteData(addrWindowArgs, sizeof(addrWindowArgs));
 }
 
-void St7789::WriteToRam(const uint8_t* data, size_t size) {
+void St7789::WriteToRam(const uint8_t* data, size_t size, const std::function<void()>& transferDoneHook) {
   WriteCommand(static_cast<uint8_t>(Commands::WriteToRam));
-  WriteData(data, size);
+  WriteData(data, size, transferDoneHook);
 }
 
 void St7789::SetVdv() {
@@ -268,8 +289,18 @@ void St7789::Uninit() {
 }
 
 void St7789::DrawBuffer(uint16_t x, uint16_t y, uint16_t width, uint16_t height, const uint8_t* data, size_t size) {
+  DrawBuffer(x, y, width, height, data, size, nullptr);
+}
+
+void St7789::DrawBuffer(uint16_t x,
+                        uint16_t y,
+                        uint16_t width,
+                        uint16_t height,
+                        const uint8_t* data,
+                        size_t size,
+                        const std::function<void()>& transferDoneHook) {
   SetAddrWindow(x, y, x + width - 1, y + height - 1);
-  WriteToRam(data, size);
+  WriteToRam(data, size, transferDoneHook);
 }
 
 void St7789::HardwareReset() {
@@ -286,15 +317,32 @@ void St7789::HardwareReset() {
 void St7789::LowPowerOn() {
   IdleModeOn();
   IdleFrameRateOn();
+  PixelFormat12Bit();
   NRF_LOG_INFO("[LCD] Low power mode");
 }
 
 void St7789::LowPowerOff() {
+  // Also leaves the partial mode
+  NormalModeOn();
   IdleModeOff();
   IdleFrameRateOff();
+  PixelFormat();
   NRF_LOG_INFO("[LCD] Normal power mode");
 }
 
+void St7789::PartialArea(uint16_t startLine, uint16_t endLine) {
+  WriteCommand(static_cast<uint8_t>(Commands::PartialArea));
+  uint8_t args[] = {
+    static_cast<uint8_t>(startLine >> 8), // Start line MSB
+    static_cast<uint8_t>(startLine),      // Start line LSB
+    static_cast<uint8_t>(endLine >> 8),   // End line MSB
+    static_cast<uint8_t>(endLine)         // End line LSB
+  };
+  memcpy(partialAreaArgs, args, sizeof(args));
+  WriteData(partialAreaArgs, sizeof(partialAreaArgs));
+  WriteCommand(static_cast<uint8_t>(Commands::PartialModeOn));
+}
+
 void St7789::Sleep() {
   SleepIn();
   nrf_gpio_cfg_default(pinDataCommand);
@@ -23,9 +23,21 @@ namespace Pinetime {
       void VerticalScrollStartAddress(uint16_t line);
 
       void DrawBuffer(uint16_t x, uint16_t y, uint16_t width, uint16_t height, const uint8_t* data, size_t size);
+      // The transfer runs in the background, transferDoneHook is called from the SPI interrupt once it is finished
+      void DrawBuffer(uint16_t x,
+                      uint16_t y,
+                      uint16_t width,
+                      uint16_t height,
+                      const uint8_t* data,
+                      size_t size,
+                      const std::function<void()>& transferDoneHook);
 
+      // Idle mode (8 colours) with a reduced frame rate and 12-bit pixels
       void LowPowerOn();
       void LowPowerOff();
+      // Only displays the lines between startLine and endLine of the display memory (wrapping around if endLine < startLine),
+      // until LowPowerOff() is called
+      void PartialArea(uint16_t startLine, uint16_t endLine);
       void Sleep();
       void Wakeup();
 
@@ -44,10 +56,11 @@ namespace Pinetime {
       void EnsureSleepOutPostDelay();
       void SleepIn();
       void PixelFormat();
+      void PixelFormat12Bit();
       void MemoryDataAccessControl();
       void DisplayInversionOn();
       void NormalModeOn();
-      void WriteToRam(const uint8_t* data, size_t size);
+      void WriteToRam(const uint8_t* data, size_t size, const std::function<void()>& transferDoneHook);
       void IdleModeOn();
       void IdleModeOff();
       void FrameRateNormalSet();
@@ -63,12 +76,16 @@ namespace Pinetime {
       void SetVdv();
       void WriteCommand(uint8_t cmd);
       void WriteCommand(const uint8_t* data, size_t size);
-      void WriteSpi(const uint8_t* data, size_t size, const std::function<void()>& preTransactionHook);
+      void WriteSpi(const uint8_t* data,
+                    size_t size,
+                    const std::function<void()>& preTransactionHook,
+                    const std::function<void()>& postTransactionHook);
 
       enum class Commands : uint8_t {
         SoftwareReset = 0x01,
         SleepIn = 0x10,
         SleepOut = 0x11,
+        PartialModeOn = 0x12,
         NormalModeOn = 0x13,
         DisplayInversionOn = 0x21,
         DisplayOff = 0x28,
@@ -76,6 +93,7 @@ namespace Pinetime {
         ColumnAddressSet = 0x2a,
         RowAddressSet = 0x2b,
         WriteToRam = 0x2c,
+        PartialArea = 0x30,
         MemoryDataAccessControl = 0x36,
         VerticalScrollDefinition = 0x33,
         VerticalScrollStartAddress = 0x37,
@@ -93,12 +111,14 @@ namespace Pinetime {
       };
       void WriteData(uint8_t data);
       void WriteData(const uint8_t* data, size_t size);
+      void WriteData(const uint8_t* data, size_t size, const std::function<void()>& transferDoneHook);
 
       static constexpr uint16_t Width = 240;
       static constexpr uint16_t Height = 320;
 
       uint8_t addrWindowArgs[4];
       uint8_t verticalScrollArgs[2];
+      uint8_t partialAreaArgs[4];
     };
   }
 }
@@ -2,6 +2,9 @@
 
 #include <libraries/log/nrf_log.h>
 
+// The file system is used by several tasks, FS provides the lock and unlock callbacks
+#define LFS_THREADSAFE
+
 #ifndef LFS_TRACE
 #ifdef LFS_YES_TRACE
 #define LFS_TRACE_(fmt, ...) \
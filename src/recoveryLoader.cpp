@@ -41,10 +41,10 @@ Pinetime::Drivers::SpiMaster spi {Pinetime::Drivers::SpiMaster::SpiModule::SPI0,
                                    Pinetime::PinMap::SpiSck,
                                    Pinetime::PinMap::SpiMosi,
                                    Pinetime::PinMap::SpiMiso}};
-Pinetime::Drivers::Spi flashSpi {spi, Pinetime::PinMap::SpiFlashCsn};
+Pinetime::Drivers::Spi flashSpi {spi, Pinetime::PinMap::SpiFlashCsn, Pinetime::Drivers::SpiMaster::Priority::Storage};
 Pinetime::Drivers::SpiNorFlash spiNorFlash {flashSpi};
 
-Pinetime::Drivers::Spi lcdSpi {spi, Pinetime::PinMap::SpiLcdCsn};
+Pinetime::Drivers::Spi lcdSpi {spi, Pinetime::PinMap::SpiLcdCsn, Pinetime::Drivers::SpiMaster::Priority::Display};
 Pinetime::Drivers::St7789 lcd {lcdSpi, Pinetime::PinMap::LcdDataCommand, Pinetime::PinMap::LcdReset};
 
 Pinetime::Controllers::BrightnessController brightnessController;
@@ -70,6 +70,7 @@ void SPIM0_SPIS0_TWIM0_TWIS0_SPI0_TWI0_IRQHandler(void) {
 
   if (((NRF_SPIM0->INTENSET & (1 << 1)) != 0) && NRF_SPIM0->EVENTS_STOPPED == 1) {
     NRF_SPIM0->EVENTS_STOPPED = 0;
+    spi.OnStoppedEvent();
   }
 }
 }
@@ -95,8 +96,9 @@ void Process(void* /*instance*/) {
   DisplayLogo();
 
   NRF_LOG_INFO("Erasing...");
-  for (uint32_t erased = 0; erased < sizeof(recoveryImage); erased += 0x1000) {
-    spiNorFlash.SectorErase(erased);
+  static constexpr uint32_t eraseChunkSize = 0x10000;
+  for (uint32_t erased = 0; erased < sizeof(recoveryImage); erased += eraseChunkSize) {
+    spiNorFlash.EraseRange(erased, std::min<size_t>(eraseChunkSize, sizeof(recoveryImage) - erased));
     RefreshWatchdog();
   }
 
@@ -6,10 +6,60 @@ import json
 import shutil
 import typing
 import os.path
+import struct
+import zlib
 import argparse
 import subprocess
 from zipfile import ZipFile
 
+# Resource pack format, see src/components/fs/ResourcePack.h
+PACK_FILENAME = 'resources.pak'
+PACK_MAGIC = 0x4B505249
+# The manifest lists the size and CRC of the resources, with the same format as the index of the pack
+MANIFEST_FILENAME = 'resources.mft'
+MANIFEST_MAGIC = 0x464D5249
+PACK_VERSION = 1
+PACK_MAX_PATH_LENGTH = 32
+PACK_MAX_SIZE = 0x80000
+PACK_HEADER_FORMAT = '<IHHI'
+PACK_INDEX_ENTRY_FORMAT = f'<{PACK_MAX_PATH_LENGTH}sIII'
+
+def write_manifest(output, files):
+    """Writes the size and the CRC of the files, a list of (target path, local path), to a manifest"""
+    index = b''
+    for target_path, local_path in files:
+        if len(target_path) >= PACK_MAX_PATH_LENGTH:
+            sys.exit(f'Error: the path {target_path} is too long for the manifest.')
+        with open(local_path, 'rb') as fd:
+            data = fd.read()
+        index += struct.pack(PACK_INDEX_ENTRY_FORMAT, target_path.encode(), 0, len(data), zlib.crc32(data))
+
+    size = struct.calcsize(PACK_HEADER_FORMAT) + len(index)
+    with open(output, 'wb') as fd:
+        fd.write(struct.pack(PACK_HEADER_FORMAT, MANIFEST_MAGIC, PACK_VERSION, len(files), size))
+        fd.write(index)
+
+def write_pack(output, files):
+    """Writes the files, a list of (target path, local path), to a resource pack"""
+    index_size = struct.calcsize(PACK_HEADER_FORMAT) + len(files) * struct.calcsize(PACK_INDEX_ENTRY_FORMAT)
+    index = b''
+    content = b''
+    for target_path, local_path in files:
+        if len(target_path) >= PACK_MAX_PATH_LENGTH:
+            sys.exit(f'Error: the path {target_path} is too long for the resource pack.')
+        with open(local_path, 'rb') as fd:
+            data = fd.read()
+        index += struct.pack(PACK_INDEX_ENTRY_FORMAT, target_path.encode(), index_size + len(content), len(data), zlib.crc32(data))
+        content += data
+
+    size = index_size + len(content)
+    if size > PACK_MAX_SIZE:
+        sys.exit(f'Error: the resource pack is too large ({size} bytes, max {PACK_MAX_SIZE}).')
+    with open(output, 'wb') as fd:
+        fd.write(struct.pack(PACK_HEADER_FORMAT, PACK_MAGIC, PACK_VERSION, len(files), size))
+        fd.write(index)
+        fd.write(content)
+
 def main():
     ap = argparse.ArgumentParser(description='auto generate LVGL font files from fonts')
     ap.add_argument('--config', '-c', type=str, action='append', help='config file to use')
@@ -32,6 +82,7 @@ def main():
 
     zf = ZipFile(args.output, mode='w')
     resource_files = []
+    pack_files = []
 
     for config_file in args.config:
         with open(config_file, 'r') as fd:
@@ -49,6 +100,18 @@ def main():
             if not os.path.exists(path):
                 path = os.path.join(os.path.dirname(sys.argv[0]), path)
             zf.write(path)
+            pack_files.append((resource['target_path'] + name + '.bin', path))
+
+    # The pack is installed by the firmware to its own flash area, the separate files are
+    # still needed by older firmwares and by file systems that have no room for the pack
+    write_pack(PACK_FILENAME, sorted(pack_files))
+    write_manifest(MANIFEST_FILENAME, sorted(pack_files))
+    for filename in (PACK_FILENAME, MANIFEST_FILENAME):
+        zf.write(filename)
+        resource_files.append({
+            "filename": filename,
+            "path": "/" + filename
+        })
 
     if args.obsolete:
         obsolete_file_path = os.path.join(os.path.dirname(sys.argv[0]), args.obsolete)
@@ -7,7 +7,9 @@
 
 void Pinetime::System::SystemMonitor::Process() {
   if (xTaskGetTickCount() - lastTick > 10000) {
-    NRF_LOG_INFO("---------------------------------------\nFree heap : %d", xPortGetFreeHeapSize());
+    NRF_LOG_INFO("---------------------------------------\nFree heap : %d (largest block : %d)",
+                 xPortGetFreeHeapSize(),
+                 xPortGetLargestFreeBlockSize());
     TaskStatus_t tasksStatus[10];
     auto nb = uxTaskGetSystemState(tasksStatus, 10, nullptr);
     for (uint32_t i = 0; i < nb; i++) {
@@ -113,6 +113,9 @@ void SystemTask::Work() {
   spiNorFlash.Wakeup();
 
   fs.Init();
+  fs.InstallResourcePack([this]() {
+    watchdog.Reload();
+  });
 
   nimbleController.Init();
 
@@ -291,6 +294,7 @@ void SystemTask::Work() {
             // This is for faster wakeup, sacrificing special longpress and doubleclick handling while sleeping
             if (IsSleeping()) {
               fastWakeUpDone = true;
+              wakeUpTick = buttonInterruptTick;
               GoToRunning();
               break;
             }
@@ -391,6 +395,9 @@ void SystemTask::Work() {
         }
       }
       monitor.Process();
+      if (state == SystemTaskState::Running) {
+        fs.VerifyResourceSlice();
+      }
       NoInit_BackUpTime = dateTimeController.CurrentDateTime();
       if (nrf_gpio_pin_read(PinMap::Button) == 0) {
         watchdog.Reload();
@@ -405,28 +412,35 @@ void SystemTask::GoToRunning() {
   if (state == SystemTaskState::Running) {
     return;
   }
-  if (state == SystemTaskState::Sleeping || state == SystemTaskState::AODSleeping) {
+  bool wakeUpPeripherals = state == SystemTaskState::Sleeping || state == SystemTaskState::AODSleeping;
+  if (wakeUpPeripherals) {
+    // When woken up by the button, the latency is measured from the button interrupt
+    if (!fastWakeUpDone) {
+      wakeUpTick = xTaskGetTickCount();
+    }
+
     // SPI only switched off when entering Sleeping, not AOD or GoingToSleep
     if (state == SystemTaskState::Sleeping) {
       spi.Wakeup();
     }
-
-    // Double Tap needs the touch screen to be in normal mode
-    if (!settingsController.isWakeUpModeOn(Pinetime::Controllers::Settings::WakeUpMode::DoubleTap)) {
-      touchPanel.Wakeup();
-    }
-
     spiNorFlash.Wakeup();
   }
 
+  // The display is woken up before the touch panel, whose initialization takes more than 60ms.
+  // DisplayApp ignores GoToRunning while SystemTask is sleeping, so the state is updated first.
+  state = SystemTaskState::Running;
   displayApp.PushMessage(Pinetime::Applications::Display::Messages::GoToRunning);
+
+  // Double Tap needs the touch screen to be in normal mode
+  if (wakeUpPeripherals && !settingsController.isWakeUpModeOn(Pinetime::Controllers::Settings::WakeUpMode::DoubleTap)) {
+    touchPanel.Wakeup();
+  }
+
   heartRateApp.PushMessage(Pinetime::Applications::HeartRateTask::Messages::WakeUp);
 
   if (bleController.IsRadioEnabled() && !bleController.IsConnected()) {
     nimbleController.RestartFastAdv();
   }
-
-  state = SystemTaskState::Running;
 };
 
 void SystemTask::GoToSleep() {
@@ -99,6 +99,16 @@ namespace Pinetime {
         return state != SystemTaskState::Running;
       }
 
+      // Called from the GPIOTE interrupt handler, a wake-up by the button is measured from this point
+      void OnButtonInterrupt() {
+        buttonInterruptTick = xTaskGetTickCountFromISR();
+      }
+
+      // Time at which the last wake-up was requested
+      TickType_t GetWakeUpTick() const {
+        return wakeUpTick;
+      }
+
     private:
       TaskHandle_t taskHandle;
 
@@ -138,6 +148,8 @@ namespace Pinetime {
 
       void HandleButtonAction(Controllers::ButtonActions action);
       bool fastWakeUpDone = false;
+      volatile TickType_t buttonInterruptTick = 0;
+      TickType_t wakeUpTick = 0;
 
       void GoToRunning();
       void GoToSleep();
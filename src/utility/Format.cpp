@@ -0,0 +1,112 @@
+#include "utility/Format.h"
+
+using namespace Pinetime::Utility;
+
+namespace {
+  class Writer {
+  public:
+    Writer(char* buffer, size_t size) : buffer {buffer}, size {size} {
+    }
+
+    void Put(char c) {
+      if (length + 1 < size) {
+        buffer[length] = c;
+      }
+      length++;
+    }
+
+    void Pad(size_t width, size_t used, char fill) {
+      for (; used < width; used++) {
+        Put(fill);
+      }
+    }
+
+    void Integer(const Format::Argument& argument, size_t width, bool zeroPadding) {
+      char digits[10];
+      size_t nbDigits = 0;
+      uint32_t value = argument.value;
+      do {
+        digits[nbDigits++] = static_cast<char>('0' + value % 10);
+        value /= 10;
+      } while (value != 0);
+
+      size_t used = nbDigits + (argument.negative ? 1 : 0);
+      if (zeroPadding) {
+        if (argument.negative) {
+          Put('-');
+        }
+        Pad(width, used, '0');
+      } else {
+        Pad(width, used, ' ');
+        if (argument.negative) {
+          Put('-');
+        }
+      }
+      while (nbDigits > 0) {
+        Put(digits[--nbDigits]);
+      }
+    }
+
+    void Text(const char* string, size_t width) {
+      size_t used = 0;
+      for (const char* c = string; *c != '\0'; c++) {
+        used++;
+      }
+      Pad(width, used, ' ');
+      for (; *string != '\0'; string++) {
+        Put(*string);
+      }
+    }
+
+    size_t Finish() {
+      if (size == 0) {
+        return 0;
+      }
+      size_t written = length < size ? length : size - 1;
+      buffer[written] = '\0';
+      return written;
+    }
+
+  private:
+    char* buffer;
+    size_t size;
+    size_t length = 0;
+  };
+}
+
+size_t Format::Write(char* buffer, size_t size, const char* format, const Argument* arguments) {
+  Writer writer {buffer, size};
+  for (; *format != '\0'; format++) {
+    if (*format != '%') {
+      writer.Put(*format);
+      continue;
+    }
+    format++;
+    if (*format == '%') {
+      writer.Put('%');
+      continue;
+    }
+
+    bool zeroPadding = *format == '0';
+    size_t width = 0;
+    for (; *format >= '0' && *format <= '9'; format++) {
+      width = width * 10 + (*format - '0');
+    }
+
+    // The format string was checked at compile time, the conversion matches the kind of the argument
+    const Argument& argument = *arguments++;
+    switch (argument.kind) {
+      case Kind::Integer:
+        writer.Integer(argument, width, zeroPadding);
+        break;
+      case Kind::Character:
+        writer.Pad(width, 1, ' ');
+        writer.Put(static_cast<char>(argument.value));
+        break;
+      case Kind::String:
+        writer.Text(argument.string, width);
+        break;
+    }
+  }
+  return writer.Finish();
+}
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace Pinetime {
+  namespace Utility {
+    // Allocation free subset of snprintf() for the labels of the screens, meant to be used with lv_label_set_text_static().
+    // Conversions: %d (any integer type up to 32 bits), %c, %s and %%, with an optional width (%2d) and zero padding (%02d).
+    // The format string is parsed at compile time and checked against the number and the types of the arguments.
+    namespace Format {
+      enum class Kind : uint8_t { Integer, Character, String };
+
+      struct Argument {
+        Kind kind;
+        bool negative;
+        uint32_t value;
+        const char* string;
+      };
+
+      template <typename T>
+      consteval Kind KindOf() {
+        if constexpr (std::same_as<T, char>) {
+          return Kind::Character;
+        } else if constexpr (std::integral<T> && !std::same_as<T, bool>) {
+          static_assert(sizeof(T) <= sizeof(uint32_t), "64-bit integers are not supported");
+          return Kind::Integer;
+        } else {
+          static_assert(std::convertible_to<T, const char*>, "Unsupported argument type");
+          return Kind::String;
+        }
+      }
+
+      template <typename T>
+      Argument ToArgument(T value) {
+        if constexpr (KindOf<T>() == Kind::Character) {
+          return {Kind::Character, false, static_cast<uint8_t>(value), nullptr};
+        } else if constexpr (KindOf<T>() == Kind::Integer) {
+          if constexpr (std::is_signed_v<T>) {
+            // Negated as unsigned so that the minimum value doesn't overflow
+            return {Kind::Integer, value < 0, value < 0 ? 0U - static_cast<uint32_t>(value) : static_cast<uint32_t>(value), nullptr};
+          } else {
+            return {Kind::Integer, false, static_cast<uint32_t>(value), nullptr};
+          }
+        } else {
+          return {Kind::String, false, 0, value};
+        }
+      }
+
+      // Not constexpr: calling it while parsing a format string at compile time fails the compilation
+      void InvalidFormat();
+
+      template <typename... Args>
+      class String {
+      public:
+        template <size_t N>
+        consteval String(const char (&format)[N]) : format {format} {
+          constexpr Kind kinds[] = {KindOf<Args>()..., Kind::Integer};
+          size_t count = 0;
+          for (size_t i = 0; i + 1 < N; i++) {
+            if (format[i] != '%') {
+              continue;
+            }
+            i++;
+            if (format[i] == '%') {
+              continue;
+            }
+            while (format[i] >= '0' && format[i] <= '9') {
+              i++;
+            }
+            Kind kind = Kind::Integer;
+            if (format[i] == 'c') {
+              kind = Kind::Character;
+            } else if (format[i] == 's') {
+              kind = Kind::String;
+            } else if (format[i] != 'd') {
+              InvalidFormat();
+            }
+            if (count >= sizeof...(Args) || kinds[count] != kind) {
+              InvalidFormat();
+            }
+            count++;
+          }
+          if (count != sizeof...(Args)) {
+            InvalidFormat();
+          }
+        }
+
+        const char* const format;
+      };
+
+      // Writes the formatted text, truncated to size - 1 characters, and returns its length
+      size_t Write(char* buffer, size_t size, const char* format, const Argument* arguments);
+    }
+
+    template <typename... Args>
+    size_t FormatTo(char* buffer, size_t size, Format::String<std::type_identity_t<Args>...> format, Args... args) {
+      const Format::Argument arguments[] = {Format::ToArgument(args)..., {}};
+      return Format::Write(buffer, size, format.format, arguments);
+    }
+
+    // Text of a label, stored in the screen that owns the label
+    template <size_t Size>
+    class LabelText {
+    public:
+      template <typename... Args>
+      const char* Format(Format::String<std::type_identity_t<Args>...> format, Args... args) {
+        FormatTo<Args...>(buffer.data(), Size, format, args...);
+        return buffer.data();
+      }
+
+      const char* Get() const {
+        return buffer.data();
+      }
+
+    private:
+      std::array<char, Size> buffer {};
+    };
+  }
+}
@@ -0,0 +1,110 @@
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "displayapp/AreaCoalescer.h"
+#include "Test.h"
+
+using namespace Pinetime::Components;
+
+namespace {
+  // Same layout as lv_area_t
+  struct Area {
+    int16_t x1;
+    int16_t y1;
+    int16_t x2;
+    int16_t y2;
+  };
+
+  // The draw buffer of LittleVgl: 4 lines of 240 pixels
+  constexpr uint32_t bufferPixels = 240 * 4;
+
+  bool Contains(const Area& outer, const Area& inner) {
+    return outer.x1 <= inner.x1 && outer.y1 <= inner.y1 && outer.x2 >= inner.x2 && outer.y2 >= inner.y2;
+  }
+
+  uint32_t TotalCost(const std::vector<Area>& areas, size_t count) {
+    uint32_t cost = 0;
+    for (size_t i = 0; i < count; i++) {
+      cost += AreaCoalescer::Cost(areas[i], bufferPixels);
+    }
+    return cost;
+  }
+
+  void TestCost() {
+    // 1 flush of 10x10 pixels
+    static_assert(AreaCoalescer::Cost(Area {0, 0, 9, 9}, bufferPixels) == AreaCoalescer::flushOverhead + 200);
+    // The full screen is flushed 4 lines at a time
+    static_assert(AreaCoalescer::Cost(Area {0, 0, 239, 239}, bufferPixels) == 60 * AreaCoalescer::flushOverhead + 240 * 240 * 2);
+    // Areas wider than the buffer are still flushed line by line
+    static_assert(AreaCoalescer::Cost(Area {0, 0, 239, 1}, 100) == 2 * AreaCoalescer::flushOverhead + 240 * 2 * 2);
+  }
+
+  void TestCoalesce() {
+    // Overlapping areas, such as the old and new positions of a moving object, are merged
+    std::vector<Area> overlapping {{10, 10, 29, 29}, {15, 12, 34, 31}};
+    CHECK_EQUAL(1u, AreaCoalescer::Coalesce(overlapping.data(), overlapping.size(), bufferPixels));
+    CHECK(Contains(overlapping[0], {10, 10, 29, 29}));
+    CHECK(Contains(overlapping[0], {15, 12, 34, 31}));
+    CHECK_EQUAL(10, overlapping[0].x1);
+    CHECK_EQUAL(34, overlapping[0].x2);
+
+    // Small areas in opposite corners are sent separately
+    std::vector<Area> corners {{0, 0, 9, 9}, {230, 230, 239, 239}};
+    CHECK_EQUAL(2u, AreaCoalescer::Coalesce(corners.data(), corners.size(), bufferPixels));
+
+    // The digits of a small label are merged in a single area
+    std::vector<Area> digits {{20, 100, 31, 109}, {34, 100, 45, 109}, {50, 100, 61, 109}, {64, 100, 75, 109}};
+    CHECK_EQUAL(1u, AreaCoalescer::Coalesce(digits.data(), digits.size(), bufferPixels));
+    CHECK(Contains(digits[0], {20, 100, 75, 109}));
+
+    // Large digits are not: the joined area would need more flushes of the draw buffer
+    std::vector<Area> largeDigits {{20, 100, 49, 139}, {52, 100, 81, 139}};
+    CHECK_EQUAL(2u, AreaCoalescer::Coalesce(largeDigits.data(), largeDigits.size(), bufferPixels));
+
+    std::vector<Area> single {{0, 0, 0, 0}};
+    CHECK_EQUAL(1u, AreaCoalescer::Coalesce(single.data(), single.size(), bufferPixels));
+  }
+
+  // The result covers every invalidated area, never costs more than the original areas and stays inside their bounding box,
+  // so it is still on the screen for the vertical scroll offset of the flush
+  void TestRandomAreas() {
+    std::minstd_rand random {1};
+    for (int iteration = 0; iteration < 2000; iteration++) {
+      // LV_INV_BUF_SIZE is 32
+      size_t count = 2 + random() % 31;
+      std::vector<Area> areas(count);
+      Area bounds {239, 239, 0, 0};
+      for (auto& area : areas) {
+        int16_t width = 1 + random() % (random() % 4 == 0 ? 240 : 40);
+        int16_t height = 1 + random() % (random() % 4 == 0 ? 240 : 40);
+        area.x1 = random() % (241 - width);
+        area.y1 = random() % (241 - height);
+        area.x2 = area.x1 + width - 1;
+        area.y2 = area.y1 + height - 1;
+        bounds = AreaCoalescer::Join(bounds, area);
+      }
+      const auto original = areas;
+
+      size_t coalesced = AreaCoalescer::Coalesce(areas.data(), count, bufferPixels);
+      CHECK(coalesced >= 1 && coalesced <= count);
+      CHECK(TotalCost(areas, coalesced) <= TotalCost(original, count));
+      for (const auto& area : original) {
+        bool covered = false;
+        for (size_t i = 0; i < coalesced; i++) {
+          covered = covered || Contains(areas[i], area);
+        }
+        CHECK(covered);
+      }
+      for (size_t i = 0; i < coalesced; i++) {
+        CHECK(Contains(bounds, areas[i]));
+      }
+    }
+  }
+}
+
+int main() {
+  TestCost();
+  TestCoalesce();
+  TestRandomAreas();
+  return Pinetime::Test::Result();
+}
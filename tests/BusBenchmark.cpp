@@ -0,0 +1,110 @@
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include "components/fs/FS.h"
+#include "drivers/PinMap.h"
+#include "drivers/Spi.h"
+#include "drivers/SpiMaster.h"
+#include "drivers/SpiNorFlash.h"
+#include "Clock.h"
+#include "FlashChip.h"
+#include "Scheduler.h"
+#include "Spim.h"
+#include "Test.h"
+
+// Reads large files through the whole storage stack of the watch (FS, SpiNorFlash, Spi and SpiMaster on the simulated
+// SPIM) and reports how much of the CPU is left to the other tasks. While a transfer runs, the reading task is blocked
+// and the CPU only runs the SPI interrupts, estimated at Spim::interruptTimeUs each. The CPU time of LittleFS itself is
+// not included. For comparison, a driver that busy waits for the end of each transfer keeps the CPU busy for the whole
+// bus time.
+
+using Pinetime::Controllers::FS;
+using Pinetime::Drivers::Spi;
+using Pinetime::Drivers::SpiMaster;
+using Pinetime::Drivers::SpiNorFlash;
+using Pinetime::Simulation::Clock;
+using Pinetime::Simulation::FlashChip;
+using Pinetime::Simulation::Scheduler;
+using Pinetime::Simulation::Spim;
+
+namespace {
+  constexpr size_t fileSize = 64 * 1024;
+  constexpr const char* filePath = "/benchmark.bin";
+
+  // Static, so that their addresses fit in the 32 bits of the EasyDMA pointers
+  uint8_t buffer[4096];
+
+  uint8_t Pattern(size_t position) {
+    return static_cast<uint8_t>((position * 7) ^ (position >> 8));
+  }
+
+  void ReadFile(FS& fs, Spim& spim, size_t chunkSize) {
+    lfs_file_t file = {};
+    CHECK(fs.FileOpen(&file, filePath, LFS_O_RDONLY) >= 0);
+    spim.ResetStatistics();
+    auto start = Clock::Now();
+    bool valid = true;
+    for (size_t position = 0; position < fileSize; position += chunkSize) {
+      CHECK_EQUAL(static_cast<int>(chunkSize), fs.FileRead(&file, buffer, chunkSize));
+      for (size_t i = 0; i < chunkSize; i++) {
+        valid = valid && buffer[i] == Pattern(position + i);
+      }
+    }
+    CHECK(valid);
+    fs.FileClose(&file);
+
+    const auto& statistics = spim.GetStatistics();
+    uint64_t elapsed = Clock::Now() - start;
+    uint64_t interruptTime = static_cast<uint64_t>(statistics.interrupts) * Spim::interruptTimeUs;
+    uint64_t busTime = statistics.bytes / Spim::bytesPerMicrosecond;
+    std::printf("  FileRead %4zu B %9" PRIu64 " us %6" PRIu32 " transfers %6" PRIu32 " interrupts %5.1f %% idle"
+                " (busy wait: %5.1f %%)\n",
+                chunkSize,
+                elapsed,
+                statistics.transfers,
+                statistics.interrupts,
+                100.0 * (1.0 - static_cast<double>(interruptTime) / elapsed),
+                100.0 * (1.0 - static_cast<double>(busTime) / elapsed));
+  }
+
+  void Run() {
+    // Created in the task, so that the buffers of LittleFS are on its stack, in the first 4GB of the address space
+    SpiMaster spiMaster {SpiMaster::SpiModule::SPI0,
+                         {SpiMaster::BitOrder::Msb_Lsb,
+                          SpiMaster::Modes::Mode3,
+                          SpiMaster::Frequencies::Freq8Mhz,
+                          Pinetime::PinMap::SpiSck,
+                          Pinetime::PinMap::SpiMosi,
+                          Pinetime::PinMap::SpiMiso}};
+    spiMaster.Init();
+    Spim spim {spiMaster};
+    FlashChip chip;
+    spim.Attach(Pinetime::PinMap::SpiFlashCsn, chip);
+    Spi flashSpi {spiMaster, Pinetime::PinMap::SpiFlashCsn, SpiMaster::Priority::Storage};
+    SpiNorFlash flash {flashSpi};
+    flash.Init();
+    FS fs {flash};
+    fs.Init();
+
+    lfs_file_t file = {};
+    CHECK(fs.FileOpen(&file, filePath, LFS_O_WRONLY | LFS_O_CREAT | LFS_O_TRUNC) >= 0);
+    for (size_t position = 0; position < fileSize; position += sizeof(buffer)) {
+      for (size_t i = 0; i < sizeof(buffer); i++) {
+        buffer[i] = Pattern(position + i);
+      }
+      CHECK_EQUAL(static_cast<int>(sizeof(buffer)), fs.FileWrite(&file, buffer, sizeof(buffer)));
+    }
+    fs.FileClose(&file);
+
+    for (size_t chunkSize : {256, 1024, 4096}) {
+      ReadFile(fs, spim, chunkSize);
+    }
+    CHECK_EQUAL(0u, chip.GetStatistics().errors);
+  }
+}
+
+int main() {
+  Scheduler::CreateTask(Run);
+  CHECK(Scheduler::Run());
+  return Pinetime::Test::Result();
+}
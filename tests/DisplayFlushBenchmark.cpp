@@ -0,0 +1,301 @@
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <vector>
+#include "displayapp/AreaCoalescer.h"
+#include "drivers/PinMap.h"
+#include "drivers/Spi.h"
+#include "drivers/SpiMaster.h"
+#include "drivers/St7789.h"
+#include "Clock.h"
+#include "Gpio.h"
+#include "Scheduler.h"
+#include "Spim.h"
+#include "Test.h"
+
+// Replays the areas invalidated by typical screens and flushes them with the St7789 driver on the simulated SPI bus,
+// as LVGL does: the areas are joined by LVGL (lv_refr_join_area()), then rendered in bands of the draw buffer. Each
+// trace is flushed once as LVGL invalidated it, then after AreaCoalescer, and the commands and bytes received by the
+// display are reported. The traces are modeled on the screens of InfiniTime, they were not recorded on a watch. LVGL
+// already joins the overlapping areas of these screens, the areas AreaCoalescer merges in addition are the small ones
+// that are close to each other.
+
+using Pinetime::Components::AreaCoalescer::Coalesce;
+using Pinetime::Drivers::Spi;
+using Pinetime::Drivers::SpiMaster;
+using Pinetime::Drivers::St7789;
+using Pinetime::Simulation::Clock;
+using Pinetime::Simulation::Gpio;
+using Pinetime::Simulation::Scheduler;
+using Pinetime::Simulation::SpiDevice;
+using Pinetime::Simulation::Spim;
+
+namespace {
+  // Same layout as lv_area_t
+  struct Area {
+    int16_t x1;
+    int16_t y1;
+    int16_t x2;
+    int16_t y2;
+  };
+
+  using Frame = std::vector<Area>;
+
+  struct Trace {
+    const char* name;
+    std::vector<Frame> frames;
+  };
+
+  // The draw buffer of LittleVgl: 4 lines of 240 pixels
+  constexpr uint32_t bufferPixels = 240 * 4;
+  // Static, so that its address fits in the 32 bits of the EasyDMA pointers
+  uint8_t drawBuffer[bufferPixels * 2];
+
+  // Counts the bytes received by the display while its data/command pin is low (commands) and high (arguments and pixels)
+  class Display : public SpiDevice {
+  public:
+    void Select() override {
+    }
+
+    uint8_t Transfer(uint8_t /*byte*/) override {
+      if (Gpio::Read(Pinetime::PinMap::LcdDataCommand)) {
+        dataBytes++;
+      } else {
+        commands++;
+      }
+      return 0xff;
+    }
+
+    void Deselect() override {
+    }
+
+    uint32_t commands = 0;
+    uint64_t dataBytes = 0;
+  };
+
+  uint32_t Size(const Area& area) {
+    return static_cast<uint32_t>(area.x2 - area.x1 + 1) * static_cast<uint32_t>(area.y2 - area.y1 + 1);
+  }
+
+  bool IsOn(const Area& a, const Area& b) {
+    return a.x1 <= b.x2 && a.x2 >= b.x1 && a.y1 <= b.y2 && a.y2 >= b.y1;
+  }
+
+  bool IsIn(const Area& inner, const Area& outer) {
+    return inner.x1 >= outer.x1 && inner.y1 >= outer.y1 && inner.x2 <= outer.x2 && inner.y2 <= outer.y2;
+  }
+
+  // _lv_inv_area() drops the areas that are inside an area already invalidated
+  Frame Invalidate(const Frame& areas) {
+    Frame invalidated;
+    for (const auto& area : areas) {
+      if (std::none_of(invalidated.begin(), invalidated.end(), [&](const Area& other) {
+            return IsIn(area, other);
+          })) {
+        invalidated.push_back(area);
+      }
+    }
+    return invalidated;
+  }
+
+  // lv_refr_join_area() joins the overlapping areas when the result is smaller than both of them
+  Frame Join(Frame areas) {
+    std::vector<bool> joined(areas.size(), false);
+    for (size_t in = 0; in < areas.size(); in++) {
+      if (joined[in]) {
+        continue;
+      }
+      for (size_t from = 0; from < areas.size(); from++) {
+        if (joined[from] || in == from || !IsOn(areas[in], areas[from])) {
+          continue;
+        }
+        Area area = Pinetime::Components::AreaCoalescer::Join(areas[in], areas[from]);
+        if (Size(area) < Size(areas[in]) + Size(areas[from])) {
+          areas[in] = area;
+          joined[from] = true;
+        }
+      }
+    }
+    Frame result;
+    for (size_t i = 0; i < areas.size(); i++) {
+      if (!joined[i]) {
+        result.push_back(areas[i]);
+      }
+    }
+    return result;
+  }
+
+  // A label whose text changes invalidates its old and its new area
+  void Label(Frame& frame, int16_t x, int16_t y, int16_t width, int16_t newWidth, int16_t height) {
+    frame.push_back({x, y, static_cast<int16_t>(x + width - 1), static_cast<int16_t>(y + height - 1)});
+    frame.push_back({x, y, static_cast<int16_t>(x + newWidth - 1), static_cast<int16_t>(y + height - 1)});
+  }
+
+  std::vector<Trace> Traces() {
+    std::vector<Trace> traces;
+
+    // Digital watch face, every minute: the time, the date, the battery and the step count
+    Trace digital {"digital watch face", {}};
+    for (int minute = 0; minute < 60; minute++) {
+      Frame frame;
+      Label(frame, 30, 80, 180, 176 + (minute % 3) * 2, 76);
+      if (minute % 10 == 0) {
+        Label(frame, 60, 170, 120, 124, 20);
+      }
+      frame.push_back({206, 0, 239, 19});
+      frame.push_back({186, 0, 203, 19});
+      Label(frame, 160, 218, 60, 62, 20);
+      Label(frame, 120, 218, 30, 30, 20);
+      digital.frames.push_back(frame);
+    }
+    traces.push_back(digital);
+
+    // Analog watch face, every second: the old and the new second hand, and the center
+    Trace analog {"analog watch face", {}};
+    for (int second = 0; second < 60; second++) {
+      Frame frame;
+      auto hand = [](int position) -> Area {
+        int16_t x = 120 + (position % 15) * 6 - 45;
+        int16_t y = 20 + (position % 20) * 4;
+        return {static_cast<int16_t>(std::min<int16_t>(x, 120)),
+                static_cast<int16_t>(std::min<int16_t>(y, 120)),
+                static_cast<int16_t>(std::max<int16_t>(x, 120)),
+                static_cast<int16_t>(std::max<int16_t>(y, 120))};
+      };
+      frame.push_back(hand(second));
+      frame.push_back(hand(second + 1));
+      frame.push_back({113, 113, 127, 127});
+      analog.frames.push_back(frame);
+    }
+    traces.push_back(analog);
+
+    // Heart rate screen, every second: the value and the status label below it
+    Trace heartRate {"heart rate", {}};
+    for (int second = 0; second < 60; second++) {
+      Frame frame;
+      Label(frame, 70, 60, 100, 96 + (second % 2) * 8, 76);
+      Label(frame, 80, 150, 80, 80, 20);
+      frame.push_back({100, 190, 139, 229});
+      heartRate.frames.push_back(frame);
+    }
+    traces.push_back(heartRate);
+
+    // Settings list: a checkbox is toggled and the previous one is cleared
+    Trace settings {"settings checkboxes", {}};
+    for (int toggle = 0; toggle < 20; toggle++) {
+      Frame frame;
+      int16_t previous = 40 + (toggle % 4) * 50;
+      int16_t next = 40 + ((toggle + 1) % 4) * 50;
+      frame.push_back({10, previous, 39, static_cast<int16_t>(previous + 29)});
+      frame.push_back({10, next, 39, static_cast<int16_t>(next + 29)});
+      frame.push_back({40, previous, 229, static_cast<int16_t>(previous + 29)});
+      settings.frames.push_back(frame);
+    }
+    traces.push_back(settings);
+
+    // Music, every refresh of 30ms: the scrolling title and artist, and every second the position and the disc animation
+    Trace music {"music", {}};
+    for (int refresh = 0; refresh < 100; refresh++) {
+      Frame frame;
+      frame.push_back({12, 97, 239, 117});
+      frame.push_back({12, 124, 239, 144});
+      if (refresh % 33 == 0) {
+        frame.push_back({12, 20, 239, 40});
+        frame.push_back({161, 15, 192, 46});
+      }
+      music.frames.push_back(frame);
+    }
+    traces.push_back(music);
+
+    // Not an InfiniTime screen: icons of 12x12 pixels 2 pixels apart, updated one by one, where sending them together saves
+    // the commands of each flush
+    Trace icons {"packed icons", {}};
+    for (int update = 0; update < 60; update++) {
+      Frame frame;
+      for (int16_t icon = 0; icon < 5; icon++) {
+        if ((update + icon) % 3 != 0) {
+          int16_t x = 150 + icon * 14;
+          frame.push_back({x, 4, static_cast<int16_t>(x + 11), 15});
+        }
+      }
+      icons.frames.push_back(frame);
+    }
+    traces.push_back(icons);
+    return traces;
+  }
+
+  struct Result {
+    uint32_t flushes;
+    uint64_t pixels;
+    uint32_t commands;
+    uint64_t bytes;
+    uint64_t busTime;
+  };
+
+  Result Replay(const Trace& trace, bool coalesce) {
+    SpiMaster spiMaster {SpiMaster::SpiModule::SPI0,
+                         {SpiMaster::BitOrder::Msb_Lsb,
+                          SpiMaster::Modes::Mode3,
+                          SpiMaster::Frequencies::Freq8Mhz,
+                          Pinetime::PinMap::SpiSck,
+                          Pinetime::PinMap::SpiMosi,
+                          Pinetime::PinMap::SpiMiso}};
+    spiMaster.Init();
+    Spim spim {spiMaster};
+    Display display;
+    spim.Attach(Pinetime::PinMap::SpiLcdCsn, display);
+    Spi lcdSpi {spiMaster, Pinetime::PinMap::SpiLcdCsn, SpiMaster::Priority::Display};
+    Result result {};
+
+    Scheduler::CreateTask([&]() {
+      // In the task, so that the arguments of its commands are in the first 4GB of the address space
+      St7789 lcd {lcdSpi, Pinetime::PinMap::LcdDataCommand, Pinetime::PinMap::LcdReset};
+      auto start = Clock::Now();
+      for (const auto& invalidated : trace.frames) {
+        Frame areas = Invalidate(invalidated);
+        if (coalesce && areas.size() > 1) {
+          areas.resize(Coalesce(areas.data(), areas.size(), bufferPixels));
+        }
+        for (const auto& area : Join(areas)) {
+          uint16_t width = area.x2 - area.x1 + 1;
+          uint16_t linesPerFlush = std::max<uint32_t>(1, bufferPixels / width);
+          for (int16_t y = area.y1; y <= area.y2; y += linesPerFlush) {
+            uint16_t height = std::min<int16_t>(linesPerFlush, area.y2 - y + 1);
+            lcd.DrawBuffer(area.x1, y, width, height, drawBuffer, width * height * 2);
+            result.flushes++;
+            result.pixels += width * height;
+          }
+        }
+      }
+      // Waits for the last transfer
+      lcd.DrawBuffer(0, 0, 1, 1, drawBuffer, 2);
+      result.busTime = Clock::Now() - start;
+    });
+    CHECK(Scheduler::Run());
+    result.commands = display.commands;
+    result.bytes = display.commands + display.dataBytes;
+    return result;
+  }
+
+  void Print(const char* name, const Result& result) {
+    std::printf("  %-10s %6" PRIu32 " flushes %8" PRIu64 " pixels %6" PRIu32 " commands %8" PRIu64 " bytes %8" PRIu64 " us\n",
+                name,
+                result.flushes,
+                result.pixels,
+                result.commands,
+                result.bytes,
+                result.busTime);
+  }
+}
+
+int main() {
+  for (const auto& trace : Traces()) {
+    auto lvgl = Replay(trace, false);
+    auto coalesced = Replay(trace, true);
+    std::printf("%s, %zu frames\n", trace.name, trace.frames.size());
+    Print("LVGL", lvgl);
+    Print("coalesced", coalesced);
+    CHECK(coalesced.flushes <= lvgl.flushes);
+  }
+  return Pinetime::Test::Result();
+}
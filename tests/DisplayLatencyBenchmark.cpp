@@ -0,0 +1,155 @@
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <functional>
+#include <FreeRTOS.h>
+#include <semphr.h>
+#include <task.h>
+#include "drivers/PinMap.h"
+#include "drivers/Spi.h"
+#include "drivers/SpiMaster.h"
+#include "drivers/SpiNorFlash.h"
+#include "Clock.h"
+#include "FlashChip.h"
+#include "Scheduler.h"
+#include "Spim.h"
+#include "Test.h"
+
+// Refreshes a part of the screen at 20 frames per second while a file received over BLE is written to the external
+// flash and an application loads a font from it, and reports the time needed to flush each frame. The flash shares
+// the SPI bus with the display. The display is first given its own priority class, then the lowest one, which it would
+// get if the bus was handed out in the order of the requests.
+
+using Pinetime::Drivers::Spi;
+using Pinetime::Drivers::SpiMaster;
+using Pinetime::Drivers::SpiNorFlash;
+using Pinetime::Simulation::Clock;
+using Pinetime::Simulation::FlashChip;
+using Pinetime::Simulation::Scheduler;
+using Pinetime::Simulation::SpiDevice;
+using Pinetime::Simulation::Spim;
+
+namespace {
+  // 240x48 pixels flushed in 2 bands of 24 lines, like LittleVgl does
+  constexpr size_t bandSize = 240 * 24 * 2;
+  constexpr size_t bandsPerFrame = 2;
+  constexpr TickType_t framePeriod = configTICK_RATE_HZ / 20;
+  constexpr size_t minFrames = 10;
+  // The file is written by blocks of 4KB, each one erased first
+  constexpr uint32_t transferAddress = 0x100000;
+  constexpr size_t transferSize = 32 * 1024;
+  constexpr uint32_t resourceAddress = 0x200000;
+
+  // Static, so that their addresses fit in the 32 bits of the EasyDMA pointers
+  uint8_t frame[bandSize * bandsPerFrame];
+  uint8_t block[4096];
+  uint8_t resource[16 * 1024];
+
+  class Display : public SpiDevice {
+  public:
+    void Select() override {
+    }
+
+    uint8_t Transfer(uint8_t /*byte*/) override {
+      return 0xff;
+    }
+
+    void Deselect() override {
+    }
+  };
+
+  struct Latency {
+    uint32_t frames;
+    uint64_t total;
+    uint64_t worst;
+  };
+
+  Latency Run(bool transfer, SpiMaster::Priority displayPriority) {
+    SpiMaster spiMaster {SpiMaster::SpiModule::SPI0,
+                         {SpiMaster::BitOrder::Msb_Lsb,
+                          SpiMaster::Modes::Mode3,
+                          SpiMaster::Frequencies::Freq8Mhz,
+                          Pinetime::PinMap::SpiSck,
+                          Pinetime::PinMap::SpiMosi,
+                          Pinetime::PinMap::SpiMiso}};
+    spiMaster.Init();
+    Spim spim {spiMaster};
+    Display display;
+    FlashChip chip;
+    spim.Attach(Pinetime::PinMap::SpiLcdCsn, display);
+    spim.Attach(Pinetime::PinMap::SpiFlashCsn, chip);
+    Spi lcdSpi {spiMaster, Pinetime::PinMap::SpiLcdCsn, displayPriority};
+    Spi flashSpi {spiMaster, Pinetime::PinMap::SpiFlashCsn, SpiMaster::Priority::Storage};
+    SpiNorFlash flash {flashSpi};
+
+    SemaphoreHandle_t flushed = xSemaphoreCreateBinary();
+    bool transferDone = !transfer;
+    Latency latency {};
+
+    Scheduler::CreateTask([&]() {
+      while (!transferDone || latency.frames < minFrames) {
+        auto start = Clock::Now();
+        auto wakeUp = xTaskGetTickCount() + framePeriod;
+        for (size_t band = 0; band < bandsPerFrame; band++) {
+          std::function<void()> hook;
+          if (band == bandsPerFrame - 1) {
+            hook = [&]() {
+              xSemaphoreGiveFromISR(flushed, nullptr);
+            };
+          }
+          lcdSpi.Write(frame + band * bandSize, bandSize, nullptr, hook);
+        }
+        xSemaphoreTake(flushed, portMAX_DELAY);
+
+        uint64_t elapsed = Clock::Now() - start;
+        latency.frames++;
+        latency.total += elapsed;
+        latency.worst = std::max(latency.worst, elapsed);
+        vTaskDelay(wakeUp - xTaskGetTickCount());
+      }
+    });
+    if (transfer) {
+      Scheduler::CreateTask([&]() {
+        flash.Init();
+        for (uint32_t offset = 0; offset < transferSize; offset += sizeof(block)) {
+          flash.SectorErase(transferAddress + offset);
+          flash.Write(transferAddress + offset, block, sizeof(block));
+        }
+        transferDone = true;
+      });
+      // An application loads a font meanwhile
+      Scheduler::CreateTask([&]() {
+        while (!transferDone) {
+          flash.StreamRead(resourceAddress, resource, sizeof(resource));
+          vTaskDelay(1);
+        }
+      });
+    }
+    CHECK(Scheduler::Run());
+    CHECK_EQUAL(0u, chip.GetStatistics().errors);
+    return latency;
+  }
+
+  void Print(const char* name, const Latency& latency) {
+    std::printf("  %-36s %4" PRIu32 " frames %7" PRIu64 " us mean %7" PRIu64 " us worst\n",
+                name,
+                latency.frames,
+                latency.total / latency.frames,
+                latency.worst);
+  }
+}
+
+int main() {
+  auto alone = Run(false, SpiMaster::Priority::Display);
+  auto withPriority = Run(true, SpiMaster::Priority::Display);
+  auto withoutPriority = Run(true, SpiMaster::Priority::Background);
+  std::printf("Flush of a 240x48 area\n");
+  Print("display alone", alone);
+  Print("file transfer, display priority", withPriority);
+  Print("file transfer, background priority", withoutPriority);
+
+  // Each band only waits for the flash transaction running when it asks for the bus: a 4KB stream read at most
+  CHECK(withPriority.worst <= alone.worst + bandsPerFrame * 4200);
+  CHECK(withPriority.worst <= withoutPriority.worst);
+  return Pinetime::Test::Result();
+}
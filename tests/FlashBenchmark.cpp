@@ -0,0 +1,205 @@
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <vector>
+#include "components/fs/FS.h"
+#include "drivers/Spi.h"
+#include "drivers/SpiNorFlash.h"
+#include "Clock.h"
+#include "ResourcePackImage.h"
+#include "Test.h"
+
+// Runs the same file system workload with each LittleFS profile on the simulated flash, and reports the flash
+// transactions and the simulated time of each phase. The time is the bus time plus the typical program and
+// erase times of the flash, the CPU time of LittleFS is not included.
+
+using Pinetime::Controllers::FS;
+using Pinetime::Drivers::Spi;
+using Pinetime::Drivers::SpiNorFlash;
+using Pinetime::Simulation::Clock;
+
+namespace {
+  constexpr size_t fileSize = 64 * 1024;
+  constexpr size_t chunkSize = 256;
+  constexpr size_t randomAccessSize = 64;
+  constexpr size_t randomAccessCount = 256;
+  constexpr size_t smallFileCount = 32;
+  constexpr size_t smallFileSize = 100;
+  // A resource as large as a font, read through LittleFS and from the resource pack
+  constexpr size_t resourceSize = 16 * 1024;
+  constexpr size_t resourceChunkSize = 1024;
+  constexpr const char* resourcePath = "/fonts/benchmark.bin";
+  // See the external flash map in FS.h
+  constexpr uint32_t resourcePackAddress = 0x380000;
+
+  const char* ProfileName(FS::Profile profile) {
+    switch (profile) {
+      case FS::Profile::Compact:
+        return "Compact";
+      case FS::Profile::Throughput:
+        return "Throughput";
+      case FS::Profile::Balanced:
+      default:
+        return "Balanced";
+    }
+  }
+
+  uint8_t Pattern(size_t position) {
+    return static_cast<uint8_t>((position * 7) ^ (position >> 8));
+  }
+
+  class Phase {
+  public:
+    Phase(Spi& spi, const char* name, size_t bytes) : spi {spi}, name {name}, bytes {bytes}, start {Clock::Now()} {
+      spi.ResetStatistics();
+    }
+
+    ~Phase() {
+      const auto& statistics = spi.GetStatistics();
+      uint64_t elapsed = Clock::Now() - start;
+      uint64_t throughput = (bytes > 0 && elapsed > 0) ? bytes * 1000000ULL / 1024 / elapsed : 0;
+      std::printf("  %-20s %9" PRIu64 " us %6" PRIu32 " reads %8" PRIu64 " B read %6" PRIu32 " programs %4" PRIu32 " erases %6" PRIu64
+                  " KB/s\n",
+                  name,
+                  elapsed,
+                  statistics.reads,
+                  statistics.bytesRead,
+                  statistics.pagePrograms,
+                  statistics.sectorErases + statistics.block32KErases + statistics.block64KErases,
+                  throughput);
+      CHECK_EQUAL(0u, statistics.errors);
+    }
+
+  private:
+    Spi& spi;
+    const char* name;
+    size_t bytes;
+    uint64_t start;
+  };
+
+  void Run(FS::Profile profile) {
+    std::printf("%s profile\n", ProfileName(profile));
+    Spi spi;
+    SpiNorFlash flash {spi};
+    flash.Init();
+    CHECK(flash.FastReadSupported());
+    auto buffer = std::make_unique<uint8_t[]>(std::max(chunkSize, resourceChunkSize));
+
+    std::vector<uint8_t> resource(resourceSize);
+    for (size_t i = 0; i < resourceSize; i++) {
+      resource[i] = Pattern(i);
+    }
+    auto pack = Pinetime::Simulation::BuildResourcePack({{resourcePath, resource}});
+    std::copy(pack.begin(), pack.end(), spi.Memory().begin() + resourcePackAddress);
+
+    {
+      FS fs {flash, profile};
+      Phase phase {spi, "format", 0};
+      fs.Init();
+    }
+
+    FS fs {flash, profile};
+    {
+      Phase phase {spi, "mount", 0};
+      fs.Init();
+    }
+
+    lfs_file_t file = {};
+    {
+      Phase phase {spi, "sequential write", fileSize};
+      CHECK(fs.FileOpen(&file, "/benchmark.bin", LFS_O_WRONLY | LFS_O_CREAT | LFS_O_TRUNC) >= 0);
+      for (size_t position = 0; position < fileSize; position += chunkSize) {
+        for (size_t i = 0; i < chunkSize; i++) {
+          buffer[i] = Pattern(position + i);
+        }
+        CHECK_EQUAL(static_cast<int>(chunkSize), fs.FileWrite(&file, buffer.get(), chunkSize));
+      }
+      fs.FileClose(&file);
+    }
+
+    {
+      Phase phase {spi, "sequential read", fileSize};
+      CHECK(fs.FileOpen(&file, "/benchmark.bin", LFS_O_RDONLY) >= 0);
+      bool valid = true;
+      for (size_t position = 0; position < fileSize; position += chunkSize) {
+        CHECK_EQUAL(static_cast<int>(chunkSize), fs.FileRead(&file, buffer.get(), chunkSize));
+        for (size_t i = 0; i < chunkSize; i++) {
+          valid = valid && buffer[i] == Pattern(position + i);
+        }
+      }
+      CHECK(valid);
+      fs.FileClose(&file);
+    }
+
+    {
+      Phase phase {spi, "random read", randomAccessSize * randomAccessCount};
+      std::minstd_rand random {1};
+      CHECK(fs.FileOpen(&file, "/benchmark.bin", LFS_O_RDONLY) >= 0);
+      bool valid = true;
+      for (size_t i = 0; i < randomAccessCount; i++) {
+        size_t position = random() % (fileSize - randomAccessSize);
+        fs.FileSeek(&file, position);
+        CHECK_EQUAL(static_cast<int>(randomAccessSize), fs.FileRead(&file, buffer.get(), randomAccessSize));
+        for (size_t j = 0; j < randomAccessSize; j++) {
+          valid = valid && buffer[j] == Pattern(position + j);
+        }
+      }
+      CHECK(valid);
+      fs.FileClose(&file);
+    }
+
+    {
+      Phase phase {spi, "small files", smallFileCount * smallFileSize};
+      std::memset(buffer.get(), 0x5A, smallFileSize);
+      for (size_t i = 0; i < smallFileCount; i++) {
+        char name[16];
+        std::snprintf(name, sizeof(name), "/small%u.dat", static_cast<unsigned>(i));
+        CHECK(fs.FileOpen(&file, name, LFS_O_WRONLY | LFS_O_CREAT | LFS_O_TRUNC) >= 0);
+        CHECK_EQUAL(static_cast<int>(smallFileSize), fs.FileWrite(&file, buffer.get(), smallFileSize));
+        fs.FileClose(&file);
+      }
+    }
+
+    CHECK(fs.FileOpen(&file, resourcePath, LFS_O_WRONLY | LFS_O_CREAT | LFS_O_TRUNC) >= 0);
+    CHECK_EQUAL(static_cast<int>(resourceSize), fs.FileWrite(&file, resource.data(), resourceSize));
+    fs.FileClose(&file);
+
+    {
+      Phase phase {spi, "resource (LittleFS)", resourceSize};
+      CHECK(fs.FileOpen(&file, resourcePath, LFS_O_RDONLY) >= 0);
+      bool valid = true;
+      for (size_t position = 0; position < resourceSize; position += resourceChunkSize) {
+        CHECK_EQUAL(static_cast<int>(resourceChunkSize), fs.FileRead(&file, buffer.get(), resourceChunkSize));
+        valid = valid && std::memcmp(buffer.get(), resource.data() + position, resourceChunkSize) == 0;
+      }
+      CHECK(valid);
+      fs.FileClose(&file);
+    }
+
+    {
+      Phase phase {spi, "resource (pack)", resourceSize};
+      auto& resourcePack = fs.GetResourcePack();
+      Pinetime::Controllers::ResourcePack::Entry entry;
+      CHECK(resourcePack.Find(resourcePath, entry));
+      bool valid = true;
+      for (size_t position = 0; position < resourceSize; position += resourceChunkSize) {
+        CHECK_EQUAL(resourceChunkSize, resourcePack.Read(entry, position, buffer.get(), resourceChunkSize));
+        valid = valid && std::memcmp(buffer.get(), resource.data() + position, resourceChunkSize) == 0;
+      }
+      CHECK(valid);
+    }
+
+    auto cache = fs.GetReadCacheStatistics();
+    std::printf("  read cache: %" PRIu32 " hits, %" PRIu32 " misses\n", cache.hits, cache.misses);
+  }
+}
+
+int main() {
+  Run(FS::Profile::Compact);
+  Run(FS::Profile::Balanced);
+  Run(FS::Profile::Throughput);
+  return Pinetime::Test::Result();
+}
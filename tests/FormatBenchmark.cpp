@@ -0,0 +1,123 @@
+#include <chrono>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "utility/Format.h"
+#include "Test.h"
+
+// Times the formatting of the time, battery and step labels with Utility::Format, with snprintf() and with the path of
+// lv_label_set_text_fmt(), and counts the heap allocations of each. lv_label_set_text_fmt() frees the previous text,
+// measures the new one with vsnprintf(), allocates it in the LVGL heap and formats it again (_lv_txt_set_text_vfmt());
+// malloc() and the vsnprintf() of the C library stand in for lv_mem_alloc() and lv_vsnprintf() here. Host timings only
+// compare the paths.
+
+using Pinetime::Utility::LabelText;
+
+namespace {
+  constexpr int iterations = 1000000;
+
+  uint32_t allocations = 0;
+  char* labelText = nullptr;
+
+  // lv_label_set_text_fmt()
+  void SetTextFmt(const char* format, ...) {
+    std::free(labelText);
+    va_list arguments;
+    va_start(arguments, format);
+    va_list copy;
+    va_copy(copy, arguments);
+    int length = std::vsnprintf(nullptr, 0, format, copy);
+    va_end(copy);
+    labelText = static_cast<char*>(std::malloc(length + 1));
+    allocations++;
+    std::vsnprintf(labelText, length + 1, format, arguments);
+    va_end(arguments);
+  }
+
+  struct Result {
+    double nanoseconds;
+    uint32_t allocations;
+  };
+
+  template <typename Function>
+  Result Measure(Function&& function) {
+    uint32_t start = allocations;
+    auto begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+      function(i);
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - begin;
+    return {elapsed.count() / iterations, allocations - start};
+  }
+
+  void Print(const char* label, const Result& format, const Result& snprintf, const Result& setTextFmt) {
+    std::printf("%-12s Format %6.1f ns, snprintf %6.1f ns, lv_label_set_text_fmt %6.1f ns (%.2f allocations per update)\n",
+                label,
+                format.nanoseconds,
+                snprintf.nanoseconds,
+                setTextFmt.nanoseconds,
+                static_cast<double>(setTextFmt.allocations) / iterations);
+    CHECK_EQUAL(0u, format.allocations);
+    CHECK_EQUAL(0u, snprintf.allocations);
+  }
+
+  // Keeps the results alive
+  volatile char sink;
+}
+
+int main() {
+  LabelText<6> time;
+  LabelText<5> battery;
+  LabelText<8> steps;
+  char buffer[16];
+
+  {
+    auto format = Measure([&](int i) {
+      sink = time.Format("%02d:%02d", (i / 60) % 24, i % 60)[4];
+    });
+    auto snprintf = Measure([&](int i) {
+      std::snprintf(buffer, sizeof(buffer), "%02d:%02d", (i / 60) % 24, i % 60);
+      sink = buffer[4];
+    });
+    auto setTextFmt = Measure([&](int i) {
+      SetTextFmt("%02d:%02d", (i / 60) % 24, i % 60);
+      sink = labelText[4];
+    });
+    Print("time", format, snprintf, setTextFmt);
+  }
+
+  {
+    auto format = Measure([&](int i) {
+      sink = battery.Format("%d%%", i % 101)[0];
+    });
+    auto snprintf = Measure([&](int i) {
+      std::snprintf(buffer, sizeof(buffer), "%d%%", i % 101);
+      sink = buffer[0];
+    });
+    auto setTextFmt = Measure([&](int i) {
+      SetTextFmt("%d%%", i % 101);
+      sink = labelText[0];
+    });
+    Print("battery", format, snprintf, setTextFmt);
+  }
+
+  {
+    auto format = Measure([&](int i) {
+      sink = steps.Format("%d", static_cast<uint32_t>(i) * 7)[0];
+    });
+    auto snprintf = Measure([&](int i) {
+      std::snprintf(buffer, sizeof(buffer), "%u", static_cast<uint32_t>(i) * 7);
+      sink = buffer[0];
+    });
+    auto setTextFmt = Measure([&](int i) {
+      SetTextFmt("%u", static_cast<uint32_t>(i) * 7);
+      sink = labelText[0];
+    });
+    Print("steps", format, snprintf, setTextFmt);
+  }
+
+  std::free(labelText);
+  return Pinetime::Test::Result();
+}
@@ -0,0 +1,110 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include "utility/Format.h"
+#include "Test.h"
+
+using Pinetime::Utility::FormatTo;
+using Pinetime::Utility::LabelText;
+
+namespace {
+  // Formats with Utility::Format in buffers of every size up to 32 bytes, and compares with snprintf() on the same arguments.
+  // reference is the same format written for snprintf() (%u for the unsigned arguments).
+  template <typename... Args>
+  void CheckSame(const char* reference, Pinetime::Utility::Format::String<std::type_identity_t<Args>...> format, Args... args) {
+    for (size_t size = 0; size <= 32; size++) {
+      char expected[40];
+      char actual[40];
+      std::memset(expected, 'x', sizeof(expected));
+      std::memset(actual, 'x', sizeof(actual));
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wformat-nonliteral"
+#pragma GCC diagnostic ignored "-Wformat-truncation"
+      int length = std::snprintf(expected, size, reference, args...);
+#pragma GCC diagnostic pop
+      size_t written = FormatTo<Args...>(actual, size, format, args...);
+
+      // Write() returns the length of the truncated text
+      size_t expectedWritten = size == 0 ? 0 : std::min<size_t>(length, size - 1);
+      CHECK_EQUAL(expectedWritten, written);
+      CHECK(std::memcmp(expected, actual, sizeof(expected)) == 0);
+    }
+  }
+
+  void TestIntegers() {
+    CheckSame("%d", "%d", 0);
+    CheckSame("%d", "%d", 42);
+    CheckSame("%d", "%d", -42);
+    CheckSame("%d", "%d", INT32_MIN);
+    CheckSame("%d", "%d", INT32_MAX);
+    CheckSame("%u", "%d", UINT32_MAX);
+    CheckSame("%d", "%d", static_cast<int8_t>(-128));
+    CheckSame("%u", "%d", static_cast<uint16_t>(65535));
+    CheckSame("%5d", "%5d", -42);
+    CheckSame("%05d", "%05d", -42);
+    CheckSame("%02d", "%02d", -5);
+    CheckSame("%1d", "%1d", 12345);
+    CheckSame("%012d", "%012d", INT32_MIN);
+
+    std::minstd_rand random {1};
+    for (int i = 0; i < 10000; i++) {
+      int32_t value = static_cast<int32_t>(random() ^ (random() << 16));
+      uint32_t shift = random() % 32;
+      value >>= shift;
+      CheckSame("%d", "%d", value);
+      CheckSame("%4d", "%4d", value);
+      CheckSame("%03d", "%03d", value);
+      CheckSame("%u", "%d", static_cast<uint32_t>(value));
+    }
+  }
+
+  void TestText() {
+    CheckSame("", "");
+    CheckSame("100%%", "100%%");
+    CheckSame("%c", "%c", 'A');
+    CheckSame("%3c|", "%3c|", 'A');
+    CheckSame("%s", "%s", "");
+    CheckSame("%s steps", "%s steps", "12345");
+    CheckSame("[%8s]", "[%8s]", "abc");
+    CheckSame("[%2s]", "[%2s]", "abcdef");
+    const char* string = "a longer text than any of the buffers";
+    CheckSame("%s", "%s", string);
+  }
+
+  // The formats of the converted labels
+  void TestLabels() {
+    for (int hours = 0; hours < 24; hours++) {
+      for (int minutes = 0; minutes < 60; minutes++) {
+        CheckSame("%02d:%02d", "%02d:%02d", hours, minutes);
+        CheckSame("%2d:%02d", "%2d:%02d", hours, minutes);
+      }
+    }
+    for (uint8_t percent = 0; percent <= 100; percent++) {
+      CheckSame("%d%%", "%d%%", percent);
+    }
+    // The firmware passes uint32_t where it used %lu (long is 32 bits on the watch, 64 bits on the host)
+    CheckSame("%u", "%d", static_cast<uint32_t>(123456));
+    CheckSame("%d / %d", "%d / %d", static_cast<int32_t>(6543), static_cast<int32_t>(10000));
+    CheckSame("%c%c %d", "%c%c %d", 'T', 'H', 31);
+    CheckSame("%d%%%s", "%d%%%s", 100, " Charging");
+    CheckSame("%d%%%s", "%d%%%s", 5, "");
+
+    LabelText<6> time;
+    CHECK(std::strcmp("07:05", time.Format("%02d:%02d", 7, 5)) == 0);
+    CHECK(std::strcmp("07:05", time.Get()) == 0);
+    // The battery label of WatchFacePrideFlag, sized for the longest text
+    LabelText<14> battery;
+    CHECK(std::strcmp("100% Charging", battery.Format("%d%%%s", 100, " Charging")) == 0);
+    // Truncated to the size of the label
+    CHECK(std::strcmp("12345", time.Format("%d", 1234567)) == 0);
+  }
+}
+
+int main() {
+  TestIntegers();
+  TestText();
+  TestLabels();
+  return Pinetime::Test::Result();
+}
@@ -0,0 +1,130 @@
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <FreeRTOS.h>
+#include "Heap4.h"
+#include "Test.h"
+
+// Times vPortFree() followed by pvPortMalloc() in heap_tlsf_infinitime.c and in heap_4_infinitime.c it replaced, with
+// more and more live blocks of random sizes in the heap, like the objects of the screens and the strings of the services.
+// The heap is fragmented by random replacements first, then the same sequence is timed on both heaps. heap_4 walks its
+// list of free blocks, sorted by address, on every call: the second part times the allocation of a 512 bytes buffer
+// behind more and more small free blocks, its worst case. Host timings only compare the heaps.
+
+namespace {
+  struct Heap {
+    const char* name;
+    void* (*malloc)(size_t);
+    void (*free)(void*);
+    size_t (*freeSize)();
+  };
+
+  const Heap tlsf {"heap_tlsf", pvPortMalloc, vPortFree, xPortGetFreeHeapSize};
+  const Heap heap4 {"heap_4", pvHeap4Malloc, vHeap4Free, xHeap4GetFreeHeapSize};
+
+  constexpr std::array<size_t, 4> liveBlockCounts {50, 100, 200, 300};
+  constexpr int warmUp = 20000;
+  constexpr int iterations = 1000000;
+  constexpr std::array<size_t, 5> holeCounts {0, 50, 100, 200, 300};
+
+  size_t RandomSize(std::minstd_rand& random) {
+    return random() % 8 == 0 ? 16 + random() % 240 : 8 + random() % 56;
+  }
+
+  struct Result {
+    double nanoseconds;
+    uint32_t failures;
+    size_t freeSize;
+  };
+
+  Result Run(const Heap& heap, size_t liveBlocks) {
+    std::array<void*, liveBlockCounts.back()> blocks {};
+    std::minstd_rand random {1};
+    for (size_t i = 0; i < liveBlocks; i++) {
+      blocks[i] = heap.malloc(RandomSize(random));
+      CHECK(blocks[i] != nullptr);
+    }
+
+    uint32_t failures = 0;
+    auto replace = [&]() {
+      auto& block = blocks[random() % liveBlocks];
+      heap.free(block);
+      block = heap.malloc(RandomSize(random));
+      if (block == nullptr) {
+        failures++;
+      }
+    };
+    for (int i = 0; i < warmUp; i++) {
+      replace();
+    }
+    auto begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+      replace();
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - begin;
+    Result result {elapsed.count() / iterations, failures, heap.freeSize()};
+
+    for (size_t i = 0; i < liveBlocks; i++) {
+      heap.free(blocks[i]);
+    }
+    return result;
+  }
+
+  // Frees every other of 2 * holes blocks of 32 bytes, then times the allocation and the free of a buffer that only fits
+  // after them
+  double RunBehindHoles(const Heap& heap, size_t holes) {
+    std::array<void*, holeCounts.back() * 2> blocks {};
+    for (size_t i = 0; i < holes * 2; i++) {
+      blocks[i] = heap.malloc(32);
+      CHECK(blocks[i] != nullptr);
+    }
+    for (size_t i = 0; i < holes * 2; i += 2) {
+      heap.free(blocks[i]);
+    }
+
+    auto begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+      void* buffer = heap.malloc(512);
+      CHECK(buffer != nullptr);
+      heap.free(buffer);
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - begin;
+
+    for (size_t i = 1; i < holes * 2; i += 2) {
+      heap.free(blocks[i]);
+    }
+    return elapsed.count() / iterations;
+  }
+}
+
+int main() {
+  for (size_t liveBlocks : liveBlockCounts) {
+    auto resultTlsf = Run(tlsf, liveBlocks);
+    auto result4 = Run(heap4, liveBlocks);
+    std::printf("%3zu live blocks: heap_tlsf %5.1f ns, heap_4 %5.1f ns per vPortFree() and pvPortMalloc(), free heap %zu and %zu bytes\n",
+                liveBlocks,
+                resultTlsf.nanoseconds,
+                result4.nanoseconds,
+                resultTlsf.freeSize,
+                result4.freeSize);
+    CHECK_EQUAL(0u, resultTlsf.failures);
+    CHECK_EQUAL(0u, result4.failures);
+  }
+  // The time of heap_tlsf doesn't depend on the number of free blocks, with a large margin for the noise of the host
+  double tlsfFirstTime = 0;
+  for (size_t holes : holeCounts) {
+    double tlsfTime = RunBehindHoles(tlsf, holes);
+    if (holes == holeCounts.front()) {
+      tlsfFirstTime = tlsfTime;
+    }
+    CHECK(tlsfTime < tlsfFirstTime * 3);
+    double heap4Time = RunBehindHoles(heap4, holes);
+    std::printf("%3zu free blocks before the buffer: heap_tlsf %6.1f ns, heap_4 %6.1f ns per pvPortMalloc() and vPortFree()\n",
+                holes,
+                tlsfTime,
+                heap4Time);
+  }
+  return Pinetime::Test::Result();
+}
@@ -0,0 +1,285 @@
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <FreeRTOS.h>
+#include "Heap4.h"
+#include "Test.h"
+
+// Fuzzes heap_tlsf_infinitime.c, and heap_4_infinitime.c it replaced with the same sequence: random pvPortMalloc(),
+// pvPortRealloc() and vPortFree() calls, with the content of every live block checked, until the heap is full many times.
+// Then checks the semantics of pvPortRealloc(), the statistics of the TLSF heap and that freeing everything gives the
+// whole heap back in a single free block.
+
+// Start of the heap, declared as a pointer by heap_tlsf_infinitime.c
+extern "C" uint8_t __HeapLimit;
+
+namespace {
+  struct Heap {
+    const char* name;
+    void* (*malloc)(size_t);
+    void (*free)(void*);
+    void* (*realloc)(void*, size_t);
+    size_t (*freeSize)();
+    const uint8_t* begin;
+    const uint8_t* end;
+  };
+
+  const Heap tlsf {"heap_tlsf",
+                   pvPortMalloc,
+                   vPortFree,
+                   pvPortRealloc,
+                   xPortGetFreeHeapSize,
+                   &__HeapLimit,
+                   &__StackLimit};
+  const Heap heap4 {"heap_4",
+                    pvHeap4Malloc,
+                    vHeap4Free,
+                    pvHeap4Realloc,
+                    xHeap4GetFreeHeapSize,
+                    &__Heap4Limit,
+                    &__Heap4End};
+
+  constexpr int operations = 1000000;
+  constexpr size_t slotCount = 256;
+
+  // Mostly small blocks, like the objects and strings of the firmware, some buffers and a few large blocks
+  size_t RandomSize(std::minstd_rand& random) {
+    uint32_t kind = random() % 100;
+    if (kind < 80) {
+      return 1 + random() % 128;
+    }
+    if (kind < 98) {
+      return 1 + random() % 1024;
+    }
+    return 1 + random() % 8192;
+  }
+
+  // A live block and the seed of its content
+  struct Slot {
+    uint8_t* data = nullptr;
+    size_t size = 0;
+    uint8_t seed = 0;
+  };
+
+  void Fill(const Slot& slot) {
+    for (size_t i = 0; i < slot.size; i++) {
+      slot.data[i] = static_cast<uint8_t>(slot.seed + i * 7);
+    }
+  }
+
+  bool Intact(const Slot& slot, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+      if (slot.data[i] != static_cast<uint8_t>(slot.seed + i * 7)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool Valid(const Heap& heap, const void* data, size_t size) {
+    auto address = static_cast<const uint8_t*>(data);
+    return reinterpret_cast<uintptr_t>(data) % portBYTE_ALIGNMENT == 0 && address >= heap.begin && address + size <= heap.end;
+  }
+
+  struct Result {
+    uint32_t allocations = 0;
+    uint32_t failures = 0;
+    uint32_t corruptions = 0;
+  };
+
+  Result Fuzz(const Heap& heap, std::array<Slot, slotCount>& slots) {
+    std::minstd_rand random {1};
+    Result result;
+    uint8_t seed = 0;
+    for (int i = 0; i < operations; i++) {
+      auto& slot = slots[random() % slots.size()];
+      uint32_t action = random() % 2;
+      if (slot.data == nullptr) {
+        size_t size = RandomSize(random);
+        slot.data = static_cast<uint8_t*>(heap.malloc(size));
+        if (slot.data == nullptr) {
+          result.failures++;
+          continue;
+        }
+        CHECK(Valid(heap, slot.data, size));
+        slot.size = size;
+        slot.seed = seed++;
+        Fill(slot);
+        result.allocations++;
+      } else if (action == 0) {
+        if (!Intact(slot, slot.size)) {
+          result.corruptions++;
+        }
+        heap.free(slot.data);
+        slot = {};
+      } else {
+        // The content is kept up to the smallest of both sizes, the block is left untouched if the heap is full
+        size_t size = RandomSize(random);
+        auto data = static_cast<uint8_t*>(heap.realloc(slot.data, size));
+        if (data == nullptr) {
+          result.failures++;
+          if (!Intact(slot, slot.size)) {
+            result.corruptions++;
+          }
+          continue;
+        }
+        CHECK(Valid(heap, data, size));
+        slot.data = data;
+        if (!Intact(slot, std::min(size, slot.size))) {
+          result.corruptions++;
+        }
+        slot.size = size;
+        Fill(slot);
+        result.allocations++;
+      }
+
+      if (i % 10000 == 0) {
+        for (const auto& live : slots) {
+          if (live.data != nullptr && !Intact(live, live.size)) {
+            result.corruptions++;
+          }
+        }
+      }
+    }
+    return result;
+  }
+
+  void FreeAll(const Heap& heap, std::array<Slot, slotCount>& slots) {
+    for (auto& slot : slots) {
+      heap.free(slot.data);
+      slot = {};
+    }
+  }
+
+  // Returns the free size of a heap once initialized by its first allocation
+  size_t InitialFreeSize(const Heap& heap) {
+    heap.free(heap.malloc(1));
+    return heap.freeSize();
+  }
+
+  void TestFuzz(const Heap& heap) {
+    size_t initialFreeSize = InitialFreeSize(heap);
+    std::array<Slot, slotCount> slots {};
+    auto result = Fuzz(heap, slots);
+    std::printf("%-9s %d operations: %u allocations, %u failed (heap full), free heap %zu of %zu bytes\n",
+                heap.name,
+                operations,
+                result.allocations,
+                result.failures,
+                heap.freeSize(),
+                initialFreeSize);
+    CHECK_EQUAL(0u, result.corruptions);
+    CHECK(result.failures > 0);
+
+    FreeAll(heap, slots);
+    CHECK_EQUAL(initialFreeSize, heap.freeSize());
+  }
+
+  void TestRealloc(const Heap& heap) {
+    size_t initialFreeSize = heap.freeSize();
+
+    // Size 0 does nothing and returns NULL, the block stays allocated
+    Slot slot {static_cast<uint8_t*>(heap.malloc(40)), 40, 3};
+    CHECK(slot.data != nullptr);
+    Fill(slot);
+    CHECK(heap.realloc(slot.data, 0) == nullptr);
+    CHECK(Intact(slot, slot.size));
+
+    // Growing and shrinking keep the content
+    slot.data = static_cast<uint8_t*>(heap.realloc(slot.data, 1000));
+    CHECK(slot.data != nullptr && Intact(slot, 40));
+    slot.size = 1000;
+    Fill(slot);
+    slot.data = static_cast<uint8_t*>(heap.realloc(slot.data, 10));
+    CHECK(slot.data != nullptr && Intact(slot, 10));
+
+    // Larger than the heap: fails and leaves the block as it was
+    CHECK(heap.realloc(slot.data, 64 * 1024) == nullptr);
+    CHECK(Intact(slot, 10));
+    heap.free(slot.data);
+
+    // NULL allocates
+    void* data = heap.realloc(nullptr, 24);
+    CHECK(data != nullptr);
+    heap.free(data);
+
+    CHECK(heap.malloc(0) == nullptr);
+    CHECK(heap.malloc(64 * 1024) == nullptr);
+    CHECK_EQUAL(initialFreeSize, heap.freeSize());
+  }
+
+  uint32_t Sum(const uint16_t (&blocks)[portHEAP_SIZE_CLASS_COUNT]) {
+    uint32_t sum = 0;
+    for (auto count : blocks) {
+      sum += count;
+    }
+    return sum;
+  }
+
+  // Fills the heap with blocks of the same size, then frees them in random order: the blocks are counted in their size
+  // class, and all the free blocks are merged back in the end
+  void TestStatistics() {
+    HeapStatistics_t initial;
+    vPortGetHeapStatistics(&initial);
+    CHECK_EQUAL(1u, initial.xNumberOfFreeBlocks);
+    CHECK_EQUAL(0u, initial.ucFragmentation);
+    CHECK_EQUAL(0u, Sum(initial.usAllocatedBlocks));
+
+    std::array<void*, 1024> blocks {};
+    size_t count = 0;
+    while (count < blocks.size() && (blocks[count] = pvPortMalloc(100)) != nullptr) {
+      count++;
+    }
+    CHECK(count > 100 && count < blocks.size());
+    HeapStatistics_t full;
+    vPortGetHeapStatistics(&full);
+    CHECK_EQUAL(count, Sum(full.usAllocatedBlocks));
+    CHECK_EQUAL(count, full.xNumberOfSuccessfulAllocations - full.xNumberOfSuccessfulFrees);
+    // The last block may take the end of the heap when it is too small to be split, and be in the next class
+    auto sizeClass = std::max_element(std::begin(full.usAllocatedBlocks), std::end(full.usAllocatedBlocks));
+    CHECK(*sizeClass >= count - 1);
+    size_t classIndex = sizeClass - std::begin(full.usAllocatedBlocks);
+    CHECK(full.usPeakAllocatedBlocks[classIndex] >= count - 1);
+    CHECK(full.xFreeBytes < 100 + 16);
+    CHECK(full.xMinimumEverFreeBytes <= full.xFreeBytes);
+
+    // Every other block, the last one stays allocated: the free space is split in blocks of 100 bytes
+    for (size_t i = 0; i + 1 < count; i += 2) {
+      vPortFree(blocks[i]);
+      blocks[i] = nullptr;
+    }
+    HeapStatistics_t split;
+    vPortGetHeapStatistics(&split);
+    CHECK(split.ucFragmentation > 90);
+    CHECK(split.xLargestFreeBlock >= 100 && split.xLargestFreeBlock < 200);
+    CHECK(pvPortMalloc(200) == nullptr);
+
+    // The rest in random order, with the NULL pointers of the freed blocks, which vPortFree() ignores
+    std::minstd_rand random {1};
+    std::shuffle(blocks.begin(), blocks.begin() + count, random);
+    for (size_t i = 0; i < count; i++) {
+      vPortFree(blocks[i]);
+    }
+    HeapStatistics_t end;
+    vPortGetHeapStatistics(&end);
+    CHECK_EQUAL(initial.xFreeBytes, end.xFreeBytes);
+    CHECK_EQUAL(initial.xLargestFreeBlock, end.xLargestFreeBlock);
+    CHECK_EQUAL(1u, end.xNumberOfFreeBlocks);
+    CHECK_EQUAL(0u, end.ucFragmentation);
+    CHECK_EQUAL(0u, Sum(end.usAllocatedBlocks));
+    CHECK_EQUAL(end.xNumberOfSuccessfulAllocations, end.xNumberOfSuccessfulFrees);
+    CHECK(end.usPeakAllocatedBlocks[classIndex] >= count - 1);
+  }
+}
+
+int main() {
+  for (const auto* heap : {&tlsf, &heap4}) {
+    TestFuzz(*heap);
+    TestRealloc(*heap);
+  }
+  TestStatistics();
+  return Pinetime::Test::Result();
+}
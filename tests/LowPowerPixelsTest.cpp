@@ -0,0 +1,93 @@
+#include <cstdint>
+#include <vector>
+#include "displayapp/LowPowerPixels.h"
+#include "Test.h"
+
+using namespace Pinetime::Components;
+
+namespace {
+  // Pixels are RGB565 with swapped bytes, as in the LVGL buffers
+  void Store(uint8_t* pixel, uint16_t rgb565) {
+    pixel[0] = rgb565 >> 8;
+    pixel[1] = rgb565 & 0xff;
+  }
+
+  // Idle mode keeps the most significant bit of each channel
+  uint8_t ReferenceIdleColor(uint16_t rgb565) {
+    uint8_t red = rgb565 >> 11;
+    uint8_t green = (rgb565 >> 5) & 0x3f;
+    uint8_t blue = rgb565 & 0x1f;
+    return ((red >= 0x10) ? 0x04 : 0) | ((green >= 0x20) ? 0x02 : 0) | ((blue >= 0x10) ? 0x01 : 0);
+  }
+
+  void TestQuantize() {
+    std::vector<uint8_t> pixels(0x10000 * 2);
+    for (uint32_t color = 0; color < 0x10000; color++) {
+      Store(&pixels[color * 2], color);
+      CHECK_EQUAL(ReferenceIdleColor(color), LowPowerPixels::IdleColor(pixels[color * 2], pixels[color * 2 + 1]));
+    }
+
+    CHECK(LowPowerPixels::Quantize(pixels.data(), 0x10000));
+    for (uint32_t color = 0; color < 0x10000; color++) {
+      uint8_t idle = ReferenceIdleColor(color);
+      uint16_t expected = ((idle & 0x04) != 0 ? 0xf800 : 0) | ((idle & 0x02) != 0 ? 0x07e0 : 0) | ((idle & 0x01) != 0 ? 0x001f : 0);
+      CHECK_EQUAL(expected >> 8, pixels[color * 2]);
+      CHECK_EQUAL(expected & 0xff, pixels[color * 2 + 1]);
+    }
+
+    // Dark colours are black in idle mode
+    uint8_t dark[4];
+    Store(dark, 0x7bef);
+    Store(dark + 2, 0x0000);
+    CHECK(!LowPowerPixels::Quantize(dark, 2));
+    uint8_t lit[4];
+    Store(lit, 0x0000);
+    Store(lit + 2, 0x8000);
+    CHECK(LowPowerPixels::Quantize(lit, 2));
+  }
+
+  void TestPackTo12Bit() {
+    // All the pairs of the 8 idle mode colours
+    uint8_t pixels[64 * 2 * 2];
+    for (uint8_t i = 0; i < 64; i++) {
+      for (uint8_t j = 0; j < 2; j++) {
+        uint8_t idle = j == 0 ? i >> 3 : i & 7;
+        uint16_t color = ((idle & 0x04) != 0 ? 0x8000 : 0) | ((idle & 0x02) != 0 ? 0x0400 : 0) | ((idle & 0x01) != 0 ? 0x0010 : 0);
+        Store(&pixels[(i * 2 + j) * 2], color);
+      }
+    }
+
+    CHECK_EQUAL(64u * 3, LowPowerPixels::PackTo12Bit(pixels, 128));
+    auto channel = [](uint8_t idle, uint8_t bit) -> uint8_t {
+      return (idle & (1 << bit)) != 0 ? 0x0f : 0x00;
+    };
+    for (uint8_t i = 0; i < 64; i++) {
+      uint8_t first = i >> 3;
+      uint8_t second = i & 7;
+      CHECK_EQUAL((channel(first, 2) << 4) | channel(first, 1), pixels[i * 3]);
+      CHECK_EQUAL((channel(first, 0) << 4) | channel(second, 2), pixels[i * 3 + 1]);
+      CHECK_EQUAL((channel(second, 1) << 4) | channel(second, 0), pixels[i * 3 + 2]);
+    }
+
+    // A line of the display is sent in 360 bytes instead of 480
+    static_assert(LowPowerPixels::PackedSize(240) == 360);
+  }
+
+  void TestMemoryLines() {
+    using Lines = LowPowerPixels::Lines;
+    constexpr uint16_t totalNbLines = 320;
+    static_assert(LowPowerPixels::ToMemoryLines({10, 50}, 0, totalNbLines) == Lines {10, 50});
+    static_assert(LowPowerPixels::ToMemoryLines({0, 239}, 80, totalNbLines) == Lines {80, 319});
+    // After a vertical scroll, the visible lines wrap around the end of the display memory
+    static_assert(LowPowerPixels::ToMemoryLines({0, 239}, 240, totalNbLines) == Lines {240, 159});
+    static_assert(LowPowerPixels::ToMemoryLines({100, 120}, 300, totalNbLines) == Lines {80, 100});
+    CHECK(LowPowerPixels::ToMemoryLines({70, 90}, 240, totalNbLines) == (Lines {310, 10}));
+  }
+}
+
+int main() {
+  TestQuantize();
+  TestPackTo12Bit();
+  TestMemoryLines();
+  return Pinetime::Test::Result();
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// The generic fill and blend of LVGL 7 (lv_color_fill(), lv_color_mix() and the loops of lv_draw_blend.c) for
+// LV_COLOR_DEPTH 16 with LV_COLOR_16_SWAP, the reference of the kernels of displayapp/PixelBlend.h
+namespace Pinetime {
+  namespace Test {
+    namespace LvColor {
+      // lv_color16_t with LV_COLOR_16_SWAP
+      union Color {
+        struct {
+          uint16_t green_h : 3;
+          uint16_t red : 5;
+          uint16_t blue : 5;
+          uint16_t green_l : 3;
+        } ch;
+        uint16_t full;
+      };
+
+      constexpr uint32_t roundOffset = 128; // LV_COLOR_MIX_ROUND_OFS
+
+      // LV_MATH_UDIV255()
+      constexpr uint32_t Divide255(uint32_t x) {
+        return (x * 0x8081U) >> 0x17;
+      }
+
+      inline Color Make(uint8_t red, uint8_t green, uint8_t blue) {
+        Color color;
+        color.ch.red = red;
+        color.ch.green_h = green >> 3;
+        color.ch.green_l = green & 0x07;
+        color.ch.blue = blue;
+        return color;
+      }
+
+      inline uint8_t Green(Color color) {
+        return (color.ch.green_h << 3) | color.ch.green_l;
+      }
+
+      inline Color Mix(Color c1, Color c2, uint8_t mix) {
+        return Make(Divide255(c1.ch.red * mix + c2.ch.red * (255 - mix) + roundOffset),
+                    Divide255(Green(c1) * mix + Green(c2) * (255 - mix) + roundOffset),
+                    Divide255(c1.ch.blue * mix + c2.ch.blue * (255 - mix) + roundOffset));
+      }
+
+      inline void Fill(Color* dest, size_t length, Color color) {
+        for (size_t i = 0; i < length; i++) {
+          dest[i] = color;
+        }
+      }
+
+      inline void Blend(Color* dest, const Color* src, size_t length, uint8_t mix) {
+        for (size_t i = 0; i < length; i++) {
+          dest[i] = Mix(src[i], dest[i], mix);
+        }
+      }
+    }
+  }
+}
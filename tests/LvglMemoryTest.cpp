@@ -0,0 +1,193 @@
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+#include <FreeRTOS.h>
+#include "displayapp/LvglMemory.h"
+#include "Test.h"
+
+// Opens every user app from the watch face and the launcher thousands of times, with the allocations LVGL makes for their
+// screens, on LvglMemory and the FreeRTOS heap of the firmware (heap_tlsf_infinitime.c). Checks that all the memory of the
+// screens is freed when they are closed, and that the largest block that can be allocated on the watch face, such as a font
+// loaded from the external flash, doesn't shrink over time.
+
+using namespace Pinetime::Components;
+
+namespace {
+  // Counted in the sources of the screens: objects created, local style properties set and label texts set. The Screen
+  // itself is allocated in the heap by std::make_unique.
+  struct Screen {
+    const char* name;
+    uint16_t objects;
+    uint16_t styleProperties;
+    uint16_t texts;
+    uint16_t screenSize;
+  };
+
+  constexpr Screen clock {"Clock", 14, 12, 21, 160};
+  constexpr Screen launcher {"Launcher", 11, 6, 1, 240};
+  // The default user apps (USERAPP_TYPES), Paint draws without LVGL objects
+  constexpr std::array<Screen, 14> apps {{
+    {"StopWatch", 8, 10, 16, 120},
+    {"Alarm", 12, 9, 11, 100},
+    {"Timer", 7, 9, 6, 200},
+    {"Steps", 8, 13, 10, 80},
+    {"HeartRate", 5, 6, 9, 60},
+    {"Music", 16, 1, 15, 140},
+    {"Paint", 0, 0, 0, 40},
+    {"Paddle", 5, 9, 2, 60},
+    {"Twos", 2, 0, 2, 400},
+    {"Dice", 3, 4, 5, 120},
+    {"Metronome", 8, 3, 8, 80},
+    {"Navigation", 5, 10, 4, 180},
+    {"Calculator", 3, 21, 11, 180},
+    {"Weather", 7, 22, 15, 120},
+  }};
+
+  constexpr int cycles = 2000;
+  // A font loaded from the external flash when the watch face is shown
+  constexpr size_t fontSize = 6 * 1024;
+  constexpr size_t maxStringSize = 64;
+
+  // The allocations of an open screen, freed when it is closed
+  class OpenScreen {
+  public:
+    OpenScreen(const Screen& screen, std::minstd_rand& random) : random {random} {
+      screenObject = pvPortMalloc(screen.screenSize);
+      CHECK(screenObject != nullptr);
+      for (uint16_t i = 0; i < screen.objects; i++) {
+        // lv_obj_t with its node in the list of children, the data of the widget and its style list
+        Allocate(80 + random() % 16);
+        Allocate(16 + random() % 48);
+        Allocate(8);
+      }
+      for (uint16_t i = 0; i < screen.styleProperties; i++) {
+        Allocate(8 + random() % 24);
+      }
+      for (uint16_t i = 0; i < screen.texts; i++) {
+        texts.push_back(Allocate(2 + random() % 30));
+      }
+    }
+
+    // A refresh changes the texts of the labels: lv_label_set_text() frees the previous text and allocates the new one
+    void Refresh() {
+      for (auto& text : texts) {
+        if (random() % 4 == 0) {
+          Free(text);
+          text = Allocate(2 + random() % 30);
+        }
+      }
+    }
+
+    ~OpenScreen() {
+      // Children are deleted before their parents, in no particular order
+      std::shuffle(allocations.begin(), allocations.end(), random);
+      for (void* allocation : allocations) {
+        lvgl_memory_free(allocation);
+      }
+      vPortFree(screenObject);
+    }
+
+  private:
+    void* Allocate(size_t size) {
+      void* allocation = lvgl_memory_alloc(size);
+      CHECK(allocation != nullptr);
+      std::memset(allocation, 0xa5, size);
+      allocations.push_back(allocation);
+      return allocation;
+    }
+
+    void Free(void* allocation) {
+      allocations.erase(std::find(allocations.begin(), allocations.end(), allocation));
+      lvgl_memory_free(allocation);
+    }
+
+    std::minstd_rand& random;
+    void* screenObject;
+    std::vector<void*> allocations;
+    std::vector<void*> texts;
+  };
+
+  // On the watch face, with a font loaded for it: returns the largest allocation that can succeed once the font is freed
+  size_t ShowClock(std::minstd_rand& random) {
+    OpenScreen screen {clock, random};
+    void* font = lvgl_memory_alloc(fontSize);
+    CHECK(font != nullptr);
+    for (int i = 0; i < 5; i++) {
+      screen.Refresh();
+    }
+    lvgl_memory_free(font);
+    return LvglMemory::GetStatistics().largestFree;
+  }
+}
+
+int main() {
+  std::minstd_rand random {1};
+  // The services keep strings in the heap across screens (MusicService, NavigationService), reallocated on BLE updates
+  std::array<void*, 4> strings {};
+  auto updateStrings = [&]() {
+    for (auto& string : strings) {
+      string = pvPortRealloc(string, 8 + random() % (maxStringSize - 8));
+      CHECK(string != nullptr);
+    }
+  };
+
+  // Free heap outside of the largest free block, in the first and in the second half of the cycles: the strings of the
+  // services split the free space, by less than 1KB, but it must not grow with the cycles
+  constexpr size_t maxScattered = 1024;
+  std::array<size_t, 2> scattered {};
+  size_t minLargestFree = SIZE_MAX;
+  uint32_t leaks = 0;
+  for (int cycle = 0; cycle < cycles; cycle++) {
+    for (const auto& app : apps) {
+      size_t largestFree = ShowClock(random);
+      minLargestFree = std::min(minLargestFree, largestFree);
+      auto& half = scattered[cycle < cycles / 2 ? 0 : 1];
+      half = std::max(half, xPortGetFreeHeapSize() - xPortGetLargestFreeBlockSize());
+      if (LvglMemory::UsedSize() != 0) {
+        leaks++;
+      }
+
+      {
+        OpenScreen screen {launcher, random};
+      }
+      OpenScreen screen {app, random};
+      for (int i = 0; i < 20; i++) {
+        screen.Refresh();
+        if (i % 5 == 0) {
+          updateStrings();
+        }
+      }
+    }
+  }
+
+  auto statistics = LvglMemory::GetStatistics();
+  std::printf("%d cycles through %zu apps: LVGL used %zu bytes (peak %zu), %u heap allocations, largest free %zu bytes "
+              "(free heap outside of it: %zu bytes at most in the first half, %zu in the second)\n",
+              cycles,
+              apps.size(),
+              statistics.used,
+              statistics.peak,
+              statistics.heapAllocations,
+              minLargestFree,
+              scattered[0],
+              scattered[1]);
+  for (const auto& sizeClass : statistics.classes) {
+    std::printf("  %3u bytes: %2u/%2u blocks used, peak %2u\n", sizeClass.blockSize, sizeClass.used, sizeClass.nbBlocks, sizeClass.peak);
+  }
+
+  // No leak, and no fragmentation growth: the font can still be loaded in the same space
+  CHECK_EQUAL(0u, leaks);
+  // The slabs are large enough for the screens: only the fonts go to the heap
+  CHECK_EQUAL(static_cast<uint32_t>(cycles * apps.size()), statistics.heapAllocations);
+  CHECK(scattered[0] <= maxScattered);
+  CHECK(scattered[1] <= maxScattered);
+  CHECK(minLargestFree >= fontSize);
+  for (auto string : strings) {
+    vPortFree(string);
+  }
+  return Pinetime::Test::Result();
+}
@@ -0,0 +1,85 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "displayapp/PixelBlend.h"
+#include "LvColor.h"
+#include "Test.h"
+
+// Measures the pixels per microsecond of the fill and blend kernels of PixelBlend and of the generic LVGL loops, on lines of the
+// draw buffer. These are host timings, which only compare the paths: the compiler vectorizes the loops on the host,
+// the Cortex-M4 has no vector unit and uses REV16 in SwapPair.
+
+using namespace Pinetime::Components;
+namespace LvColor = Pinetime::Test::LvColor;
+
+namespace {
+  constexpr size_t lineLength = 240;
+  constexpr size_t lines = 4;
+  constexpr int iterations = 20000;
+
+  template <typename Function>
+  double PixelsPerMicrosecond(Function&& function) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+      function(i);
+    }
+    std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+    return iterations * lineLength * lines / elapsed.count();
+  }
+
+  uint32_t Checksum(const std::vector<uint16_t>& pixels) {
+    uint32_t sum = 0;
+    for (auto pixel : pixels) {
+      sum = sum * 31 + pixel;
+    }
+    return sum;
+  }
+}
+
+int main() {
+  std::minstd_rand random {1};
+  std::vector<uint16_t> src(lineLength * lines);
+  std::vector<uint16_t> initial(lineLength * lines);
+  for (size_t i = 0; i < src.size(); i++) {
+    src[i] = random();
+    initial[i] = random();
+  }
+  auto generic = initial;
+  auto kernel = initial;
+
+  // The opacity changes at each iteration, as in an animation, so that the results stay comparable
+  double genericBlend = PixelsPerMicrosecond([&](int i) {
+    for (size_t line = 0; line < lines; line++) {
+      LvColor::Blend(reinterpret_cast<LvColor::Color*>(&generic[line * lineLength]),
+                     reinterpret_cast<const LvColor::Color*>(&src[line * lineLength]),
+                     lineLength,
+                     i % 253);
+    }
+  });
+  double kernelBlend = PixelsPerMicrosecond([&](int i) {
+    for (size_t line = 0; line < lines; line++) {
+      PixelBlend::Blend(&kernel[line * lineLength], &src[line * lineLength], lineLength, i % 253);
+    }
+  });
+  CHECK_EQUAL(Checksum(generic), Checksum(kernel));
+
+  double genericFill = PixelsPerMicrosecond([&](int i) {
+    LvColor::Color color;
+    color.full = i;
+    for (size_t line = 0; line < lines; line++) {
+      LvColor::Fill(reinterpret_cast<LvColor::Color*>(&generic[line * lineLength]), lineLength, color);
+    }
+  });
+  double kernelFill = PixelsPerMicrosecond([&](int i) {
+    for (size_t line = 0; line < lines; line++) {
+      PixelBlend::Fill(&kernel[line * lineLength], lineLength, i);
+    }
+  });
+  CHECK_EQUAL(Checksum(generic), Checksum(kernel));
+
+  std::printf("blend: %7.1f pixels/us generic, %7.1f pixels/us PixelBlend\n", genericBlend, kernelBlend);
+  std::printf("fill:  %7.1f pixels/us generic, %7.1f pixels/us PixelBlend\n", genericFill, kernelFill);
+  return Pinetime::Test::Result();
+}
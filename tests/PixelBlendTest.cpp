@@ -0,0 +1,99 @@
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "displayapp/PixelBlend.h"
+#include "LvColor.h"
+#include "Test.h"
+
+using namespace Pinetime::Components;
+namespace LvColor = Pinetime::Test::LvColor;
+
+namespace {
+  std::vector<uint16_t> RandomPixels(std::minstd_rand& random, size_t length) {
+    std::vector<uint16_t> pixels(length);
+    for (auto& pixel : pixels) {
+      pixel = static_cast<uint16_t>(random());
+    }
+    return pixels;
+  }
+
+  // Every pair of channel values, for every mix, in both pixels of a pair
+  void TestMixAllChannels() {
+    for (uint32_t mix = 0; mix <= 255; mix++) {
+      for (uint8_t foreground = 0; foreground < 64; foreground++) {
+        uint16_t src[64];
+        uint16_t dest[64];
+        LvColor::Color expected[64];
+        for (uint8_t background = 0; background < 64; background++) {
+          auto fg = LvColor::Make(foreground & 0x1f, foreground, 0x1f - (foreground & 0x1f));
+          auto bg = LvColor::Make(background & 0x1f, background, 0x1f - (background & 0x1f));
+          src[background] = fg.full;
+          dest[background] = bg.full;
+          expected[background] = LvColor::Mix(fg, bg, mix);
+        }
+
+        PixelBlend::Blend(dest, src, 64, mix);
+        for (uint8_t background = 0; background < 64; background++) {
+          CHECK_EQUAL(expected[background].full, dest[background]);
+        }
+      }
+    }
+  }
+
+  // Random pixels, lengths and alignments, including the last pixel of odd lengths
+  void TestBlend() {
+    std::minstd_rand random {1};
+    for (int iteration = 0; iteration < 2000; iteration++) {
+      size_t length = random() % 250;
+      size_t srcOffset = random() % 2;
+      size_t destOffset = random() % 2;
+      uint8_t mix = random();
+      auto src = RandomPixels(random, length + srcOffset);
+      auto dest = RandomPixels(random, length + destOffset + 1);
+      std::vector<LvColor::Color> expected(dest.size());
+      for (size_t i = 0; i < dest.size(); i++) {
+        expected[i].full = dest[i];
+      }
+
+      LvColor::Blend(expected.data() + destOffset, reinterpret_cast<const LvColor::Color*>(src.data() + srcOffset), length, mix);
+      PixelBlend::Blend(dest.data() + destOffset, src.data() + srcOffset, length, mix);
+      for (size_t i = 0; i < dest.size(); i++) {
+        CHECK_EQUAL(expected[i].full, dest[i]);
+      }
+    }
+  }
+
+  void TestFill() {
+    std::minstd_rand random {2};
+    for (int iteration = 0; iteration < 2000; iteration++) {
+      size_t length = random() % 250;
+      size_t offset = random() % 2;
+      LvColor::Color color;
+      color.full = random();
+      auto dest = RandomPixels(random, length + offset + 1);
+      std::vector<LvColor::Color> expected(dest.size());
+      for (size_t i = 0; i < dest.size(); i++) {
+        expected[i].full = dest[i];
+      }
+
+      LvColor::Fill(expected.data() + offset, length, color);
+      PixelBlend::Fill(dest.data() + offset, length, color.full);
+      for (size_t i = 0; i < dest.size(); i++) {
+        CHECK_EQUAL(expected[i].full, dest[i]);
+      }
+    }
+  }
+
+  void TestSwapPair() {
+    CHECK_EQUAL(0x34127856U, PixelBlend::SwapPair(0x12345678U));
+    static_assert(PixelBlend::DivideBy255(0x3f403f40U) == 0x003f003fU);
+  }
+}
+
+int main() {
+  TestSwapPair();
+  TestMixAllChannels();
+  TestBlend();
+  TestFill();
+  return Pinetime::Test::Result();
+}
@@ -0,0 +1,147 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+#include "displayapp/ReadAhead.h"
+#include "Test.h"
+
+using Pinetime::Components::ReadAhead;
+
+namespace {
+  // A file read by ReadAhead, which counts the reads that would go to FS::FileRead and lfs_file_read
+  class File {
+  public:
+    explicit File(size_t size) : content(size) {
+      for (size_t i = 0; i < size; i++) {
+        content[i] = static_cast<uint8_t>((i * 13) ^ (i >> 7));
+      }
+      readAhead.Reset();
+    }
+
+    // Read of the LVGL driver
+    bool Read(uint8_t* buffer, uint32_t btr, uint32_t* br) {
+      return readAhead.Read(buffer, btr, br, [this](uint32_t position, uint8_t* data, uint32_t size) {
+        fetches++;
+        if (failing) {
+          return -1;
+        }
+        uint32_t read = std::min<uint32_t>(size, content.size() - std::min<size_t>(position, content.size()));
+        std::memcpy(data, content.data() + position, read);
+        return static_cast<int>(read);
+      });
+    }
+
+    void Seek(uint32_t position) {
+      readAhead.position = position;
+    }
+
+    std::vector<uint8_t> content;
+    ReadAhead readAhead;
+    uint32_t fetches = 0;
+    bool failing = false;
+  };
+
+  // Random reads and seeks return the content of the file, and short reads at its end
+  void TestRandomReads() {
+    File file {5000};
+    std::minstd_rand random {1};
+    uint8_t buffer[400];
+    for (int i = 0; i < 20000; i++) {
+      if (random() % 4 == 0) {
+        file.Seek(random() % (file.content.size() + 10));
+      }
+      uint32_t position = file.readAhead.position;
+      // Mostly small reads, like the font and image decoders
+      uint32_t size = random() % 3 == 0 ? random() % sizeof(buffer) : random() % 16;
+      uint32_t read = 0;
+      CHECK(file.Read(buffer, size, &read));
+
+      uint32_t expected = position < file.content.size() ? std::min<uint32_t>(size, file.content.size() - position) : 0;
+      CHECK_EQUAL(expected, read);
+      CHECK(std::equal(buffer, buffer + read, file.content.begin() + position));
+      CHECK_EQUAL(position + read, file.readAhead.position);
+    }
+  }
+
+  void TestErrors() {
+    File file {1000};
+    uint8_t buffer[16];
+    uint32_t read = 0;
+    file.failing = true;
+    CHECK(!file.Read(buffer, sizeof(buffer), &read));
+    CHECK_EQUAL(0u, read);
+
+    // Buffered data is still returned once the file fails
+    file.failing = false;
+    CHECK(file.Read(buffer, sizeof(buffer), &read));
+    file.failing = true;
+    CHECK(file.Read(buffer, sizeof(buffer), &read));
+    CHECK_EQUAL(sizeof(buffer), read);
+  }
+
+  // Replays the reads of lv_font_load() (lv_font_loader.c of LVGL 7) on a font of 96 glyphs: the tables are read entry
+  // by entry, and the glyph descriptors bit by bit, one byte per read. Returns the number of reads of the file.
+  uint32_t LoadFont(File& file) {
+    constexpr uint32_t glyphs = 96;
+    constexpr uint32_t bitmapSize = 60;
+    uint8_t buffer[ReadAhead::size];
+    uint32_t read = 0;
+    uint32_t fetches = file.fetches;
+    file.Seek(0);
+    auto readBytes = [&](uint32_t size) {
+      CHECK(file.Read(buffer, size, &read));
+      CHECK_EQUAL(size, read);
+    };
+
+    // "head": length and label, then the header
+    readBytes(4);
+    readBytes(4);
+    readBytes(40);
+    // "cmap": length, label, number of subtables, one header per subtable and its glyph ids
+    readBytes(4);
+    readBytes(4);
+    readBytes(4);
+    for (int i = 0; i < 2; i++) {
+      readBytes(16);
+    }
+    readBytes(2 * glyphs / 2);
+    readBytes(2 * glyphs / 2);
+    // "loca": length, label, count and one offset per glyph
+    readBytes(4);
+    readBytes(4);
+    readBytes(4);
+    for (uint32_t i = 0; i < glyphs; i++) {
+      readBytes(4);
+    }
+    // "glyf": length and label, then for each glyph the advance width and the box, read bit by bit, and the bitmap
+    readBytes(4);
+    readBytes(4);
+    uint32_t glyf = file.readAhead.position;
+    for (uint32_t i = 0; i < glyphs; i++) {
+      file.Seek(glyf + i * (5 + bitmapSize));
+      for (int j = 0; j < 5; j++) {
+        readBytes(1);
+      }
+      readBytes(bitmapSize);
+    }
+    return file.fetches - fetches;
+  }
+
+  void TestFontLoad() {
+    File file {16 * 1024};
+    uint32_t fetches = LoadFont(file);
+
+    // Without the buffer, each read of the loader goes to the file
+    uint32_t reads = 3 + 3 + 2 + 2 + 3 + 96 + 2 + 96 * 6;
+    std::printf("lv_font_load: %u lfs_file_read calls with read-ahead, %u without\n", fetches, reads);
+    CHECK(fetches * 4 < reads);
+  }
+}
+
+int main() {
+  TestRandomReads();
+  TestErrors();
+  TestFontLoad();
+  return Pinetime::Test::Result();
+}
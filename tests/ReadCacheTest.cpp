@@ -0,0 +1,171 @@
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <vector>
+#include "components/fs/ReadCache.h"
+#include "Test.h"
+
+using Pinetime::Controllers::ReadCache;
+
+namespace {
+  using Cache = ReadCache<256, 4>;
+  constexpr size_t flashSize = 64 * 1024;
+  constexpr size_t eraseSize = 4096;
+
+  // Backing memory of the cache, with the semantics of a NOR flash
+  class Flash {
+  public:
+    Flash() : memory(flashSize) {
+      for (size_t i = 0; i < flashSize; i++) {
+        memory[i] = static_cast<uint8_t>(i ^ (i >> 8));
+      }
+    }
+
+    void Read(Cache& cache, uint32_t address, uint8_t* buffer, size_t size) {
+      cache.Read(address, buffer, size, [this](uint32_t lineAddress, uint8_t* line, size_t lineSize) {
+        CHECK_EQUAL(0u, lineAddress % Cache::lineSize);
+        std::memcpy(line, memory.data() + lineAddress, lineSize);
+        fetches++;
+      });
+    }
+
+    void Program(Cache& cache, uint32_t address, const uint8_t* data, size_t size) {
+      for (size_t i = 0; i < size; i++) {
+        memory[address + i] &= data[i];
+      }
+      cache.Write(address, data, size);
+    }
+
+    void Erase(Cache& cache, uint32_t address) {
+      std::fill_n(memory.begin() + address, eraseSize, 0xff);
+      cache.Invalidate(address, eraseSize);
+    }
+
+    std::vector<uint8_t> memory;
+    uint32_t fetches = 0;
+  };
+
+  bool Matches(const Flash& flash, uint32_t address, const uint8_t* buffer, size_t size) {
+    return std::memcmp(flash.memory.data() + address, buffer, size) == 0;
+  }
+
+  void TestHitsAndEviction() {
+    Flash flash;
+    Cache cache;
+    uint8_t buffer[16];
+
+    flash.Read(cache, 0x100, buffer, sizeof(buffer));
+    flash.Read(cache, 0x110, buffer, sizeof(buffer));
+    CHECK_EQUAL(1u, flash.fetches);
+    CHECK_EQUAL(1u, cache.GetStatistics().hits);
+    CHECK_EQUAL(1u, cache.GetStatistics().misses);
+
+    // A read across two lines fetches both
+    uint8_t straddling[32];
+    flash.Read(cache, 0x1F0, straddling, sizeof(straddling));
+    CHECK(Matches(flash, 0x1F0, straddling, sizeof(straddling)));
+    CHECK_EQUAL(2u, flash.fetches);
+
+    // Fill the 4 lines (0x100, 0x200, 0x300, 0x400), use 0x100 again: 0x200 is the least recently used line
+    flash.Read(cache, 0x300, buffer, sizeof(buffer));
+    flash.Read(cache, 0x400, buffer, sizeof(buffer));
+    flash.Read(cache, 0x100, buffer, sizeof(buffer));
+    CHECK_EQUAL(4u, flash.fetches);
+    flash.Read(cache, 0x500, buffer, sizeof(buffer));
+    CHECK_EQUAL(5u, flash.fetches);
+    flash.Read(cache, 0x100, buffer, sizeof(buffer));
+    CHECK_EQUAL(5u, flash.fetches);
+    flash.Read(cache, 0x200, buffer, sizeof(buffer));
+    CHECK_EQUAL(6u, flash.fetches);
+  }
+
+  void TestEraseInvalidates() {
+    Flash flash;
+    Cache cache;
+    uint8_t buffer[16];
+
+    flash.Read(cache, 0x0FF0, buffer, sizeof(buffer));
+    flash.Read(cache, 0x1000, buffer, sizeof(buffer));
+    flash.Read(cache, 0x1F00, buffer, sizeof(buffer));
+    flash.Read(cache, 0x2000, buffer, sizeof(buffer));
+    CHECK_EQUAL(4u, flash.fetches);
+
+    // Only the lines of the erased sector are dropped
+    flash.Erase(cache, 0x1000);
+    flash.Read(cache, 0x1000, buffer, sizeof(buffer));
+    CHECK(std::all_of(buffer, buffer + sizeof(buffer), [](uint8_t b) {
+      return b == 0xff;
+    }));
+    flash.Read(cache, 0x1F00, buffer, sizeof(buffer));
+    CHECK(Matches(flash, 0x1F00, buffer, sizeof(buffer)));
+    CHECK_EQUAL(6u, flash.fetches);
+    flash.Read(cache, 0x0FF0, buffer, sizeof(buffer));
+    flash.Read(cache, 0x2000, buffer, sizeof(buffer));
+    CHECK_EQUAL(6u, flash.fetches);
+  }
+
+  void TestProgramWritesThrough() {
+    Flash flash;
+    Cache cache;
+    uint8_t buffer[64];
+
+    flash.Erase(cache, 0x3000);
+    flash.Read(cache, 0x30C0, buffer, sizeof(buffer));
+    CHECK_EQUAL(1u, flash.fetches);
+
+    // The program covers the end of the cached line and the start of the next one, which is not cached
+    uint8_t data[96];
+    for (size_t i = 0; i < sizeof(data); i++) {
+      data[i] = static_cast<uint8_t>(i);
+    }
+    flash.Program(cache, 0x30E0, data, sizeof(data));
+    uint8_t read[128];
+    flash.Read(cache, 0x30C0, read, sizeof(read));
+    CHECK(Matches(flash, 0x30C0, read, sizeof(read)));
+    CHECK(std::memcmp(read + 0x20, data, sizeof(data)) == 0);
+    CHECK_EQUAL(2u, flash.fetches);
+  }
+
+  // Random reads, programs and erases, the cache must always return the content of the flash
+  void TestRandomOperations() {
+    Flash flash;
+    Cache cache;
+    std::minstd_rand random {42};
+    std::vector<uint8_t> buffer(1024);
+    bool consistent = true;
+
+    for (int i = 0; i < 20000; i++) {
+      // Accesses are concentrated on two sectors so that lines are reused, and are mostly small like those of LittleFS
+      uint32_t address = random() % (2 * eraseSize);
+      size_t size = 1 + random() % ((random() % 8) == 0 ? buffer.size() : 32);
+      switch (random() % 16) {
+        case 0:
+          flash.Erase(cache, address & ~(eraseSize - 1));
+          break;
+        case 1:
+        case 2:
+        case 3:
+          // LittleFS only programs erased bytes, the programmed value is then what the flash holds
+          for (size_t j = 0; j < size; j++) {
+            buffer[j] = static_cast<uint8_t>(random()) & flash.memory[address + j];
+          }
+          flash.Program(cache, address, buffer.data(), size);
+          break;
+        default:
+          flash.Read(cache, address, buffer.data(), size);
+          consistent = consistent && Matches(flash, address, buffer.data(), size);
+          break;
+      }
+    }
+    CHECK(consistent);
+    CHECK(cache.GetStatistics().hits > 0);
+  }
+}
+
+int main() {
+  TestHitsAndEviction();
+  TestEraseInvalidates();
+  TestProgramWritesThrough();
+  TestRandomOperations();
+  return Pinetime::Test::Result();
+}
@@ -0,0 +1,221 @@
+#include <algorithm>
+#include <array>
+#include <cinttypes>
+#include <cstdio>
+#include <FreeRTOS.h>
+#include "displayapp/RefreshGovernor.h"
+#include "Test.h"
+
+// Simulates the loop of DisplayApp while running during a session of one minute: the user drags a list for 2 seconds,
+// which starts a scroll animation, then leaves a watch face that is updated by the update bus twice. It counts the wake-ups
+// of the display task and the runs of the LVGL tasks at each level of RefreshGovernor, and with the fixed period of
+// LV_DISP_DEF_REFR_PERIOD. The CPU time is estimated from the cost of each operation below (estimates, not measured on the
+// watch); the frames themselves are the same in both modes and are not counted in it.
+
+using Pinetime::Applications::RefreshGovernor;
+
+namespace {
+  // Estimated cost, in µs, of a wake-up of the display task (context switch, DisplayApp::Refresh and lv_task_handler),
+  // of a run of the touch panel read task (touchpad_read returns the last point) and of a run of the refresh task
+  // without anything to draw
+  constexpr uint32_t wakeUpCost = 60;
+  constexpr uint32_t readCost = 20;
+  constexpr uint32_t refreshCost = 40;
+
+  constexpr TickType_t sessionEnd = pdMS_TO_TICKS(60000);
+  constexpr TickType_t touchStart = pdMS_TO_TICKS(1000);
+  constexpr TickType_t touchEnd = pdMS_TO_TICKS(3000);
+  constexpr TickType_t animationEnd = pdMS_TO_TICKS(3250);
+  // The touch panel reports a point every 10ms while touched, each one is a message to the display task
+  constexpr TickType_t touchReportPeriod = pdMS_TO_TICKS(10);
+  constexpr std::array<TickType_t, 2> updates {pdMS_TO_TICKS(20000), pdMS_TO_TICKS(50000)};
+  constexpr uint32_t animationPeriod = 20; // LV_DISP_DEF_REFR_PERIOD, the lv_anim task is not retimed
+
+  bool IsTouching(TickType_t now) {
+    return now >= touchStart && now < touchEnd;
+  }
+
+  bool IsAnimating(TickType_t now) {
+    return now >= touchEnd && now < animationEnd;
+  }
+
+  // Time of the next message to the display task after now
+  TickType_t NextMessage(TickType_t now) {
+    TickType_t next = sessionEnd;
+    if (now < touchEnd) {
+      next = std::max<TickType_t>(touchStart, now - (now % touchReportPeriod) + touchReportPeriod);
+    }
+    for (auto update : updates) {
+      if (update > now) {
+        next = std::min(next, update);
+      }
+    }
+    return next;
+  }
+
+  // lv_task_t: runs once period has elapsed since its last run, or at the next lv_task_handler() once made ready
+  struct LvTask {
+    uint32_t period;
+    TickType_t lastRun = 0;
+    bool ready = false;
+
+    bool Due(TickType_t now) const {
+      return ready || now - lastRun >= period;
+    }
+
+    void Run(TickType_t now) {
+      lastRun = now;
+      ready = false;
+    }
+
+    TickType_t Remaining(TickType_t now) const {
+      return Due(now) ? 0 : lastRun + period - now;
+    }
+  };
+
+  struct Statistics {
+    TickType_t time = 0;
+    uint32_t wakeUps = 0;
+    uint32_t reads = 0;
+    uint32_t refreshes = 0;
+    uint32_t frames = 0;
+    TickType_t maxLatency = 0;
+
+    uint64_t CpuTime() const {
+      return (static_cast<uint64_t>(wakeUps) * wakeUpCost) + (static_cast<uint64_t>(reads) * readCost) +
+             (static_cast<uint64_t>(refreshes - frames) * refreshCost);
+    }
+  };
+
+  // Returns the statistics of each level of the governor, or of the fixed period in the first element
+  std::array<Statistics, RefreshGovernor::levels.size()> Run(bool governed) {
+    std::array<Statistics, RefreshGovernor::levels.size()> statistics {};
+    RefreshGovernor governor;
+    LvTask refresh {RefreshGovernor::levels[0].period};
+    LvTask read {RefreshGovernor::levels[0].period};
+    LvTask animation {animationPeriod};
+    bool invalidated = false;
+    TickType_t invalidatedAt = 0;
+    auto invalidate = [&](TickType_t now) {
+      if (!invalidated) {
+        invalidated = true;
+        invalidatedAt = now;
+      }
+    };
+
+    TickType_t now = 0;
+    governor.Restart(now);
+    while (now < sessionEnd) {
+      // DisplayApp::UpdateRefreshRate(): LittleVgl::SetRefreshPeriod() and RefreshIfInvalidated() make both tasks ready
+      if (governed) {
+        bool changed = governor.Update(now, IsTouching(now) || IsAnimating(now));
+        if (changed) {
+          refresh.period = governor.Period();
+          read.period = governor.Period();
+        }
+        if (changed || invalidated) {
+          refresh.ready = true;
+          read.ready = true;
+        }
+      }
+      auto& level = statistics[governor.Level()];
+      level.wakeUps++;
+
+      // lv_task_handler(): the animation task only runs while an animation exists
+      if (IsAnimating(now) && animation.Due(now)) {
+        animation.Run(now);
+        invalidate(now);
+      }
+      if (read.Due(now)) {
+        read.Run(now);
+        level.reads++;
+        // The dragged list follows the finger
+        if (IsTouching(now)) {
+          invalidate(now);
+        }
+      }
+      if (refresh.Due(now)) {
+        refresh.Run(now);
+        level.refreshes++;
+        if (invalidated) {
+          level.frames++;
+          level.maxLatency = std::max(level.maxLatency, now - invalidatedAt);
+          invalidated = false;
+        }
+      }
+      TickType_t timeout = std::min(refresh.Remaining(now), read.Remaining(now));
+      if (IsAnimating(now)) {
+        timeout = std::min(timeout, animation.Remaining(now));
+      }
+
+      // xQueueReceive(msgQueue, &msg, queueTimeout): a message wakes the task before the timeout
+      TickType_t next = std::min(now + timeout, NextMessage(now));
+      if (next == now) {
+        next++;
+      }
+      level.time += next - now;
+      now = next;
+      if (std::find(updates.begin(), updates.end(), now) != updates.end()) {
+        // The screen changes a label in its update bus callback
+        invalidate(now);
+      }
+    }
+    return statistics;
+  }
+
+  void Print(const char* name, const Statistics& statistics) {
+    float seconds = static_cast<float>(statistics.time) / configTICK_RATE_HZ;
+    std::printf("  %-14s %6.1f s %6" PRIu32 " wake-ups (%5.1f/s) %6" PRIu32 " reads %6" PRIu32 " refreshes %5" PRIu32
+                " frames, max latency %3" PRIu32 " ticks, CPU %7.2f ms (%5.2f ms/s)\n",
+                name,
+                seconds,
+                statistics.wakeUps,
+                statistics.wakeUps / seconds,
+                statistics.reads,
+                statistics.refreshes,
+                statistics.frames,
+                statistics.maxLatency,
+                statistics.CpuTime() / 1000.0f,
+                statistics.CpuTime() / 1000.0f / seconds);
+  }
+
+  Statistics Total(const std::array<Statistics, RefreshGovernor::levels.size()>& levels) {
+    Statistics total;
+    for (const auto& level : levels) {
+      total.time += level.time;
+      total.wakeUps += level.wakeUps;
+      total.reads += level.reads;
+      total.refreshes += level.refreshes;
+      total.frames += level.frames;
+      total.maxLatency = std::max(total.maxLatency, level.maxLatency);
+    }
+    return total;
+  }
+}
+
+int main() {
+  auto fixed = Run(false)[0];
+  auto governed = Run(true);
+  auto total = Total(governed);
+
+  std::printf("Fixed period of %" PRIu32 " ms\n", RefreshGovernor::levels[0].period);
+  Print("total", fixed);
+  std::printf("RefreshGovernor\n");
+  for (size_t i = 0; i < governed.size(); i++) {
+    char name[16];
+    std::snprintf(name, sizeof(name), "%" PRIu32 " ms", RefreshGovernor::levels[i].period);
+    Print(name, governed[i]);
+  }
+  Print("total", total);
+
+  CHECK_EQUAL(sessionEnd, total.time);
+  // Every level is used, the static screen wakes the task once per period and the changes are drawn at the full rate
+  for (const auto& level : governed) {
+    CHECK(level.time > 0);
+  }
+  const auto& slowest = governed.back();
+  CHECK(slowest.wakeUps <= slowest.time / RefreshGovernor::levels.back().period + 1 + updates.size() * 2);
+  CHECK(total.wakeUps * 3 < fixed.wakeUps);
+  CHECK(total.maxLatency <= RefreshGovernor::levels[0].period);
+  return Pinetime::Test::Result();
+}
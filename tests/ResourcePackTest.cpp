@@ -0,0 +1,166 @@
+#include <algorithm>
+#include <cstring>
+#include "components/fs/ResourcePack.h"
+#include "components/fs/Superblock.h"
+#include "drivers/Spi.h"
+#include "drivers/SpiNorFlash.h"
+#include "ResourcePackImage.h"
+#include "Test.h"
+
+using Pinetime::Controllers::ResourcePack;
+using Pinetime::Controllers::Superblock;
+using Pinetime::Drivers::Spi;
+using Pinetime::Drivers::SpiNorFlash;
+
+namespace {
+  constexpr uint32_t packAddress = 0x380000;
+  constexpr size_t packSize = 0x80000;
+
+  // Start of a superblock block, as written by lfs_format(): the revision, then the CREATE, SUPERBLOCK
+  // and INLINESTRUCT tags of the first commit
+  class SuperblockImage {
+  public:
+    SuperblockImage(uint32_t revision, uint32_t blockCount, uint16_t id = 0) {
+      Append32(revision);
+      AppendTag(0x401, id, 0);
+      AppendTag(0x0ff, id, 8);
+      data.insert(data.end(), {'l', 'i', 't', 't', 'l', 'e', 'f', 's'});
+      AppendTag(0x201, id, 24);
+      for (uint32_t value : {0x00020000u, 4096u, blockCount, 255u, 0x7fffffffu, 1022u}) {
+        Append32(value);
+      }
+      AppendTag(0x500, 0x3ff, 4);
+      Append32(0x12345678);
+      data.resize(Superblock::readSize, 0xff);
+    }
+
+    std::vector<uint8_t> data;
+
+  private:
+    void Append32(uint32_t value) {
+      for (int i = 0; i < 4; i++) {
+        data.push_back(static_cast<uint8_t>(value >> (8 * i)));
+      }
+    }
+
+    void AppendTag(uint16_t type, uint16_t id, uint16_t length) {
+      uint32_t tag = (static_cast<uint32_t>(type) << 20) | (static_cast<uint32_t>(id) << 10) | length;
+      uint32_t stored = tag ^ previous;
+      previous = tag;
+      for (int i = 3; i >= 0; i--) {
+        data.push_back(static_cast<uint8_t>(stored >> (8 * i)));
+      }
+    }
+
+    uint32_t previous = 0xffffffff;
+  };
+
+  void TestSuperblock() {
+    uint32_t revision = 0;
+    uint32_t blockCount = 0;
+    SuperblockImage image {5, 844};
+    CHECK(Superblock::Parse(image.data.data(), image.data.size(), revision, blockCount));
+    CHECK_EQUAL(5u, revision);
+    CHECK_EQUAL(844u, blockCount);
+
+    // Erased flash
+    std::vector<uint8_t> erased(Superblock::readSize, 0xff);
+    CHECK(!Superblock::Parse(erased.data(), erased.size(), revision, blockCount));
+
+    // Truncated before the block count
+    CHECK(!Superblock::Parse(image.data.data(), 40, revision, blockCount));
+
+    // The entry of another file
+    SuperblockImage otherId {5, 844, 1};
+    CHECK(!Superblock::Parse(otherId.data.data(), otherId.data.size(), revision, blockCount));
+
+    // Corrupted name
+    SuperblockImage corrupted {5, 844};
+    corrupted.data[12] = 'L';
+    CHECK(!Superblock::Parse(corrupted.data.data(), corrupted.data.size(), revision, blockCount));
+  }
+
+  void TestResourcePack() {
+    Spi spi;
+    SpiNorFlash flash {spi};
+    flash.Init();
+
+    std::vector<uint8_t> font(5000);
+    for (size_t i = 0; i < font.size(); i++) {
+      font[i] = static_cast<uint8_t>(i * 3);
+    }
+    auto image = Pinetime::Simulation::BuildResourcePack({{"/fonts/lv_font_dots_40.bin", font}, {"/images/pine_small.bin", {1, 2, 3}}});
+    std::copy(image.begin(), image.end(), spi.Memory().begin() + packAddress);
+
+    ResourcePack pack {flash, packAddress, packSize};
+    pack.Init();
+    CHECK(pack.IsValid());
+
+    ResourcePack::Entry entry;
+    CHECK(!pack.Find("/fonts/missing.bin", entry));
+    CHECK(pack.Find("/fonts/lv_font_dots_40.bin", entry));
+    CHECK_EQUAL(font.size(), entry.size);
+
+    // Reads are clamped to the end of the file
+    std::vector<uint8_t> read(font.size());
+    CHECK_EQUAL(1000u, pack.Read(entry, 0, read.data(), 1000));
+    CHECK_EQUAL(font.size() - 1000, pack.Read(entry, 1000, read.data() + 1000, font.size()));
+    CHECK(read == font);
+    CHECK_EQUAL(0u, pack.Read(entry, font.size(), read.data(), 1));
+
+    CHECK(pack.Find("/images/pine_small.bin", entry));
+    uint8_t small[8];
+    CHECK_EQUAL(3u, pack.Read(entry, 0, small, sizeof(small)));
+    CHECK_EQUAL(3, small[2]);
+
+    pack.Disable();
+    CHECK(!pack.Find("/images/pine_small.bin", entry));
+  }
+
+  void TestInvalidResourcePack() {
+    Spi spi;
+    SpiNorFlash flash {spi};
+    flash.Init();
+    auto image = Pinetime::Simulation::BuildResourcePack({{"/a.bin", {1, 2, 3}}});
+    ResourcePack::Header header;
+    std::memcpy(&header, image.data(), sizeof(header));
+    ResourcePack pack {flash, packAddress, packSize};
+
+    // Erased area
+    pack.Init();
+    CHECK(!pack.IsValid());
+
+    // Larger than its area
+    auto tooLarge = header;
+    tooLarge.size = packSize + 1;
+    std::copy(image.begin(), image.end(), spi.Memory().begin() + packAddress);
+    std::memcpy(spi.Memory().data() + packAddress, &tooLarge, sizeof(tooLarge));
+    pack.Init();
+    CHECK(!pack.IsValid());
+
+    // Index past the end of the pack
+    auto tooManyFiles = header;
+    tooManyFiles.count = 2;
+    std::memcpy(spi.Memory().data() + packAddress, &tooManyFiles, sizeof(tooManyFiles));
+    pack.Init();
+    CHECK(!pack.IsValid());
+
+    // File past the end of the pack
+    std::memcpy(spi.Memory().data() + packAddress, &header, sizeof(header));
+    ResourcePack::IndexEntry entry;
+    std::memcpy(&entry, image.data() + sizeof(header), sizeof(entry));
+    entry.size = 4;
+    std::memcpy(spi.Memory().data() + packAddress + sizeof(header), &entry, sizeof(entry));
+    pack.Init();
+    CHECK(pack.IsValid());
+    ResourcePack::Entry found;
+    CHECK(!pack.Find("/a.bin", found));
+  }
+}
+
+int main() {
+  TestSuperblock();
+  TestResourcePack();
+  TestInvalidResourcePack();
+  return Pinetime::Test::Result();
+}
@@ -0,0 +1,280 @@
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <FreeRTOS.h>
+#include <semphr.h>
+#include "drivers/PinMap.h"
+#include "drivers/PpiMap.h"
+#include "drivers/Spi.h"
+#include "drivers/SpiMaster.h"
+#include "drivers/SpiNorFlash.h"
+#include "Clock.h"
+#include "FlashChip.h"
+#include "Scheduler.h"
+#include "Spim.h"
+#include "Test.h"
+
+using namespace Pinetime::Drivers;
+using namespace Pinetime::Simulation;
+
+namespace {
+  // Records the bytes received during each selection of the device
+  class RecordingDevice : public SpiDevice {
+  public:
+    void Select() override {
+      transactions.emplace_back();
+      selected = true;
+    }
+
+    uint8_t Transfer(uint8_t byte) override {
+      transactions.back().push_back(byte);
+      return 0xFF;
+    }
+
+    void Deselect() override {
+      selected = false;
+    }
+
+    std::vector<std::vector<uint8_t>> transactions;
+    bool selected = false;
+  };
+
+  // Static, so that their addresses fit in the 32 bits of the EasyDMA pointers
+  uint8_t bandA[4800];
+  uint8_t bandB[4800];
+  uint8_t frame[240 * 120 * 2];
+  uint8_t flashData[8192];
+
+  void Fill(uint8_t* buffer, size_t size, uint8_t seed) {
+    for (size_t i = 0; i < size; i++) {
+      buffer[i] = static_cast<uint8_t>(seed + i * 7);
+    }
+  }
+
+  // The SPI bus of the watch with the display and the external flash, on the simulated SPIM
+  struct Bus {
+    Bus() {
+      spiMaster.Init();
+      spim.Attach(Pinetime::PinMap::SpiLcdCsn, lcd);
+      spim.Attach(Pinetime::PinMap::SpiFlashCsn, flash);
+    }
+
+    SpiMaster spiMaster {SpiMaster::SpiModule::SPI0,
+                         {SpiMaster::BitOrder::Msb_Lsb,
+                          SpiMaster::Modes::Mode3,
+                          SpiMaster::Frequencies::Freq8Mhz,
+                          Pinetime::PinMap::SpiSck,
+                          Pinetime::PinMap::SpiMosi,
+                          Pinetime::PinMap::SpiMiso}};
+    Spim spim {spiMaster};
+    RecordingDevice lcd;
+    Spi lcdSpi {spiMaster, Pinetime::PinMap::SpiLcdCsn, SpiMaster::Priority::Display};
+    FlashChip flash;
+    Spi flashSpi {spiMaster, Pinetime::PinMap::SpiFlashCsn, SpiMaster::Priority::Storage};
+    SpiNorFlash flashDriver {flashSpi};
+    Spi backgroundSpi {spiMaster, Pinetime::PinMap::SpiFlashCsn, SpiMaster::Priority::Background};
+  };
+
+  // Write() returns as soon as the transfer is started, the next Write() waits for the end of the previous one, and the
+  // post transaction hook is called from the interrupt once all the bytes have been sent
+  void TestAsynchronousWrites() {
+    Bus bus;
+    auto& lcd = bus.lcd;
+    auto& lcdSpi = bus.lcdSpi;
+
+    Fill(bandA, sizeof(bandA), 1);
+    Fill(bandB, sizeof(bandB), 2);
+    CHECK(reinterpret_cast<uintptr_t>(bandA) <= UINT32_MAX);
+
+    SemaphoreHandle_t flushed = xSemaphoreCreateBinary();
+    bool bandASent = false;
+    bool bandBSent = false;
+    uint64_t bandASentTime = 0;
+
+    Scheduler::CreateTask([&]() {
+      auto start = Clock::Now();
+      lcdSpi.Write(
+        bandA,
+        sizeof(bandA),
+        nullptr,
+        [&]() {
+          CHECK(!lcd.selected);
+          CHECK_EQUAL(sizeof(bandA), lcd.transactions.back().size());
+          bandASent = true;
+          bandASentTime = Clock::Now();
+        });
+      CHECK_EQUAL(start, Clock::Now());
+      CHECK(!bandASent);
+      CHECK(lcd.selected);
+
+      // Waits for the bus until the first band has been sent
+      lcdSpi.Write(bandB, sizeof(bandB), nullptr, [&]() {
+        bandBSent = true;
+        BaseType_t woken = pdFALSE;
+        xSemaphoreGiveFromISR(flushed, &woken);
+      });
+      CHECK(bandASent);
+      CHECK(!bandBSent);
+      CHECK(bandASentTime >= start + sizeof(bandA) / Spim::bytesPerMicrosecond);
+
+      xSemaphoreTake(flushed, portMAX_DELAY);
+      CHECK(bandBSent);
+    });
+    CHECK(Scheduler::Run());
+
+    CHECK_EQUAL(2u, lcd.transactions.size());
+    if (lcd.transactions.size() == 2) {
+      CHECK(lcd.transactions[0] == std::vector<uint8_t>(bandA, bandA + sizeof(bandA)));
+      CHECK(lcd.transactions[1] == std::vector<uint8_t>(bandB, bandB + sizeof(bandB)));
+    }
+    CHECK_EQUAL(sizeof(bandA) + sizeof(bandB), bus.spim.GetStatistics().bytes);
+    CHECK_EQUAL(sizeof(bandA) + sizeof(bandB), bus.spiMaster.GetStatistics().bytesTransferred);
+  }
+
+  // Buffers longer than the 255 bytes of EasyDMA are sent as an ArrayList chained by the PPI, with a single interrupt
+  // at the end of the list and one for the remainder that does not fill a whole chunk. The PPI channels of the backlight
+  // PWM are left untouched.
+  void TestListTransfers() {
+    Bus bus;
+    Fill(frame, sizeof(frame), 3);
+    for (auto channel : {Pinetime::PpiMap::BacklightOn, Pinetime::PpiMap::BacklightOff}) {
+      nrf_ppi_channel_endpoint_setup(channel, 0x40009140 + channel, 0x40009000 + channel);
+      nrf_ppi_channel_enable(channel);
+    }
+
+    // 240px wide bands of 1, 24 and 120 lines are sent in 240 byte chunks
+    const size_t sizes[] = {2, 3, 254, 255, 256, 509, 510, 511, 1000, 4097, 4800, 11520, 11521, sizeof(frame)};
+    for (auto size : sizes) {
+      bus.spim.ResetStatistics();
+      auto interrupts = bus.spiMaster.GetStatistics().interrupts;
+      SemaphoreHandle_t flushed = xSemaphoreCreateBinary();
+      Scheduler::CreateTask([&]() {
+        bus.lcdSpi.Write(frame, size, nullptr, [&]() {
+          xSemaphoreGiveFromISR(flushed, nullptr);
+        });
+        xSemaphoreTake(flushed, portMAX_DELAY);
+      });
+      CHECK(Scheduler::Run());
+
+      const auto& statistics = bus.spim.GetStatistics();
+      CHECK(bus.lcd.transactions.back() == std::vector<uint8_t>(frame, frame + size));
+      CHECK(statistics.maxTransferSize <= 255);
+      CHECK(statistics.interrupts <= 2);
+      if (size % 240 == 0) {
+        CHECK_EQUAL(1u, statistics.interrupts);
+        CHECK_EQUAL(size / 240, statistics.transfers);
+        CHECK_EQUAL(size / 240 - 1, statistics.chainedTransfers);
+      }
+      CHECK_EQUAL(statistics.interrupts, bus.spiMaster.GetStatistics().interrupts - interrupts);
+    }
+
+    for (auto channel : {Pinetime::PpiMap::BacklightOn, Pinetime::PpiMap::BacklightOff}) {
+      CHECK((NRF_PPI->CHEN & (1UL << channel)) != 0);
+      CHECK_EQUAL(0x40009140u + channel, NRF_PPI->CH[channel].EEP);
+      CHECK_EQUAL(0x40009000u + channel, NRF_PPI->CH[channel].TEP);
+      nrf_ppi_channel_disable(channel);
+    }
+  }
+
+  // Read() and WriteCmdAndBuffer() block the calling task until the end of the transfer, instead of busy waiting: the
+  // simulated time only advances when all the tasks are blocked, so another task runs while the flash is used
+  void TestBlockingTransfers() {
+    Bus bus;
+    auto& memory = bus.flash.Memory();
+    constexpr uint32_t readAddress = 0x10000;
+    constexpr uint32_t writeAddress = 0x20000;
+    Fill(memory.data() + readAddress, sizeof(flashData), 4);
+
+    bool flashDone = false;
+    uint32_t ticks = 0;
+    uint64_t readTime = 0;
+    Scheduler::CreateTask([&]() {
+      bus.flashDriver.Init();
+      CHECK(bus.flashDriver.FastReadSupported());
+
+      auto start = Clock::Now();
+      bus.flashDriver.Read(readAddress, flashData, sizeof(flashData));
+      readTime = Clock::Now() - start;
+      CHECK(std::equal(flashData, flashData + sizeof(flashData), memory.begin() + readAddress));
+
+      Fill(flashData, 1000, 5);
+      bus.flashDriver.SectorErase(writeAddress);
+      bus.flashDriver.Write(writeAddress, flashData, 1000);
+      CHECK(std::equal(flashData, flashData + 1000, memory.begin() + writeAddress));
+      flashDone = true;
+    });
+    Scheduler::CreateTask([&]() {
+      while (!flashDone) {
+        vTaskDelay(1);
+        ticks++;
+      }
+    });
+    CHECK(Scheduler::Run());
+
+    CHECK(readTime >= sizeof(flashData) / Spim::bytesPerMicrosecond);
+    // The sector erase alone takes 50ms
+    CHECK(ticks > FlashChip::sectorEraseTimeUs * configTICK_RATE_HZ / 1000000);
+    const auto& statistics = bus.flash.GetStatistics();
+    CHECK_EQUAL(0u, statistics.errors);
+    CHECK_EQUAL(1u, statistics.sectorErases);
+    CHECK_EQUAL(4u, statistics.pagePrograms);
+    CHECK(statistics.fastReads > 0);
+    CHECK_EQUAL(0u, bus.lcd.transactions.size());
+  }
+
+  // When the bus is released, it goes to the client of the highest priority class that is waiting for it, whatever the
+  // order in which they asked for it
+  void TestBusPriority() {
+    Bus bus;
+    std::vector<const char*> order;
+    static uint8_t backgroundData[2][1024];
+    static uint8_t storageData[1024];
+
+    auto read = [&](Spi& spi, uint8_t* data, size_t size, const char* name) {
+      uint8_t cmd[4] = {0x03, 0, 0, 0};
+      spi.Read(cmd, sizeof(cmd), data, size);
+      order.push_back(name);
+    };
+    // The first task holds the bus while the others ask for it, from the lowest to the highest priority
+    Scheduler::CreateTask([&]() {
+      read(bus.backgroundSpi, backgroundData[0], sizeof(backgroundData[0]), "holder");
+    });
+    Scheduler::CreateTask([&]() {
+      read(bus.backgroundSpi, backgroundData[1], sizeof(backgroundData[1]), "background");
+    });
+    Scheduler::CreateTask([&]() {
+      read(bus.flashSpi, storageData, sizeof(storageData), "storage");
+    });
+    Scheduler::CreateTask([&]() {
+      bus.lcdSpi.Write(bandA, sizeof(bandA), nullptr, nullptr);
+      order.push_back("display");
+    });
+    CHECK(Scheduler::Run());
+
+    CHECK_EQUAL(4u, order.size());
+    if (order.size() == 4) {
+      CHECK_EQUAL(std::string("holder"), order[0]);
+      CHECK_EQUAL(std::string("display"), order[1]);
+      CHECK_EQUAL(std::string("storage"), order[2]);
+      CHECK_EQUAL(std::string("background"), order[3]);
+    }
+
+    // The display only waited for the transfer of the holder, the background client waited for all the others
+    const auto& latency = bus.spiMaster.GetStatistics().latency;
+    auto display = static_cast<size_t>(SpiMaster::Priority::Display);
+    auto background = static_cast<size_t>(SpiMaster::Priority::Background);
+    CHECK_EQUAL(1u, latency[display].transactions);
+    CHECK_EQUAL(2u, latency[background].transactions);
+    CHECK(latency[display].maxTicks <= 2);
+    CHECK(latency[background].maxTicks >= (sizeof(bandA) + 2 * 1024) * configTICK_RATE_HZ / 1000000);
+  }
+}
+
+int main() {
+  TestAsynchronousWrites();
+  TestListTransfers();
+  TestBlockingTransfers();
+  TestBusPriority();
+  return Pinetime::Test::Result();
+}
@@ -0,0 +1,167 @@
+#include <algorithm>
+#include <cstring>
+#include "drivers/Spi.h"
+#include "drivers/SpiNorFlash.h"
+#include "Test.h"
+
+using Pinetime::Drivers::Spi;
+using Pinetime::Drivers::SpiNorFlash;
+
+namespace {
+  constexpr uint8_t sectorErase = 0x20;
+  constexpr uint8_t block32KErase = 0x52;
+  constexpr uint8_t block64KErase = 0xD8;
+
+  static_assert(SpiNorFlash::PlanErase(0x20000, 0x10000).command == block64KErase);
+  static_assert(SpiNorFlash::PlanErase(0x28000, 0x10000).command == block32KErase);
+  static_assert(SpiNorFlash::PlanErase(0x20000, 0xF000).command == block32KErase);
+
+  void TestFastReadProbe() {
+    Spi spi;
+    uint8_t data[16] = {0x12, 0x34, 0x56, 0x78};
+    std::memcpy(spi.Memory().data(), data, sizeof(data));
+    SpiNorFlash flash {spi};
+    flash.Init();
+    CHECK(flash.FastReadSupported());
+
+    spi.ResetStatistics();
+    uint8_t read[sizeof(data)];
+    flash.Read(0, read, sizeof(read));
+    CHECK(std::memcmp(data, read, sizeof(data)) == 0);
+    CHECK_EQUAL(1u, spi.GetStatistics().fastReads);
+
+    Spi spiWithoutSfdp;
+    spiWithoutSfdp.SetSfdpSupported(false);
+    SpiNorFlash flashWithoutSfdp {spiWithoutSfdp};
+    flashWithoutSfdp.Init();
+    CHECK(!flashWithoutSfdp.FastReadSupported());
+    flashWithoutSfdp.Read(0, read, sizeof(read));
+    CHECK_EQUAL(0u, spiWithoutSfdp.GetStatistics().fastReads);
+  }
+
+  void TestReadTransactions() {
+    Spi spi;
+    SpiNorFlash flash {spi};
+    flash.Init();
+    static constexpr size_t size = 16 * 1024;
+    static uint8_t buffer[size];
+
+    // Reads are split in 1KB transactions to leave the bus to the display, streamed reads in 4KB ones
+    spi.ResetStatistics();
+    flash.Read(0x200000, buffer, size);
+    CHECK_EQUAL(16u, spi.GetStatistics().reads);
+    CHECK_EQUAL(static_cast<uint64_t>(size), spi.GetStatistics().bytesRead);
+
+    spi.ResetStatistics();
+    flash.StreamRead(0x200000, buffer, size);
+    CHECK_EQUAL(4u, spi.GetStatistics().reads);
+    CHECK_EQUAL(static_cast<uint64_t>(size), spi.GetStatistics().bytesRead);
+  }
+
+  void TestPlanErase() {
+    struct Case {
+      uint32_t address;
+      size_t size;
+      uint8_t command;
+      uint32_t eraseSize;
+    };
+
+    static constexpr Case cases[] = {
+      {0x000000, 0x1000, sectorErase, 0x1000},
+      {0x000000, 0x7000, sectorErase, 0x1000},
+      {0x000000, 0x8000, block32KErase, 0x8000},
+      {0x000000, 0xF000, block32KErase, 0x8000},
+      {0x000000, 0x10000, block64KErase, 0x10000},
+      {0x000000, 0x400000, block64KErase, 0x10000},
+      {0x001000, 0x100000, sectorErase, 0x1000},
+      {0x008000, 0x100000, block32KErase, 0x8000},
+      {0x018000, 0x8000, block32KErase, 0x8000},
+      {0x018000, 0x7000, sectorErase, 0x1000},
+      {0x3F0000, 0x10000, block64KErase, 0x10000},
+    };
+    for (const auto& c : cases) {
+      auto step = SpiNorFlash::PlanErase(c.address, c.size);
+      CHECK_EQUAL(c.command, step.command);
+      CHECK_EQUAL(c.eraseSize, step.size);
+      // An erase never goes past the range, except for the single sector of the end of an unaligned range
+      CHECK(step.size <= c.size || step.size == 0x1000);
+    }
+  }
+
+  void TestEraseRange() {
+    Spi spi;
+    SpiNorFlash flash {spi};
+    flash.Init();
+    auto& memory = spi.Memory();
+    std::fill(memory.begin(), memory.end(), 0x00);
+
+    // 0x13000 - 0x50000: 5 sectors up to the 32K boundary, one 32K block up to the 64K boundary, then three 64K blocks
+    spi.ResetStatistics();
+    flash.EraseRange(0x13000, 0x3D000);
+    const auto& statistics = spi.GetStatistics();
+    CHECK_EQUAL(5u, statistics.sectorErases);
+    CHECK_EQUAL(1u, statistics.block32KErases);
+    CHECK_EQUAL(3u, statistics.block64KErases);
+    CHECK_EQUAL(0u, statistics.errors);
+    CHECK_EQUAL(0x00, memory[0x12FFF]);
+    CHECK_EQUAL(0xff, memory[0x13000]);
+    CHECK_EQUAL(0xff, memory[0x4FFFF]);
+    CHECK_EQUAL(0x00, memory[0x50000]);
+    CHECK(std::all_of(memory.begin() + 0x13000, memory.begin() + 0x50000, [](uint8_t b) {
+      return b == 0xff;
+    }));
+
+    // Unaligned ranges erase all the sectors they overlap
+    spi.ResetStatistics();
+    flash.EraseRange(0x60FFF, 2);
+    CHECK_EQUAL(2u, statistics.sectorErases);
+    CHECK_EQUAL(0x00, memory[0x5FFFF]);
+    CHECK_EQUAL(0xff, memory[0x60000]);
+    CHECK_EQUAL(0xff, memory[0x61FFF]);
+    CHECK_EQUAL(0x00, memory[0x62000]);
+
+    spi.ResetStatistics();
+    flash.SectorErase(0x70000);
+    CHECK_EQUAL(1u, statistics.sectorErases);
+    CHECK_EQUAL(0u, statistics.block32KErases + statistics.block64KErases);
+  }
+
+  void TestWriteAndRead() {
+    Spi spi;
+    SpiNorFlash flash {spi};
+    flash.Init();
+
+    // 600 bytes from the middle of a page are programmed in 3 page programs
+    uint8_t data[600];
+    for (size_t i = 0; i < sizeof(data); i++) {
+      data[i] = static_cast<uint8_t>(i * 13);
+    }
+    spi.ResetStatistics();
+    flash.Write(0x100080, data, sizeof(data));
+    CHECK_EQUAL(3u, spi.GetStatistics().pagePrograms);
+    CHECK_EQUAL(0u, spi.GetStatistics().errors);
+
+    uint8_t read[sizeof(data)];
+    flash.Read(0x100080, read, sizeof(read));
+    CHECK(std::memcmp(data, read, sizeof(data)) == 0);
+    std::memset(read, 0, sizeof(read));
+    flash.StreamRead(0x100080, read, sizeof(read));
+    CHECK(std::memcmp(data, read, sizeof(data)) == 0);
+
+    flash.EraseRange(0x100000, 0x1000);
+    flash.Read(0x100080, read, sizeof(read));
+    CHECK(std::all_of(read, read + sizeof(read), [](uint8_t b) {
+      return b == 0xff;
+    }));
+    CHECK_EQUAL(0u, spi.GetStatistics().errors);
+  }
+}
+
+int main() {
+  TestFastReadProbe();
+  TestReadTransactions();
+  TestPlanErase();
+  TestEraseRange();
+  TestWriteAndRead();
+  return Pinetime::Test::Result();
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdio>
+
+// Minimal checks for the host tests: each test program returns the number of failed checks
+namespace Pinetime {
+  namespace Test {
+    inline int failures = 0;
+
+    inline void Fail(const char* file, int line, const char* expression) {
+      std::printf("%s:%d: check failed: %s\n", file, line, expression);
+      failures++;
+    }
+
+    inline int Result() {
+      if (failures == 0) {
+        std::printf("All checks passed\n");
+      }
+      return failures;
+    }
+  }
+}
+
+#define CHECK(expression)                                                       \
+  do {                                                                          \
+    if (!(expression)) {                                                        \
+      Pinetime::Test::Fail(__FILE__, __LINE__, #expression);                    \
+    }                                                                           \
+  } while (0)
+
+#define CHECK_EQUAL(expected, actual)                                           \
+  do {                                                                          \
+    if (!((expected) == (actual))) {                                            \
+      Pinetime::Test::Fail(__FILE__, __LINE__, #expected " == " #actual);       \
+    }                                                                           \
+  } while (0)
@@ -0,0 +1,5 @@
+#include "Clock.h"
+
+using namespace Pinetime::Simulation;
+
+uint64_t Clock::now = 0;
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Pinetime {
+  namespace Simulation {
+    // Simulated time of the host tests. It advances when a task delays itself and with the bus time
+    // of the simulated SPI transactions, so that the flash benchmark reports the time the watch would spend.
+    class Clock {
+    public:
+      static uint64_t Now() {
+        return now;
+      }
+
+      static void Advance(uint64_t microseconds) {
+        now += microseconds;
+      }
+
+    private:
+      static uint64_t now;
+    };
+  }
+}
@@ -0,0 +1,216 @@
+#include "FlashChip.h"
+#include <algorithm>
+#include "Clock.h"
+
+using namespace Pinetime::Simulation;
+
+namespace {
+  constexpr uint32_t pageSize = 256;
+  constexpr uint8_t identification[] = {0x0B, 0x40, 0x16};
+  constexpr uint8_t sfdpSignature[] = {'S', 'F', 'D', 'P'};
+
+  // Opcode, address and dummy bytes of each command
+  size_t CommandSize(uint8_t opcode) {
+    switch (opcode) {
+      case 0x03: // Read
+      case 0x02: // Page Program
+      case 0x20: // Sector Erase
+      case 0x52: // Block Erase 32K
+      case 0xD8: // Block Erase 64K
+      case 0xAB: // Release from Deep Power Down
+        return 4;
+      case 0x0B: // Fast Read
+      case 0x5A: // Read SFDP
+        return 5;
+      default:
+        return 1;
+    }
+  }
+}
+
+FlashChip::FlashChip() : memory(memorySize, 0xff) {
+}
+
+void FlashChip::Select() {
+  statistics.transactions++;
+  if (eraseRunning && !suspended && !Busy()) {
+    eraseRunning = false;
+  }
+  phase = Phase::Command;
+  command.clear();
+  programData.clear();
+  outputIndex = 0;
+}
+
+uint8_t FlashChip::Transfer(uint8_t byte) {
+  switch (phase) {
+    case Phase::Command:
+      command.push_back(byte);
+      if (command.size() == CommandSize(command[0])) {
+        Start();
+      }
+      return 0xff;
+    case Phase::Read: {
+      if (readAddress >= memorySize) {
+        statistics.errors++;
+        phase = Phase::Ignore;
+        return 0xff;
+      }
+      statistics.bytesRead++;
+      return memory[readAddress++];
+    }
+    case Phase::Program:
+      programData.push_back(byte);
+      return 0xff;
+    case Phase::Output:
+      switch (command[0]) {
+        case 0x05: // Read Status Register, repeated until the chip is deselected
+          return (Busy() ? 0x01 : 0) | (writeEnabled ? 0x02 : 0);
+        case 0x9F: // Read Identification
+          return outputIndex < sizeof(identification) ? identification[outputIndex++] : 0;
+        case 0x5A: // Read SFDP
+          if (!sfdpSupported) {
+            return 0xff;
+          }
+          return outputIndex < sizeof(sfdpSignature) ? sfdpSignature[outputIndex++] : 0;
+        default:
+          return 0;
+      }
+    case Phase::Ignore:
+      return 0xff;
+  }
+  return 0xff;
+}
+
+void FlashChip::Deselect() {
+  if (phase == Phase::Command && !command.empty()) {
+    // The command was cut before its address
+    statistics.errors++;
+  } else if (phase == Phase::Program || (phase == Phase::Output && CommandSize(command[0]) == 1)) {
+    Execute();
+  }
+  phase = Phase::Command;
+}
+
+uint32_t FlashChip::Address() const {
+  return (static_cast<uint32_t>(command[1]) << 16U) | (static_cast<uint32_t>(command[2]) << 8U) | command[3];
+}
+
+bool FlashChip::Busy() const {
+  return !suspended && Clock::Now() < busyUntil;
+}
+
+// Called once the opcode and the address of the command have been received
+void FlashChip::Start() {
+  switch (command[0]) {
+    case 0x03: // Read
+    case 0x0B: // Fast Read
+      if (Busy() || Address() >= memorySize) {
+        statistics.errors++;
+        phase = Phase::Ignore;
+        return;
+      }
+      readAddress = Address();
+      statistics.reads++;
+      if (command[0] == 0x0B) {
+        statistics.fastReads++;
+      }
+      phase = Phase::Read;
+      return;
+    case 0x02: // Page Program
+    case 0x20: // Sector Erase
+    case 0x52: // Block Erase 32K
+    case 0xD8: // Block Erase 64K
+      // Executed when the chip is deselected
+      phase = Phase::Program;
+      return;
+    case 0x05:
+    case 0x9F:
+    case 0x5A:
+    case 0x15: // Read Configuration Register
+    case 0x2B: // Read Security Register
+    case 0xAB:
+    case 0x06: // Write Enable
+    case 0xB9: // Deep Power Down
+    case 0x75: // Erase Suspend
+    case 0x7A: // Erase Resume
+      phase = Phase::Output;
+      return;
+    default:
+      statistics.errors++;
+      phase = Phase::Ignore;
+      return;
+  }
+}
+
+void FlashChip::Erase(uint32_t size, uint32_t timeUs) {
+  if (!writeEnabled || Busy() || suspended || !programData.empty()) {
+    statistics.errors++;
+    return;
+  }
+  uint32_t address = Address() & ~(size - 1);
+  std::fill_n(memory.begin() + address, size, 0xff);
+  writeEnabled = false;
+  eraseRunning = true;
+  busyUntil = Clock::Now() + timeUs;
+  resumeTime = Clock::Now();
+}
+
+// Called when the chip is deselected at the end of a program, an erase or a single byte command
+void FlashChip::Execute() {
+  switch (command[0]) {
+    case 0x02: // Page Program
+    {
+      if (!writeEnabled || Busy() || suspended || programData.empty() || programData.size() > pageSize) {
+        statistics.errors++;
+        return;
+      }
+      // Programming wraps around the page, and can only clear bits
+      uint32_t address = Address();
+      uint32_t page = address & ~(pageSize - 1);
+      for (size_t i = 0; i < programData.size(); i++) {
+        memory[page + ((address + i) % pageSize)] &= programData[i];
+      }
+      writeEnabled = false;
+      busyUntil = Clock::Now() + pageProgramTimeUs;
+      statistics.pagePrograms++;
+      statistics.bytesProgrammed += programData.size();
+      return;
+    }
+    case 0x20:
+      Erase(0x1000, sectorEraseTimeUs);
+      statistics.sectorErases++;
+      return;
+    case 0x52:
+      Erase(0x8000, block32KEraseTimeUs);
+      statistics.block32KErases++;
+      return;
+    case 0xD8:
+      Erase(0x10000, block64KEraseTimeUs);
+      statistics.block64KErases++;
+      return;
+    case 0x75:
+      if (!eraseRunning || suspended) {
+        return;
+      }
+      if (Clock::Now() - resumeTime < resumeToSuspendTimeUs) {
+        statistics.errors++;
+      }
+      suspended = true;
+      remainingEraseTime = busyUntil - Clock::Now();
+      statistics.suspends++;
+      return;
+    case 0x7A:
+      if (suspended) {
+        suspended = false;
+        busyUntil = Clock::Now() + remainingEraseTime;
+        resumeTime = Clock::Now();
+      }
+      return;
+    case 0x06:
+      writeEnabled = true;
+      return;
+    default:
+      return;
+  }
+}
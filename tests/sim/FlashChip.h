@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "SpiDevice.h"
+
+namespace Pinetime {
+  namespace Simulation {
+    // The XT25F32B external flash of the PineTime, seen from the SPI bus: it decodes the bytes received while it is
+    // selected, like the chip does. The command starts once its opcode and address have been received, and programs
+    // and erases start when the chip select goes high. Programming can only clear bits and erases take their typical time.
+    class FlashChip : public SpiDevice {
+    public:
+      struct Statistics {
+        uint32_t transactions;
+        uint32_t reads;
+        uint32_t fastReads;
+        uint64_t bytesRead;
+        uint32_t pagePrograms;
+        uint64_t bytesProgrammed;
+        uint32_t sectorErases;
+        uint32_t block32KErases;
+        uint32_t block64KErases;
+        uint32_t suspends;
+        // Commands the flash would ignore or execute wrongly: a read or a program while an erase is running,
+        // a program or an erase without write enable, an erase suspended too soon after a resume...
+        uint32_t errors;
+      };
+
+      static constexpr size_t memorySize = 0x400000;
+      // Typical times of the XT25F32B datasheet
+      static constexpr uint32_t pageProgramTimeUs = 700;
+      static constexpr uint32_t sectorEraseTimeUs = 50000;
+      static constexpr uint32_t block32KEraseTimeUs = 150000;
+      static constexpr uint32_t block64KEraseTimeUs = 250000;
+      static constexpr uint32_t resumeToSuspendTimeUs = 100;
+
+      FlashChip();
+
+      void Select() override;
+      uint8_t Transfer(uint8_t byte) override;
+      void Deselect() override;
+
+      const Statistics& GetStatistics() const {
+        return statistics;
+      }
+
+      void ResetStatistics() {
+        statistics = {};
+      }
+
+      std::vector<uint8_t>& Memory() {
+        return memory;
+      }
+
+      // Fast Read is probed through SFDP, which can be disabled to simulate an older flash
+      void SetSfdpSupported(bool supported) {
+        sfdpSupported = supported;
+      }
+
+    private:
+      // What the chip does with the bytes that follow the command
+      enum class Phase : uint8_t { Command, Read, Program, Output, Ignore };
+
+      void Start();
+      void Execute();
+      bool Busy() const;
+      void Erase(uint32_t size, uint32_t timeUs);
+      uint32_t Address() const;
+
+      std::vector<uint8_t> memory;
+      Statistics statistics {};
+      bool sfdpSupported = true;
+
+      Phase phase = Phase::Command;
+      std::vector<uint8_t> command;
+      std::vector<uint8_t> programData;
+      uint32_t readAddress = 0;
+      size_t outputIndex = 0;
+
+      bool writeEnabled = false;
+      bool suspended = false;
+      bool eraseRunning = false;
+      uint64_t busyUntil = 0;
+      uint64_t remainingEraseTime = 0;
+      uint64_t resumeTime = 0;
+    };
+  }
+}
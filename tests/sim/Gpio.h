@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+
+namespace Pinetime {
+  namespace Simulation {
+    // Output pins of the simulated nRF52, written by nrf_gpio_pin_set() and nrf_gpio_pin_clear()
+    class Gpio {
+    public:
+      using Listener = std::function<void(uint32_t pin, bool level)>;
+
+      static bool Read(uint32_t pin);
+      static void Write(uint32_t pin, bool level);
+      // The listener is called on every change of an output, to model the chip select of the SPI devices
+      static void SetListener(Listener listener);
+    };
+  }
+}
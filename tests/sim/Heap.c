@@ -0,0 +1,11 @@
+// The heap of the firmware is the RAM between the __HeapLimit and __StackLimit symbols of the linker script (nrf_common.ld).
+// 40KB, about what is left to the heap on the watch. The symbols are macros when the heap is built under other names.
+#define HEAP_STRING(x) #x
+#define HEAP_SYMBOL(x) HEAP_STRING(x)
+
+__asm__(".bss\n"
+        ".balign 8\n"
+        ".globl " HEAP_SYMBOL(__HeapLimit) "\n" HEAP_SYMBOL(__HeapLimit) ":\n"
+        ".skip 40960\n"
+        ".globl " HEAP_SYMBOL(__StackLimit) "\n" HEAP_SYMBOL(__StackLimit) ":\n"
+        ".text\n");
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// The functions of sim/heap_4_infinitime.c, the heap the firmware used before heap_tlsf_infinitime.c, renamed by
+// tests/CMakeLists.txt. Its region is between __Heap4Limit and __Heap4End.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern uint8_t __Heap4Limit;
+extern uint8_t __Heap4End;
+
+void* pvHeap4Malloc(size_t xWantedSize);
+void vHeap4Free(void* pv);
+void* pvHeap4Realloc(void* pv, size_t xWantedSize);
+size_t xHeap4GetFreeHeapSize(void);
+size_t xHeap4GetMinimumEverFreeHeapSize(void);
+size_t xHeap4GetHeapSize(void);
+
+#ifdef __cplusplus
+}
+#endif
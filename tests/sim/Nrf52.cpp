@@ -0,0 +1,65 @@
+#include <nrf.h>
+#include <hal/nrf_gpio.h>
+#include "Gpio.h"
+#include "Scheduler.h"
+
+using Pinetime::Simulation::Gpio;
+using Pinetime::Simulation::Peripheral;
+using Pinetime::Simulation::PolledEvent;
+using Pinetime::Simulation::Scheduler;
+
+namespace {
+  NRF_SPIM_Type spim0;
+  NRF_SPIM_Type spim1;
+  NRF_TIMER_Type timer3;
+  NRF_PPI_Type ppi;
+  NRF_GPIO_Type p0 {0xFFFFFFFF, 0};
+  Gpio::Listener listener;
+}
+
+NRF_SPIM_Type* const NRF_SPIM0 = &spim0;
+NRF_SPIM_Type* const NRF_SPIM1 = &spim1;
+NRF_TIMER_Type* const NRF_TIMER3 = &timer3;
+NRF_PPI_Type* const NRF_PPI = &ppi;
+NRF_GPIO_Type* const NRF_P0 = &p0;
+
+PolledEvent::operator uint32_t() const {
+  if (value == 0 && Scheduler::InTask()) {
+    Scheduler::Wait(
+      [this] {
+        return value != 0;
+      },
+      Peripheral::idle);
+  }
+  return value;
+}
+
+bool Gpio::Read(uint32_t pin) {
+  return (NRF_P0->OUT & (1UL << pin)) != 0;
+}
+
+void Gpio::Write(uint32_t pin, bool level) {
+  if (Read(pin) == level) {
+    return;
+  }
+  NRF_P0->OUT = level ? (NRF_P0->OUT | (1UL << pin)) : (NRF_P0->OUT & ~(1UL << pin));
+  if (listener != nullptr) {
+    listener(pin, level);
+  }
+}
+
+void Gpio::SetListener(Listener newListener) {
+  listener = std::move(newListener);
+}
+
+void nrf_gpio_pin_set(uint32_t pin) {
+  Gpio::Write(pin, true);
+}
+
+void nrf_gpio_pin_clear(uint32_t pin) {
+  Gpio::Write(pin, false);
+}
+
+uint32_t nrf_gpio_pin_out_read(uint32_t pin) {
+  return Gpio::Read(pin) ? 1 : 0;
+}
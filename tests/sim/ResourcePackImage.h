@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+#include "components/fs/ResourcePack.h"
+
+namespace Pinetime {
+  namespace Simulation {
+    // Builds a resource pack like src/resources/generate-package.py does
+    inline std::vector<uint8_t> BuildResourcePack(const std::vector<std::pair<std::string, std::vector<uint8_t>>>& files) {
+      using Pinetime::Controllers::ResourcePack;
+      auto crc32 = [](const std::vector<uint8_t>& data) {
+        uint32_t crc = 0xffffffff;
+        for (uint8_t byte : data) {
+          crc ^= byte;
+          for (int bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ ((crc & 1) != 0 ? 0xedb88320 : 0);
+          }
+        }
+        return ~crc;
+      };
+
+      size_t indexSize = sizeof(ResourcePack::Header) + files.size() * sizeof(ResourcePack::IndexEntry);
+      std::vector<uint8_t> pack(indexSize);
+      for (size_t i = 0; i < files.size(); i++) {
+        ResourcePack::IndexEntry entry {};
+        std::strncpy(entry.path, files[i].first.c_str(), sizeof(entry.path));
+        entry.offset = pack.size();
+        entry.size = files[i].second.size();
+        entry.crc = crc32(files[i].second);
+        std::memcpy(pack.data() + sizeof(ResourcePack::Header) + i * sizeof(entry), &entry, sizeof(entry));
+        pack.insert(pack.end(), files[i].second.begin(), files[i].second.end());
+      }
+
+      ResourcePack::Header header {ResourcePack::magic, ResourcePack::version, static_cast<uint16_t>(files.size()), static_cast<uint32_t>(pack.size())};
+      std::memcpy(pack.data(), &header, sizeof(header));
+      return pack;
+    }
+  }
+}
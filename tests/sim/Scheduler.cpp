@@ -0,0 +1,212 @@
+#include "Scheduler.h"
+#include <algorithm>
+#include <cassert>
+#include <memory>
+#include <vector>
+#include <sys/mman.h>
+#include <ucontext.h>
+#include <FreeRTOS.h>
+#include <semphr.h>
+#include <task.h>
+#include "Clock.h"
+
+using namespace Pinetime::Simulation;
+
+namespace {
+  constexpr size_t stackSize = 256 * 1024;
+  constexpr uint64_t microsecondsPerSecond = 1000000;
+
+  struct Task {
+    std::function<void()> function;
+    ucontext_t context;
+    void* stack = nullptr;
+    bool done = false;
+    std::function<bool()> ready;
+    uint64_t wakeUpTime = Peripheral::idle;
+  };
+
+  std::vector<std::unique_ptr<Task>> tasks;
+  std::vector<Peripheral*> peripherals;
+  ucontext_t schedulerContext;
+  Task* currentTask = nullptr;
+
+  void* AllocateStack() {
+#if defined(MAP_32BIT)
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_32BIT;
+#else
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#endif
+    void* stack = mmap(nullptr, stackSize, PROT_READ | PROT_WRITE, flags, -1, 0);
+    assert(stack != MAP_FAILED);
+    assert(reinterpret_cast<uintptr_t>(stack) + stackSize <= 0x100000000ULL);
+    return stack;
+  }
+
+  void RunTask(int index) {
+    auto& task = *tasks[index];
+    task.function();
+    task.done = true;
+  }
+
+  bool Runnable(const Task& task) {
+    if (task.done) {
+      return false;
+    }
+    return (task.ready != nullptr && task.ready()) || Clock::Now() >= task.wakeUpTime;
+  }
+}
+
+void Scheduler::CreateTask(std::function<void()> function) {
+  auto task = std::make_unique<Task>();
+  task->function = std::move(function);
+  task->stack = AllocateStack();
+  getcontext(&task->context);
+  task->context.uc_stack.ss_sp = task->stack;
+  task->context.uc_stack.ss_size = stackSize;
+  task->context.uc_link = &schedulerContext;
+  task->ready = [] {
+    return true;
+  };
+  makecontext(&task->context, reinterpret_cast<void (*)()>(RunTask), 1, static_cast<int>(tasks.size()));
+  tasks.push_back(std::move(task));
+}
+
+void Scheduler::AddPeripheral(Peripheral& peripheral) {
+  peripherals.push_back(&peripheral);
+}
+
+void Scheduler::RemovePeripheral(Peripheral& peripheral) {
+  peripherals.erase(std::remove(peripherals.begin(), peripherals.end(), &peripheral), peripherals.end());
+}
+
+bool Scheduler::InTask() {
+  return currentTask != nullptr;
+}
+
+void Scheduler::Wait(const std::function<bool()>& ready, uint64_t wakeUpTime) {
+  assert(currentTask != nullptr);
+  currentTask->ready = ready;
+  currentTask->wakeUpTime = wakeUpTime;
+  swapcontext(&currentTask->context, &schedulerContext);
+}
+
+bool Scheduler::Run() {
+  bool deadlock = false;
+  size_t next = 0;
+  while (!deadlock && std::any_of(tasks.begin(), tasks.end(), [](const auto& task) {
+           return !task->done;
+         })) {
+    // Round robin between the runnable tasks
+    bool ran = false;
+    for (size_t i = 0; i < tasks.size() && !ran; i++) {
+      auto& task = *tasks[(next + i) % tasks.size()];
+      if (Runnable(task)) {
+        task.ready = nullptr;
+        task.wakeUpTime = Peripheral::idle;
+        currentTask = &task;
+        swapcontext(&schedulerContext, &task.context);
+        currentTask = nullptr;
+        next = (next + i + 1) % tasks.size();
+        ran = true;
+      }
+    }
+    if (ran) {
+      continue;
+    }
+
+    // All the tasks are blocked: run the peripherals until their next event or the end of a delay
+    uint64_t nextEvent = Peripheral::idle;
+    for (auto* peripheral : peripherals) {
+      nextEvent = std::min(nextEvent, peripheral->NextEvent());
+    }
+    for (const auto& task : tasks) {
+      if (!task->done) {
+        nextEvent = std::min(nextEvent, task->wakeUpTime);
+      }
+    }
+    if (nextEvent == Peripheral::idle) {
+      deadlock = true;
+      break;
+    }
+    if (nextEvent > Clock::Now()) {
+      Clock::Advance(nextEvent - Clock::Now());
+    }
+    for (auto* peripheral : peripherals) {
+      if (peripheral->NextEvent() <= Clock::Now()) {
+        peripheral->Process();
+      }
+    }
+  }
+
+  for (auto& task : tasks) {
+    munmap(task->stack, stackSize);
+  }
+  tasks.clear();
+  return !deadlock;
+}
+
+struct Semaphore {
+  uint32_t count;
+  uint32_t max;
+};
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void) {
+  return new Semaphore {1, 1};
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary(void) {
+  return new Semaphore {0, 1};
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t xSemaphore, TickType_t xBlockTime) {
+  if (xBlockTime > 0 && Scheduler::InTask()) {
+    uint64_t wakeUpTime = Peripheral::idle;
+    if (xBlockTime != portMAX_DELAY) {
+      wakeUpTime = Clock::Now() + (static_cast<uint64_t>(xBlockTime) * microsecondsPerSecond / configTICK_RATE_HZ);
+    }
+    // Another task woken by the same give may have taken the semaphore first
+    while (xSemaphore->count == 0 && Clock::Now() < wakeUpTime) {
+      Scheduler::Wait(
+        [xSemaphore] {
+          return xSemaphore->count > 0;
+        },
+        wakeUpTime);
+    }
+  }
+  if (xSemaphore->count == 0) {
+    return pdFALSE;
+  }
+  xSemaphore->count--;
+  return pdTRUE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t xSemaphore) {
+  if (xSemaphore->count == xSemaphore->max) {
+    return pdFALSE;
+  }
+  xSemaphore->count++;
+  return pdTRUE;
+}
+
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t xSemaphore, BaseType_t* pxHigherPriorityTaskWoken) {
+  BaseType_t result = xSemaphoreGive(xSemaphore);
+  if (result == pdTRUE && pxHigherPriorityTaskWoken != nullptr) {
+    *pxHigherPriorityTaskWoken = pdTRUE;
+  }
+  return result;
+}
+
+TickType_t xTaskGetTickCount(void) {
+  return static_cast<TickType_t>(Clock::Now() * configTICK_RATE_HZ / microsecondsPerSecond);
+}
+
+void vTaskDelay(TickType_t xTicksToDelay) {
+  // Wakes up on the next tick boundaries, like the scheduler would
+  TickType_t wakeUp = xTaskGetTickCount() + xTicksToDelay;
+  uint64_t wakeUpTime = (static_cast<uint64_t>(wakeUp) * microsecondsPerSecond + configTICK_RATE_HZ - 1) / configTICK_RATE_HZ;
+  if (Scheduler::InTask()) {
+    Scheduler::Wait(nullptr, wakeUpTime);
+  } else if (wakeUpTime > Clock::Now()) {
+    Clock::Advance(wakeUpTime - Clock::Now());
+  }
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <limits>
+
+namespace Pinetime {
+  namespace Simulation {
+    // A simulated peripheral: it is run by the scheduler when all the tasks are blocked, and can then raise
+    // interrupts, which run on the stack of the scheduler.
+    class Peripheral {
+    public:
+      static constexpr uint64_t idle = std::numeric_limits<uint64_t>::max();
+
+      virtual ~Peripheral() = default;
+      // Simulated time of the next event of the peripheral, or idle
+      virtual uint64_t NextEvent() = 0;
+      // Handles the events due at the current time
+      virtual void Process() = 0;
+    };
+
+    // Cooperative scheduler of the host tests. Each task runs until it blocks on a semaphore or a delay, the simulated
+    // time only advances when all the tasks are blocked, up to the next event of a peripheral or the end of a delay.
+    //
+    // EasyDMA addresses are 32 bits wide, and the drivers store buffer addresses in uint32_t. On 64 bit hosts, the
+    // stacks of the tasks are allocated in the first 4GB of the address space, and the test programs that use the DMA
+    // model are linked without PIE so that their static buffers are there too.
+    class Scheduler {
+    public:
+      static void CreateTask(std::function<void()> function);
+      static void AddPeripheral(Peripheral& peripheral);
+      static void RemovePeripheral(Peripheral& peripheral);
+      // Runs the tasks until they all return. Returns false if they are blocked forever.
+      static bool Run();
+      static bool InTask();
+      // Blocks the current task until ready() returns true or the simulated time reaches wakeUpTime
+      static void Wait(const std::function<bool()>& ready, uint64_t wakeUpTime);
+    };
+  }
+}
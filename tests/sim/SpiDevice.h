@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Pinetime {
+  namespace Simulation {
+    // A device on the simulated SPI bus. It is selected while its chip select pin is low.
+    class SpiDevice {
+    public:
+      virtual ~SpiDevice() = default;
+      virtual void Select() = 0;
+      // Returns the byte clocked out by the device while byte is clocked in
+      virtual uint8_t Transfer(uint8_t byte) = 0;
+      virtual void Deselect() = 0;
+    };
+  }
+}
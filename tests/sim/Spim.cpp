@@ -0,0 +1,228 @@
+#include "Spim.h"
+#include <algorithm>
+#include <cassert>
+#include "Clock.h"
+#include "Gpio.h"
+
+using namespace Pinetime::Simulation;
+
+namespace {
+  uint32_t Address(const volatile uint32_t& reg) {
+    return static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&reg));
+  }
+
+  template <typename T>
+  T* Pointer(uint32_t address) {
+    return reinterpret_cast<T*>(static_cast<uintptr_t>(address));
+  }
+}
+
+Spim::Spim(Pinetime::Drivers::SpiMaster& spiMaster) : spiMaster {spiMaster}, spim {*NRF_SPIM0}, timer {*NRF_TIMER3} {
+  Scheduler::AddPeripheral(*this);
+  Gpio::SetListener([this](uint32_t pin, bool level) {
+    for (size_t i = 0; i < maxDevices; i++) {
+      if (devices[i] != nullptr && pins[i] == pin) {
+        if (level) {
+          devices[i]->Deselect();
+        } else {
+          devices[i]->Select();
+        }
+      }
+    }
+  });
+}
+
+Spim::~Spim() {
+  Gpio::SetListener(nullptr);
+  Scheduler::RemovePeripheral(*this);
+}
+
+void Spim::Attach(uint32_t pinCsn, SpiDevice& device) {
+  for (size_t i = 0; i < maxDevices; i++) {
+    if (devices[i] == nullptr) {
+      pins[i] = pinCsn;
+      devices[i] = &device;
+      return;
+    }
+  }
+  assert(false);
+}
+
+SpiDevice* Spim::SelectedDevice() const {
+  for (size_t i = 0; i < maxDevices; i++) {
+    if (devices[i] != nullptr && !Gpio::Read(pins[i])) {
+      return devices[i];
+    }
+  }
+  return nullptr;
+}
+
+uint64_t Spim::NextEvent() {
+  if (spim.TASKS_START != 0 || spim.TASKS_STOP != 0 || timer.TASKS_START != 0 || timer.TASKS_STOP != 0 || timer.TASKS_CLEAR != 0) {
+    return Clock::Now();
+  }
+  return transferRunning ? transferEnd : idle;
+}
+
+void Spim::Process() {
+  bool progress = true;
+  while (progress) {
+    progress = false;
+    // The timer tasks are not applied when they are written: SpiMaster stops the timer at the end of a list and
+    // restarts it for the next one, so a pending STOP comes before a pending START
+    if (timer.TASKS_STOP != 0) {
+      timer.TASKS_STOP = 0;
+      timerRunning = false;
+    }
+    if (timer.TASKS_CLEAR != 0) {
+      timer.TASKS_CLEAR = 0;
+      timerCounter = 0;
+    }
+    if (timer.TASKS_START != 0) {
+      timer.TASKS_START = 0;
+      timerRunning = true;
+    }
+
+    if (transferRunning && Clock::Now() >= transferEnd) {
+      EndTransfer();
+      progress = true;
+    }
+    if (spim.TASKS_STOP != 0) {
+      spim.TASKS_STOP = 0;
+      if (transferRunning) {
+        stopPending = true;
+      } else {
+        Event(spim.EVENTS_STOPPED);
+      }
+      progress = true;
+    }
+    if (spim.TASKS_START != 0 && !transferRunning) {
+      spim.TASKS_START = 0;
+      StartTransfer();
+      progress = true;
+    }
+    // The handler can start the next transfer
+    if (Interrupt()) {
+      progress = true;
+    }
+  }
+}
+
+void Spim::StartTransfer() {
+  size_t size = std::max(spim.TXD.MAXCNT, spim.RXD.MAXCNT);
+  auto* tx = Pointer<const uint8_t>(spim.TXD.PTR);
+  auto* rx = Pointer<uint8_t>(spim.RXD.PTR);
+  SpiDevice* device = SelectedDevice();
+  for (size_t i = 0; i < size; i++) {
+    uint8_t out = i < spim.TXD.MAXCNT ? tx[i] : static_cast<uint8_t>(spim.ORC);
+    uint8_t in = device != nullptr ? device->Transfer(out) : 0xff;
+    if (i < spim.RXD.MAXCNT) {
+      rx[i] = in;
+    }
+  }
+  spim.TXD.AMOUNT = spim.TXD.MAXCNT;
+  spim.RXD.AMOUNT = spim.RXD.MAXCNT;
+
+  statistics.transfers++;
+  statistics.bytes += size;
+  statistics.maxTransferSize = std::max<uint32_t>(statistics.maxTransferSize, size);
+  if (chained) {
+    statistics.chainedTransfers++;
+  }
+  transferRunning = true;
+  transferEnd = Clock::Now() + (size + bytesPerMicrosecond - 1) / bytesPerMicrosecond;
+  Event(spim.EVENTS_STARTED);
+}
+
+void Spim::EndTransfer() {
+  transferRunning = false;
+  // In ArrayList mode, the pointers move to the next item of the list
+  if (spim.TXD.LIST == SPIM_TXD_LIST_LIST_ArrayList) {
+    spim.TXD.PTR = spim.TXD.PTR + spim.TXD.MAXCNT;
+  }
+  if (spim.RXD.LIST == SPIM_RXD_LIST_LIST_ArrayList) {
+    spim.RXD.PTR = spim.RXD.PTR + spim.RXD.MAXCNT;
+  }
+  Event(spim.EVENTS_ENDTX);
+  Event(spim.EVENTS_ENDRX);
+  chained = true;
+  Event(spim.EVENTS_END.value);
+  chained = false;
+  if (stopPending) {
+    stopPending = false;
+    Event(spim.EVENTS_STOPPED);
+  }
+}
+
+// Sets the event and runs the tasks of the enabled PPI channels it is connected to. All the channels of an event
+// trigger their task at the same time, so the channels enabled when the event is raised are collected first.
+void Spim::Event(volatile uint32_t& event) {
+  event = 1;
+  std::array<uint32_t, ppiChannels> tasks {};
+  size_t count = 0;
+  for (size_t channel = 0; channel < ppiChannels; channel++) {
+    if ((NRF_PPI->CHEN & (1UL << channel)) != 0 && NRF_PPI->CH[channel].EEP == Address(event)) {
+      tasks[count++] = NRF_PPI->CH[channel].TEP;
+    }
+  }
+  for (size_t i = 0; i < count; i++) {
+    Trigger(tasks[i]);
+  }
+}
+
+void Spim::Trigger(uint32_t taskAddress) {
+  if (taskAddress == Address(spim.TASKS_START)) {
+    spim.TASKS_START = 1;
+    if (chained) {
+      // Started by the END event of the previous transfer
+      spim.TASKS_START = 0;
+      StartTransfer();
+    }
+  } else if (taskAddress == Address(spim.TASKS_STOP)) {
+    spim.TASKS_STOP = 1;
+  } else if (taskAddress == Address(timer.TASKS_COUNT)) {
+    if (timerRunning) {
+      timerCounter = (timerCounter + 1) & 0xffff;
+      for (size_t i = 0; i < 6; i++) {
+        if (timer.CC[i] == timerCounter) {
+          Event(timer.EVENTS_COMPARE[i]);
+        }
+      }
+    }
+  } else {
+    for (size_t group = 0; group < 6; group++) {
+      if (taskAddress == Address(NRF_PPI->TASKS_CHG[group].EN)) {
+        NRF_PPI->CHEN = NRF_PPI->CHEN | NRF_PPI->CHG[group];
+      } else if (taskAddress == Address(NRF_PPI->TASKS_CHG[group].DIS)) {
+        NRF_PPI->CHEN = NRF_PPI->CHEN & ~NRF_PPI->CHG[group];
+      }
+    }
+  }
+}
+
+// SPIM0_SPIS0_TWIM0_TWIS0_SPI0_TWI0_IRQHandler() of main.cpp
+bool Spim::Interrupt() {
+  bool handled = false;
+  if (((spim.INTENSET & (1 << 6)) != 0) && spim.EVENTS_END == 1) {
+    spim.EVENTS_END = 0;
+    handled = true;
+    spiMaster.OnEndEvent();
+  }
+
+  if (((spim.INTENSET & (1 << 19)) != 0) && spim.EVENTS_STARTED == 1) {
+    spim.EVENTS_STARTED = 0;
+    handled = true;
+    spiMaster.OnStartedEvent();
+  }
+
+  if (((spim.INTENSET & (1 << 1)) != 0) && spim.EVENTS_STOPPED == 1) {
+    spim.EVENTS_STOPPED = 0;
+    handled = true;
+    spiMaster.OnStoppedEvent();
+  }
+
+  if (handled) {
+    statistics.interrupts++;
+  }
+  return handled;
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <nrf.h>
+#include "drivers/SpiMaster.h"
+#include "Scheduler.h"
+#include "SpiDevice.h"
+
+namespace Pinetime {
+  namespace Simulation {
+    // Model of the SPIM0 peripheral with EasyDMA and ArrayList, and of the PPI channels and the TIMER3 counter
+    // that SpiMaster uses to chain list transfers. The bytes go to the device whose chip select is low.
+    // Its interrupts run the handler of main.cpp, which calls spiMaster.
+    class Spim : public Peripheral {
+    public:
+      // 8MHz
+      static constexpr uint32_t bytesPerMicrosecond = 1;
+      // Time of the interrupt handler and of ContinueTransfer() at 64MHz, used to estimate the CPU load
+      static constexpr uint32_t interruptTimeUs = 3;
+
+      struct Statistics {
+        uint32_t transfers;
+        uint64_t bytes;
+        uint32_t interrupts;
+        uint32_t maxTransferSize;
+        // Transfers started by the PPI at the end of the previous one, without an interrupt
+        uint32_t chainedTransfers;
+      };
+
+      explicit Spim(Pinetime::Drivers::SpiMaster& spiMaster);
+      ~Spim() override;
+      Spim(const Spim&) = delete;
+      Spim& operator=(const Spim&) = delete;
+
+      void Attach(uint32_t pinCsn, SpiDevice& device);
+
+      uint64_t NextEvent() override;
+      void Process() override;
+
+      const Statistics& GetStatistics() const {
+        return statistics;
+      }
+
+      void ResetStatistics() {
+        statistics = {};
+      }
+
+    private:
+      static constexpr size_t maxDevices = 4;
+      static constexpr size_t ppiChannels = 20;
+
+      void Trigger(uint32_t taskAddress);
+      void Event(volatile uint32_t& event);
+      void StartTransfer();
+      void EndTransfer();
+      // Returns true if an event was handled
+      bool Interrupt();
+      SpiDevice* SelectedDevice() const;
+
+      Pinetime::Drivers::SpiMaster& spiMaster;
+      NRF_SPIM_Type& spim;
+      NRF_TIMER_Type& timer;
+      std::array<uint32_t, maxDevices> pins {};
+      std::array<SpiDevice*, maxDevices> devices {};
+
+      bool transferRunning = false;
+      bool stopPending = false;
+      bool chained = false;
+      uint64_t transferEnd = 0;
+      bool timerRunning = false;
+      uint32_t timerCounter = 0;
+      Statistics statistics {};
+    };
+  }
+}
@@ -0,0 +1,57 @@
+#include "drivers/Spi.h"
+#include "Clock.h"
+
+using namespace Pinetime::Drivers;
+using Pinetime::Simulation::Clock;
+
+Spi::Spi() = default;
+
+bool Spi::Init() {
+  return true;
+}
+
+bool Spi::Write(const uint8_t* data,
+                size_t size,
+                const std::function<void()>& preTransactionHook,
+                const std::function<void()>& postTransactionHook) {
+  if (preTransactionHook != nullptr) {
+    preTransactionHook();
+  }
+  bool result = Execute(data, size, nullptr, nullptr, 0);
+  if (postTransactionHook != nullptr) {
+    postTransactionHook();
+  }
+  return result;
+}
+
+bool Spi::Read(uint8_t* cmd, size_t cmdSize, uint8_t* data, size_t dataSize) {
+  return Execute(cmd, cmdSize, data, nullptr, dataSize);
+}
+
+bool Spi::WriteCmdAndBuffer(const uint8_t* cmd, size_t cmdSize, const uint8_t* data, size_t dataSize) {
+  return Execute(cmd, cmdSize, nullptr, data, dataSize);
+}
+
+void Spi::Sleep() {
+}
+
+void Spi::Wakeup() {
+}
+
+// Returns false if the flash did not accept the command
+bool Spi::Execute(const uint8_t* cmd, size_t cmdSize, uint8_t* data, const uint8_t* writeData, size_t dataSize) {
+  Clock::Advance(transactionTimeUs + (cmdSize + dataSize) * byteTimeUs);
+  auto errors = chip.GetStatistics().errors;
+  chip.Select();
+  for (size_t i = 0; i < cmdSize; i++) {
+    chip.Transfer(cmd[i]);
+  }
+  for (size_t i = 0; i < dataSize; i++) {
+    uint8_t in = chip.Transfer(writeData != nullptr ? writeData[i] : 0xff);
+    if (data != nullptr) {
+      data[i] = in;
+    }
+  }
+  chip.Deselect();
+  return chip.GetStatistics().errors == errors;
+}
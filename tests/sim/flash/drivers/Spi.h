@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "FlashChip.h"
+
+namespace Pinetime {
+  namespace Drivers {
+    // Host replacement of the SPI client of the external flash: the transactions of SpiNorFlash go directly to
+    // the simulated XT25F32B, without SpiMaster, and the bus time of each transaction advances the simulated clock.
+    class Spi {
+    public:
+      Spi();
+      Spi(const Spi&) = delete;
+      Spi& operator=(const Spi&) = delete;
+      Spi(Spi&&) = delete;
+      Spi& operator=(Spi&&) = delete;
+
+      bool Init();
+      bool Write(const uint8_t* data,
+                 size_t size,
+                 const std::function<void()>& preTransactionHook,
+                 const std::function<void()>& postTransactionHook);
+      bool Read(uint8_t* cmd, size_t cmdSize, uint8_t* data, size_t dataSize);
+      bool WriteCmdAndBuffer(const uint8_t* cmd, size_t cmdSize, const uint8_t* data, size_t dataSize);
+      void Sleep();
+      void Wakeup();
+
+      using Statistics = Pinetime::Simulation::FlashChip::Statistics;
+
+      const Statistics& GetStatistics() const {
+        return chip.GetStatistics();
+      }
+
+      void ResetStatistics() {
+        chip.ResetStatistics();
+      }
+
+      std::vector<uint8_t>& Memory() {
+        return chip.Memory();
+      }
+
+      void SetSfdpSupported(bool supported) {
+        chip.SetSfdpSupported(supported);
+      }
+
+      static constexpr size_t memorySize = Pinetime::Simulation::FlashChip::memorySize;
+      // 8MHz bus, plus the time to start a transaction
+      static constexpr uint32_t byteTimeUs = 1;
+      static constexpr uint32_t transactionTimeUs = 5;
+
+    private:
+      bool Execute(const uint8_t* cmd, size_t cmdSize, uint8_t* data, const uint8_t* writeData, size_t dataSize);
+
+      Pinetime::Simulation::FlashChip chip;
+    };
+  }
+}
@@ -37,6 +37,12 @@
 * See heap_1.c, heap_2.c and heap_3.c for alternative implementations, and the
 * memory management pages of http://www.FreeRTOS.org for more information.
 */
+
+/*
+* heap_4_infinitime.c as it was in the firmware before heap_tlsf_infinitime.c
+* replaced it, kept as the reference of the heap benchmark. Its symbols are
+* renamed by tests/CMakeLists.txt so that both heaps can be linked together.
+*/
 #include <stdlib.h>
 #include <string.h>
 
@@ -0,0 +1,83 @@
+#pragma once
+
+// Host replacement of the FreeRTOS declarations used by the units built in the host tests.
+// The heap declarations and HeapStatistics_t are the ones of src/FreeRTOS/portmacro_cmsis.h.
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define configSUPPORT_DYNAMIC_ALLOCATION 1
+#define configUSE_MALLOC_FAILED_HOOK 0
+#define configTICK_RATE_HZ 1024
+#define configASSERT(x) assert(x)
+#define ASSERT(x) assert(x)
+
+#define portBYTE_ALIGNMENT 8
+#define portBYTE_ALIGNMENT_MASK (0x0007)
+#define portMAX_DELAY ((TickType_t) 0xffffffffUL)
+#define pdFALSE ((BaseType_t) 0)
+#define pdTRUE ((BaseType_t) 1)
+#define pdMS_TO_TICKS(xTimeInMs) ((TickType_t) (((TickType_t) (xTimeInMs) * (TickType_t) configTICK_RATE_HZ) / (TickType_t) 1000U))
+
+#define mtCOVERAGE_TEST_MARKER()
+#define traceMALLOC(pvAddress, uiSize)
+#define traceFREE(pvAddress, uiSize)
+
+typedef uint32_t TickType_t;
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+
+// End of the heap, defined by the linker script on the watch and by sim/Heap.c on the host
+extern uint8_t __StackLimit;
+
+void* pvPortMalloc(size_t xWantedSize);
+void vPortFree(void* pv);
+void* pvPortRealloc(void* pv, size_t xWantedSize);
+void vPortInitialiseBlocks(void);
+size_t xPortGetFreeHeapSize(void);
+size_t xPortGetMinimumEverFreeHeapSize(void);
+size_t xPortGetHeapSize(void);
+size_t xPortGetLargestFreeBlockSize(void);
+
+#define portHEAP_SIZE_CLASS_COUNT 11
+
+typedef struct {
+  size_t xFreeBytes;
+  size_t xMinimumEverFreeBytes;
+  size_t xLargestFreeBlock;
+  size_t xNumberOfFreeBlocks;
+  size_t xNumberOfSuccessfulAllocations;
+  size_t xNumberOfSuccessfulFrees;
+  uint8_t ucFragmentation;
+  uint16_t usAllocatedBlocks[portHEAP_SIZE_CLASS_COUNT];
+  uint16_t usPeakAllocatedBlocks[portHEAP_SIZE_CLASS_COUNT];
+} HeapStatistics_t;
+
+void vPortGetHeapStatistics(HeapStatistics_t* pxHeapStatistics);
+
+// The tasks of the host tests are cooperative (see sim/Scheduler.h): a task only gives the CPU back when it blocks,
+// so the scheduler never needs to be suspended, and the interrupts of the simulated peripherals never preempt a task.
+static inline void vTaskSuspendAll(void) {
+}
+
+static inline BaseType_t xTaskResumeAll(void) {
+  return pdFALSE;
+}
+
+#define taskENTER_CRITICAL()
+#define taskEXIT_CRITICAL()
+#define taskENTER_CRITICAL_FROM_ISR() ((UBaseType_t) 0)
+#define taskEXIT_CRITICAL_FROM_ISR(x) ((void) (x))
+#define portYIELD_FROM_ISR(x)         ((void) (x))
+
+// Implemented in sim/Scheduler.cpp: ticks follow the simulated time, and a delay advances it
+TickType_t xTaskGetTickCount(void);
+void vTaskDelay(TickType_t xTicksToDelay);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "nrf.h"
+
+// The pins are modeled by sim/Gpio.cpp, so that the simulated SPI devices see their chip select
+typedef enum {
+  NRF_GPIO_PIN_NOPULL = 0,
+  NRF_GPIO_PIN_PULLDOWN = 1,
+  NRF_GPIO_PIN_PULLUP = 3,
+} nrf_gpio_pin_pull_t;
+
+void nrf_gpio_pin_set(uint32_t pin);
+void nrf_gpio_pin_clear(uint32_t pin);
+uint32_t nrf_gpio_pin_out_read(uint32_t pin);
+
+inline void nrf_gpio_cfg_output(uint32_t pin) {
+  NRF_P0->DIR = NRF_P0->DIR | (1UL << pin);
+}
+
+inline void nrf_gpio_cfg_input(uint32_t pin, nrf_gpio_pin_pull_t) {
+  NRF_P0->DIR = NRF_P0->DIR & ~(1UL << pin);
+}
+
+inline void nrf_gpio_cfg_default(uint32_t pin) {
+  NRF_P0->DIR = NRF_P0->DIR & ~(1UL << pin);
+}
@@ -0,0 +1,3 @@
+#pragma once
+
+// The units built in the host tests include LVGL without using it
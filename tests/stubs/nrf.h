@@ -0,0 +1,167 @@
+#pragma once
+
+// Host replacement of the nRF52832 registers used by the drivers built in the host tests. The peripherals
+// are modeled by sim/Spim.cpp, which reacts to the tasks and raises the events like the hardware does.
+#include <cstdint>
+
+namespace Pinetime {
+  namespace Simulation {
+    // INTENSET and INTENCLR set and clear the bits of the same interrupt mask
+    class InterruptMask {
+    public:
+      uint32_t enabled = 0;
+    };
+
+    class IntEnSet {
+    public:
+      explicit IntEnSet(InterruptMask& mask) : mask {mask} {
+      }
+
+      IntEnSet& operator=(uint32_t bits) {
+        mask.enabled |= bits;
+        return *this;
+      }
+
+      operator uint32_t() const {
+        return mask.enabled;
+      }
+
+    private:
+      InterruptMask& mask;
+    };
+
+    class IntEnClr {
+    public:
+      explicit IntEnClr(InterruptMask& mask) : mask {mask} {
+      }
+
+      IntEnClr& operator=(uint32_t bits) {
+        mask.enabled &= ~bits;
+        return *this;
+      }
+
+      operator uint32_t() const {
+        return mask.enabled;
+      }
+
+    private:
+      InterruptMask& mask;
+    };
+  }
+}
+
+namespace Pinetime {
+  namespace Simulation {
+    // EVENTS_END is polled by SpiMaster::Write() for single byte transfers. A task reading it while it is not set
+    // is blocked until the SPIM raises it, so that the simulated time can advance.
+    class PolledEvent {
+    public:
+      PolledEvent& operator=(uint32_t newValue) {
+        value = newValue;
+        return *this;
+      }
+
+      operator uint32_t() const;
+
+      volatile uint32_t value = 0;
+    };
+  }
+}
+
+struct NRF_SPIM_Type {
+  volatile uint32_t TASKS_START = 0;
+  volatile uint32_t TASKS_STOP = 0;
+  volatile uint32_t TASKS_SUSPEND = 0;
+  volatile uint32_t TASKS_RESUME = 0;
+  volatile uint32_t EVENTS_STOPPED = 0;
+  volatile uint32_t EVENTS_ENDRX = 0;
+  Pinetime::Simulation::PolledEvent EVENTS_END;
+  volatile uint32_t EVENTS_ENDTX = 0;
+  volatile uint32_t EVENTS_STARTED = 0;
+  Pinetime::Simulation::InterruptMask interrupts;
+  Pinetime::Simulation::IntEnSet INTENSET {interrupts};
+  Pinetime::Simulation::IntEnClr INTENCLR {interrupts};
+  volatile uint32_t ENABLE = 0;
+
+  struct {
+    volatile uint32_t SCK = 0xFFFFFFFF;
+    volatile uint32_t MOSI = 0xFFFFFFFF;
+    volatile uint32_t MISO = 0xFFFFFFFF;
+  } PSEL;
+
+  volatile uint32_t FREQUENCY = 0;
+
+  struct {
+    volatile uint32_t PTR = 0;
+    volatile uint32_t MAXCNT = 0;
+    volatile uint32_t AMOUNT = 0;
+    volatile uint32_t LIST = 0;
+  } RXD, TXD;
+
+  volatile uint32_t CONFIG = 0;
+  volatile uint32_t ORC = 0;
+};
+
+#define PSELSCK  PSEL.SCK
+#define PSELMOSI PSEL.MOSI
+#define PSELMISO PSEL.MISO
+
+struct NRF_TIMER_Type {
+  volatile uint32_t TASKS_START = 0;
+  volatile uint32_t TASKS_STOP = 0;
+  volatile uint32_t TASKS_COUNT = 0;
+  volatile uint32_t TASKS_CLEAR = 0;
+  volatile uint32_t EVENTS_COMPARE[6] = {};
+  Pinetime::Simulation::InterruptMask interrupts;
+  Pinetime::Simulation::IntEnSet INTENSET {interrupts};
+  Pinetime::Simulation::IntEnClr INTENCLR {interrupts};
+  volatile uint32_t MODE = 0;
+  volatile uint32_t BITMODE = 0;
+  volatile uint32_t CC[6] = {};
+};
+
+struct NRF_PPI_Type {
+  struct {
+    volatile uint32_t EN = 0;
+    volatile uint32_t DIS = 0;
+  } TASKS_CHG[6];
+
+  volatile uint32_t CHEN = 0;
+
+  struct {
+    volatile uint32_t EEP = 0;
+    volatile uint32_t TEP = 0;
+  } CH[20];
+
+  volatile uint32_t CHG[6] = {};
+};
+
+struct NRF_GPIO_Type {
+  volatile uint32_t OUT = 0;
+  volatile uint32_t DIR = 0;
+};
+
+extern NRF_SPIM_Type* const NRF_SPIM0;
+extern NRF_SPIM_Type* const NRF_SPIM1;
+extern NRF_TIMER_Type* const NRF_TIMER3;
+extern NRF_PPI_Type* const NRF_PPI;
+extern NRF_GPIO_Type* const NRF_P0;
+
+#define SPIM_ENABLE_ENABLE_Pos         (0UL)
+#define SPIM_ENABLE_ENABLE_Disabled    (0UL)
+#define SPIM_ENABLE_ENABLE_Enabled     (7UL)
+#define SPIM_TXD_LIST_LIST_Pos         (0UL)
+#define SPIM_TXD_LIST_LIST_Disabled    (0UL)
+#define SPIM_TXD_LIST_LIST_ArrayList   (1UL)
+#define SPIM_RXD_LIST_LIST_Pos         (0UL)
+#define SPIM_RXD_LIST_LIST_Disabled    (0UL)
+#define SPIM_RXD_LIST_LIST_ArrayList   (1UL)
+#define TIMER_MODE_MODE_Timer          (0UL)
+#define TIMER_MODE_MODE_Counter        (1UL)
+#define TIMER_BITMODE_BITMODE_16Bit    (0UL)
+#define TIMER_BITMODE_BITMODE_32Bit    (3UL)
+
+#define SPIM0_SPIS0_TWIM0_TWIS0_SPI0_TWI0_IRQn 3
+#define NRFX_IRQ_PRIORITY_SET(irq, priority)
+#define NRFX_IRQ_ENABLE(irq)
+#define APP_ERROR_CHECK(error) ((void) (error))
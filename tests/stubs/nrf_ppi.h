@@ -0,0 +1,45 @@
+#pragma once
+
+#include "nrf.h"
+
+typedef enum {
+  NRF_PPI_CHANNEL0 = 0,
+  NRF_PPI_CHANNEL1,
+  NRF_PPI_CHANNEL2,
+  NRF_PPI_CHANNEL3,
+  NRF_PPI_CHANNEL4,
+  NRF_PPI_CHANNEL5,
+  NRF_PPI_CHANNEL6,
+  NRF_PPI_CHANNEL7,
+  NRF_PPI_CHANNEL8,
+} nrf_ppi_channel_t;
+
+typedef enum {
+  NRF_PPI_CHANNEL_GROUP0 = 0,
+  NRF_PPI_CHANNEL_GROUP1,
+} nrf_ppi_channel_group_t;
+
+inline void nrf_ppi_channel_endpoint_setup(nrf_ppi_channel_t channel, uint32_t eep, uint32_t tep) {
+  NRF_PPI->CH[channel].EEP = eep;
+  NRF_PPI->CH[channel].TEP = tep;
+}
+
+inline void nrf_ppi_channel_enable(nrf_ppi_channel_t channel) {
+  NRF_PPI->CHEN = NRF_PPI->CHEN | (1UL << channel);
+}
+
+inline void nrf_ppi_channel_disable(nrf_ppi_channel_t channel) {
+  NRF_PPI->CHEN = NRF_PPI->CHEN & ~(1UL << channel);
+}
+
+inline void nrf_ppi_channel_include_in_group(nrf_ppi_channel_t channel, nrf_ppi_channel_group_t group) {
+  NRF_PPI->CHG[group] = NRF_PPI->CHG[group] | (1UL << channel);
+}
+
+inline void nrf_ppi_group_enable(nrf_ppi_channel_group_t group) {
+  NRF_PPI->CHEN = NRF_PPI->CHEN | NRF_PPI->CHG[group];
+}
+
+inline void nrf_ppi_group_disable(nrf_ppi_channel_group_t group) {
+  NRF_PPI->CHEN = NRF_PPI->CHEN & ~NRF_PPI->CHG[group];
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "nrf.h"
+#include "hal/nrf_gpio.h"
+
+// The GPIOTE is only used by the workaround of the single byte SPIM transfers, which is not modeled
+typedef uint32_t nrfx_gpiote_pin_t;
+typedef uint32_t nrfx_err_t;
+
+typedef enum {
+  NRF_GPIOTE_POLARITY_LOTOHI = 1,
+  NRF_GPIOTE_POLARITY_HITOLO,
+  NRF_GPIOTE_POLARITY_TOGGLE,
+} nrf_gpiote_polarity_t;
+
+typedef struct {
+  nrf_gpiote_polarity_t sense;
+  nrf_gpio_pin_pull_t pull;
+  bool is_watcher;
+  bool hi_accuracy;
+  bool skip_gpio_setup;
+} nrfx_gpiote_in_config_t;
+
+typedef void (*nrfx_gpiote_evt_handler_t)(nrfx_gpiote_pin_t pin, nrf_gpiote_polarity_t action);
+
+inline nrfx_err_t nrfx_gpiote_in_init(nrfx_gpiote_pin_t, const nrfx_gpiote_in_config_t*, nrfx_gpiote_evt_handler_t) {
+  return 0;
+}
+
+inline void nrfx_gpiote_in_uninit(nrfx_gpiote_pin_t) {
+}
+
+inline void nrfx_gpiote_in_event_enable(nrfx_gpiote_pin_t, bool) {
+}
+
+inline uint32_t nrfx_gpiote_in_event_addr_get(nrfx_gpiote_pin_t) {
+  return 0;
+}
@@ -0,0 +1,3 @@
+#pragma once
+
+#include "libraries/log/nrf_log.h"